@@ -25,15 +25,177 @@
 //
 //////////////////////////////////////////////////////////////////
 
+
+#include <algorithm>
+
 #include "types.hpp"
 
 namespace ydk {
 
-Bits::Bits() {}
+static const std::size_t word_bits = 64;
+
+static uint64 get_mask(std::size_t position) {
+  return static_cast<uint64>(1) << (position % word_bits);
+}
+
+Bits::Bits() : words{0, 0} {}
+
+Bits::Bits(const SchemaNameList& names) : names(names), words{0, 0} {
+  auto size = get_extra_words_size();
+  if (size > 0) {
+    extra_words.reset(new uint64[size]());
+  }
+}
+
+Bits::Bits(const Bits& other)
+    : names(other.names), words{other.words[0], other.words[1]} {
+  auto size = get_extra_words_size();
+  if (size > 0) {
+    extra_words.reset(new uint64[size]);
+    std::copy(other.extra_words.get(), other.extra_words.get() + size,
+              extra_words.get());
+  }
+  if (other.other_names) {
+    other_names.reset(new std::map<std::string, bool>(*other.other_names));
+  }
+}
+
+Bits::Bits(Bits&& other)
+    : names(other.names),
+      words{other.words[0], other.words[1]},
+      extra_words(std::move(other.extra_words)),
+      other_names(std::move(other.other_names)) {}
+
+Bits& Bits::operator=(const Bits& other) {
+  if (this != &other) {
+    *this = Bits(other);
+  }
+  return *this;
+}
+
+Bits& Bits::operator=(Bits&& other) {
+  names = other.names;
+  words[0] = other.words[0];
+  words[1] = other.words[1];
+  extra_words = std::move(other.extra_words);
+  other_names = std::move(other.other_names);
+  return *this;
+}
 
 Bits::~Bits() {}
 
-bool& Bits::operator[](std::string key) { return bitmap[key]; }
+std::size_t Bits::get_extra_words_size() const {
+  if (names.size() <= word_bits) {
+    return 0;
+  }
+  return 2 * ((names.size() - 1) / word_bits);
+}
+
+uint64* Bits::get_words(std::size_t position) {
+  if (position < word_bits) {
+    return words;
+  }
+  return extra_words.get() + 2 * (position / word_bits - 1);
+}
+
+const uint64* Bits::get_words(std::size_t position) const {
+  return const_cast<Bits*>(this)->get_words(position);
+}
+
+Bits::Reference Bits::operator[](const std::string& key) {
+  auto found = std::lower_bound(names.begin(), names.end(), key);
+  if (found != names.end() && *found == key) {
+    std::size_t position = found - names.begin();
+    get_words(position)[1] |= get_mask(position);
+    return Reference{*this, position, nullptr};
+  }
+  if (!other_names) {
+    other_names.reset(new std::map<std::string, bool>());
+  }
+  return Reference{*this, 0, &(*other_names)[key]};
+}
+
+std::map<std::string, bool> Bits::get_bitmap() const {
+  std::map<std::string, bool> bitmap;
+  if (other_names) {
+    bitmap = *other_names;
+  }
+  for (std::size_t position = 0; position < names.size(); position++) {
+    auto word = get_words(position);
+    auto mask = get_mask(position);
+    if (word[1] & mask) {
+      bitmap[names.get()[position]] = (word[0] & mask) != 0;
+    }
+  }
+  return bitmap;
+}
+
+std::string Bits::to_string() const {
+  std::string value;
+  auto append = [&value](const std::string& name) {
+    if (!value.empty()) {
+      value += ' ';
+    }
+    value += name;
+  };
+  // both are sorted by name, so merging them keeps the names in order
+  std::map<std::string, bool> none;
+  auto other = other_names ? other_names->begin() : none.begin();
+  auto other_end = other_names ? other_names->end() : none.end();
+  for (std::size_t position = 0; position < names.size(); position++) {
+    auto& name = names.get()[position];
+    for (; other != other_end && other->first < name; ++other) {
+      if (other->second) {
+        append(other->first);
+      }
+    }
+    if (get_words(position)[0] & get_mask(position)) {
+      append(name);
+    }
+  }
+  for (; other != other_end; ++other) {
+    if (other->second) {
+      append(other->first);
+    }
+  }
+  return value;
+}
+
+bool Bits::operator==(const Bits& other) const {
+  if (names == other.names && !other_names && !other.other_names) {
+    auto size = get_extra_words_size();
+    return words[0] == other.words[0] && words[1] == other.words[1] &&
+           std::equal(extra_words.get(), extra_words.get() + size,
+                      other.extra_words.get());
+  }
+  return get_bitmap() == other.get_bitmap();
+}
+
+bool Bits::operator!=(const Bits& other) const { return !(*this == other); }
+
+Bits::Reference& Bits::Reference::operator=(bool value) {
+  if (this->value) {
+    *this->value = value;
+    return *this;
+  }
+  auto word = bits.get_words(position);
+  if (value) {
+    word[0] |= get_mask(position);
+  } else {
+    word[0] &= ~get_mask(position);
+  }
+  return *this;
+}
+
+Bits::Reference& Bits::Reference::operator=(const Reference& other) {
+  return *this = static_cast<bool>(other);
+}
+
+Bits::Reference::operator bool() const {
+  if (value) {
+    return *value;
+  }
+  return (bits.get_words(position)[0] & get_mask(position)) != 0;
+}
 
-const std::map<std::string, bool>& Bits::get_bitmap() const { return bitmap; }
 }  // namespace ydk
@@ -103,38 +103,16 @@ string entity_vector_to_string(vector<Entity*>& entity_list) {
 static shared_ptr<Entity> find_child_entity(shared_ptr<Entity> parent_entity,
                                             Entity& filter_entity) {
   auto filter_absolute_path = absolute_path(filter_entity);
-  auto parent_absolute_path = absolute_path(*parent_entity);
-
-  if (filter_absolute_path == parent_absolute_path) {
-    YLOG_DEBUG(
-        "find_child_entity: Filter matches with parent entity, returning");
-    return parent_entity;
-  }
   YLOG_DEBUG(
       "find_child_entity: Searching for filter entity '{}' under parent entity "
       "'{}'",
-      filter_absolute_path, parent_absolute_path);
+      filter_absolute_path, absolute_path(*parent_entity));
 
-  // Traverse parent_entity tree for search of matching filter entity
-  auto const& children = parent_entity->get_children();
-  if (children.empty()) {
-    YLOG_DEBUG("Children map is empty");
-    return nullptr;
-  }
-  auto filter_segment_path = filter_entity.get_segment_path();
-  auto it = children.find(filter_segment_path);
-  if (it != children.end()) {
-    auto child_abs_path = absolute_path(*it->second);
-    YLOG_DEBUG("Got child with matching segment path; absolute path is '{}'",
-               child_abs_path);
-    if (child_abs_path == filter_absolute_path) return it->second;
-  }
-  YLOG_DEBUG("No matching child found");
-  for (auto it = children.begin(); it != children.end(); ++it) {
-    auto ch = find_child_entity(it->second, filter_entity);
-    if (ch != nullptr) return ch;
+  auto child = EntityPathIndex{parent_entity}.find(filter_absolute_path);
+  if (child == nullptr) {
+    YLOG_DEBUG("No matching child found");
   }
-  return nullptr;
+  return child;
 }
 
 shared_ptr<Entity> get_child_entity_from_top(shared_ptr<Entity> top_entity,
@@ -341,8 +319,7 @@ vector<shared_ptr<Entity>> execute_rpc(ydk::ServiceProvider& provider,
 }
 
 path::DataNode* create_root_datanode(path::RootSchemaNode* root_schema) {
-  path::RootSchemaNodeImpl& rs_impl =
-      dynamic_cast<path::RootSchemaNodeImpl&>(*root_schema);
+  path::RootSchemaNodeImpl& rs_impl = path::get_root_schema_impl(*root_schema);
   path::RootDataImpl* rd = new path::RootDataImpl{rs_impl, rs_impl.m_ctx, "/"};
   path::DataNodeImpl* rdn = dynamic_cast<path::DataNodeImpl*>(rd);
   return rdn;
@@ -25,6 +25,7 @@
 //
 //////////////////////////////////////////////////////////////////
 
+#include <atomic>
 #include <iomanip>
 #include <iostream>
 
@@ -47,10 +48,49 @@ Entity::Entity()
       has_list_ancestor(false),
       ignore_validation(false) {}
 
+Entity::Entity(const Entity &other)
+    : parent(other.parent),
+      yang_name(other.yang_name),
+      yang_parent_name(other.yang_parent_name),
+      yfilter(other.yfilter),
+      is_presence_container(other.is_presence_container),
+      is_top_level_class(other.is_top_level_class),
+      has_list_ancestor(other.has_list_ancestor),
+      ignore_validation(other.ignore_validation),
+      ylist_key_names(other.ylist_key_names),
+      ylist_key(other.ylist_key),
+      ylist(other.ylist) {}
+
+Entity::Entity(Entity &&other) : Entity(static_cast<const Entity &>(other)) {}
+
+Entity &Entity::operator=(const Entity &other) {
+  parent = other.parent;
+  yang_name = other.yang_name;
+  yang_parent_name = other.yang_parent_name;
+  yfilter = other.yfilter;
+  is_presence_container = other.is_presence_container;
+  is_top_level_class = other.is_top_level_class;
+  has_list_ancestor = other.has_list_ancestor;
+  ignore_validation = other.ignore_validation;
+  ylist_key_names = other.ylist_key_names;
+  ylist_key = other.ylist_key;
+  ylist = other.ylist;
+  // the leafs of the entity are still told to it, so it keeps caching
+  invalidate_cached_paths();
+  invalidate_cached_hashes();
+  return *this;
+}
+
+Entity &Entity::operator=(Entity &&other) {
+  return operator=(static_cast<const Entity &>(other));
+}
+
 Entity::~Entity() {}
 
 shared_ptr<Entity> Entity::clone_ptr() const { return nullptr; }
 
+shared_ptr<Entity> Entity::deep_clone() const { return nullptr; }
+
 void Entity::set_parent(Entity *p) { parent = p; }
 
 Entity *Entity::get_parent() const { return parent; }
@@ -76,69 +116,77 @@ std::string Entity::get_absolute_path() const { return ""; }
 const std::string Entity::get_namespace() const { return ""; }
 
 bool Entity::operator==(Entity &other) const {
-  if (!has_data() && !other.has_data()) return true;
-
-  if (!has_data() || !other.has_data()) return false;
-
-  YLOG_DEBUG("Comparing equality of '{}' and '{}'", get_segment_path(),
-             other.get_segment_path());
-
-  auto const this_children = get_children();
-  auto const other_children = other.get_children();
-
-  if (get_entity_path(*this, parent) == get_entity_path(other, other.parent)) {
-    if (this_children.size() == other_children.size()) {
-      for (map<std::string, shared_ptr<Entity>>::const_iterator
-               rit = this_children.begin(),
-               lit = other_children.begin();
-           rit != this_children.end() && lit != other_children.end();
-           ++rit, ++lit) {
-        if (*(rit->second) != *(lit->second)) {
-          YLOG_DEBUG("Children are not equal: '{}' and '{}'", rit->first,
-                     lit->first);
-          return false;
-        }
-      }
-    }
-  } else {
-    YLOG_DEBUG("Entity paths are not equal: '{}' and '{}'", yang_name,
-               other.yang_name);
-    return false;
-  }
-
-  return true;
+  return operator==(static_cast<const Entity &>(other));
 }
 
-bool Entity::operator!=(Entity &other) const {
-  if (has_data() && !other.has_data()) return true;
-
-  if (!has_data() && other.has_data()) return true;
-
-  YLOG_DEBUG("Comparing inequality of '{}' and '{}'", get_segment_path(),
-             other.get_segment_path());
+// Compares the data of two trees, leaving out the children without data
+static bool equal_data(const Entity &left, const Entity &right) {
+  auto left_has_data = left.has_data();
+  auto right_has_data = right.has_data();
+  if (!left_has_data || !right_has_data) {
+    return left_has_data == right_has_data;
+  }
+  if (left.get_cached_segment_path() != right.get_cached_segment_path()) {
+    return false;
+  }
 
-  auto const &this_children = get_children();
-  auto const &other_children = other.get_children();
+  auto const left_leafs = left.get_name_leaf_data();
+  auto const right_leafs = right.get_name_leaf_data();
+  if (left_leafs.size() != right_leafs.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < left_leafs.size(); i++) {
+    if (left_leafs[i].first != right_leafs[i].first ||
+        !(left_leafs[i].second == right_leafs[i].second) ||
+        left_leafs[i].second.name_space != right_leafs[i].second.name_space) {
+      return false;
+    }
+  }
 
-  if (get_entity_path(*this, parent) == get_entity_path(other, other.parent)) {
-    if (this_children.size() == other_children.size()) {
-      for (map<std::string, shared_ptr<Entity>>::const_iterator
-               rit = this_children.begin(),
-               lit = other_children.begin();
-           rit != this_children.end() && lit != other_children.end();
-           ++rit, ++lit) {
-        if (*(rit->second) != *(lit->second)) {
-          return true;
-        }
-      }
+  auto const left_children = left.get_children();
+  auto const right_children = right.get_children();
+  auto left_child = left_children.begin();
+  auto right_child = right_children.begin();
+  for (;;) {
+    while (left_child != left_children.end() &&
+           !(left_child->second && left_child->second->has_data())) {
+      ++left_child;
     }
-  } else {
-    YLOG_DEBUG("Entity paths are not equal: '{}' and '{}'", yang_name,
-               other.yang_name);
+    while (right_child != right_children.end() &&
+           !(right_child->second && right_child->second->has_data())) {
+      ++right_child;
+    }
+    if (left_child == left_children.end() ||
+        right_child == right_children.end()) {
+      return left_child == left_children.end() &&
+             right_child == right_children.end();
+    }
+    if (left_child->first != right_child->first ||
+        !equal_data(*left_child->second, *right_child->second)) {
+      YLOG_DEBUG("Children are not equal: '{}' and '{}'", left_child->first,
+                 right_child->first);
+      return false;
+    }
+    ++left_child;
+    ++right_child;
+  }
+}
+
+bool Entity::operator==(const Entity &other) const {
+  YLOG_DEBUG("Comparing equality of '{}' and '{}'", yang_name,
+             other.yang_name);
+  if (this == &other || get_tree_hash() == other.get_tree_hash()) {
     return true;
   }
+  // a hash may be kept after a change that was not noticed, so different
+  // hashes are only a reason to compare
+  return equal_data(*this, other);
+}
 
-  return false;
+bool Entity::operator!=(Entity &other) const { return !(*this == other); }
+
+bool Entity::operator!=(const Entity &other) const {
+  return !(*this == other);
 }
 
 std::string Entity::get_ylist_key() const {
@@ -157,6 +205,136 @@ std::string Entity::get_ylist_key() const {
   return key;
 }
 
+struct Entity::PathCache {
+  std::string segment_path;
+  std::string absolute_path;
+  // what the paths were built from
+  const Entity *parent;
+  std::shared_ptr<const PathCache> parent_cache;
+  uint64 version;
+};
+
+void Entity::invalidate_cached_paths() {
+  // the caches of the descendants were built from this one, and are rebuilt
+  // along with it
+  path_version.fetch_add(1, std::memory_order_acq_rel);
+}
+
+std::shared_ptr<const Entity::PathCache> Entity::get_path_cache() const {
+  if (!cache_paths) {
+    return nullptr;
+  }
+  auto path_parent = is_top_level_class ? nullptr : parent;
+  std::shared_ptr<const PathCache> parent_cache;
+  if (path_parent != nullptr) {
+    parent_cache = path_parent->get_path_cache();
+    if (!parent_cache) {
+      return nullptr;
+    }
+  }
+  // read before the path is built, so that a cache built while a key is set
+  // is not used afterwards
+  auto version = path_version.load(std::memory_order_acquire);
+  // the cache is replaced rather than updated, as readers may share it
+  auto cache = std::atomic_load(&path_cache);
+  if (cache && cache->version == version && cache->parent == path_parent &&
+      cache->parent_cache == parent_cache) {
+    return cache;
+  }
+  auto segment_path = get_segment_path();
+  auto absolute_path = parent_cache
+                           ? parent_cache->absolute_path + "/" + segment_path
+                           : segment_path;
+  cache = std::make_shared<const PathCache>(
+      PathCache{std::move(segment_path), std::move(absolute_path), path_parent,
+                std::move(parent_cache), version});
+  std::atomic_store(&path_cache, cache);
+  return cache;
+}
+
+struct Entity::HashCache {
+  uint64 hash;
+  uint64 version;
+};
+
+void Entity::invalidate_cached_hashes() {
+  // the hashes of the ancestors cover this entity
+  for (auto entity = this; entity != nullptr; entity = entity->parent) {
+    entity->hash_version.fetch_add(1, std::memory_order_acq_rel);
+  }
+}
+
+static uint64 combine_hash(uint64 seed, uint64 value) {
+  // the finalizer of splitmix64, so that the order of the values counts
+  value ^= seed + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+  value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+  return value ^ (value >> 31);
+}
+
+uint64 Entity::get_tree_hash() const {
+  // read before the hash is computed, so that a hash computed while the
+  // data changes is not used afterwards
+  auto version = hash_version.load(std::memory_order_acquire);
+  if (cache_paths) {
+    auto cache = std::atomic_load(&hash_cache);
+    if (cache && cache->version == version) {
+      return cache->hash;
+    }
+  }
+  uint64 hash = 0;
+  // as has_data(), for which an entity without data hashes to 0
+  bool has_data = is_presence_container;
+  for (auto const &name_leaf_data : get_name_leaf_data()) {
+    auto const &leaf_data = name_leaf_data.second;
+    hash = combine_hash(hash, name_hash(name_leaf_data.first));
+    hash = combine_hash(hash, name_hash(leaf_data.value));
+    hash = combine_hash(hash, name_hash(leaf_data.name_space));
+    hash = combine_hash(
+        hash, static_cast<uint64>(leaf_data.yfilter) << 1 | leaf_data.is_set);
+    has_data = has_data || leaf_data.is_set;
+  }
+  // in the order of their segment paths; children without data are left
+  // out, so that an empty container equals a missing one
+  for (auto const &child : get_children()) {
+    auto child_hash = child.second ? child.second->get_tree_hash() : 0;
+    if (child_hash != 0) {
+      hash = combine_hash(hash, child_hash);
+      has_data = true;
+    }
+  }
+  if (has_data) {
+    hash = combine_hash(name_hash(get_cached_segment_path()), hash);
+    if (hash == 0) {
+      hash = 1;
+    }
+  } else {
+    hash = 0;
+  }
+  if (cache_paths) {
+    std::atomic_store(&hash_cache, std::make_shared<const HashCache>(
+                                       HashCache{hash, version}));
+  }
+  return hash;
+}
+
+std::string Entity::get_cached_segment_path() const {
+  auto cache = get_path_cache();
+  return cache ? cache->segment_path : get_segment_path();
+}
+
+std::string Entity::get_cached_absolute_path() const {
+  auto cache = get_path_cache();
+  if (cache) {
+    return cache->absolute_path;
+  }
+  auto path = get_segment_path();
+  if (!is_top_level_class && parent) {
+    path = parent->get_cached_absolute_path() + "/" + path;
+  }
+  return path;
+}
+
 std::ostream &operator<<(std::ostream &stream, Entity &entity) {
   stream << get_entity_path(entity, entity.parent);
   auto const &children = entity.get_children();
@@ -180,36 +358,20 @@ EntityPath::EntityPath(
 EntityPath::~EntityPath() {}
 
 bool EntityPath::operator==(EntityPath &other) const {
-  ostringstream os1, os2;
-  os1 << *this;
-  os2 << other;
-  YLOG_DEBUG("Comparing equality '{}' and '{}'", os1.str(), os2.str());
-  return path == other.path && value_paths == other.value_paths;
+  return operator==(static_cast<const EntityPath &>(other));
 }
 
 bool EntityPath::operator==(const EntityPath &other) const {
-  ostringstream os1, os2;
-  os1 << *this;
-  os2 << other;
-  YLOG_DEBUG("Comparing const equality of '{}' and '{}'", os1.str(), os2.str());
+  YLOG_DEBUG("Comparing equality of '{}' and '{}'", path, other.path);
   return path == other.path && value_paths == other.value_paths;
 }
 
 bool EntityPath::operator!=(EntityPath &other) const {
-  ostringstream os1, os2;
-  os1 << *this;
-  os2 << other;
-  YLOG_DEBUG("Comparing inequality of '{}' and '{}'", os1.str(), os2.str());
-  return path != other.path || value_paths != other.value_paths;
+  return !(*this == other);
 }
 
 bool EntityPath::operator!=(const EntityPath &other) const {
-  ostringstream os1, os2;
-  os1 << *this;
-  os2 << other;
-  YLOG_DEBUG("Comparing const inequality of '{}' and '{}'", os1.str(),
-             os2.str());
-  return path != other.path || value_paths != other.value_paths;
+  return !(*this == other);
 }
 
 std::ostream &operator<<(std::ostream &stream, const EntityPath &path) {
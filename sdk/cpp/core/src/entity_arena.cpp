@@ -0,0 +1,78 @@
+//
+// @file value.hpp
+// @brief The main ydk public header.
+//
+// YANG Development Kit
+// Copyright 2016 Cisco Systems. All rights reserved
+//
+////////////////////////////////////////////////////////////////
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+//////////////////////////////////////////////////////////////////
+
+
+#include <algorithm>
+#include <cstdint>
+
+#include "types.hpp"
+
+namespace ydk {
+
+static thread_local EntityArena* current_arena = nullptr;
+
+EntityArena::EntityArena(std::size_t block_size)
+    : block_size(block_size), next(nullptr), end(nullptr), size(0) {}
+
+EntityArena::~EntityArena() {}
+
+void* EntityArena::allocate(std::size_t size, std::size_t alignment) {
+  auto offset = reinterpret_cast<std::uintptr_t>(next) % alignment;
+  auto padding = offset == 0 ? 0 : alignment - offset;
+  if (next == nullptr ||
+      static_cast<std::size_t>(end - next) < padding + size) {
+    // large allocations get a block of their own, so that the rest of the
+    // current block stays in use
+    auto length = std::max(block_size, size + alignment);
+    blocks.emplace_back(new char[length]);
+    this->size += length;
+    if (length > block_size) {
+      auto block = blocks.back().get();
+      offset = reinterpret_cast<std::uintptr_t>(block) % alignment;
+      return block + (offset == 0 ? 0 : alignment - offset);
+    }
+    next = blocks.back().get();
+    end = next + length;
+    offset = reinterpret_cast<std::uintptr_t>(next) % alignment;
+    padding = offset == 0 ? 0 : alignment - offset;
+  }
+  auto memory = next + padding;
+  next = memory + size;
+  return memory;
+}
+
+std::size_t EntityArena::get_size() const { return size; }
+
+EntityArena* EntityArena::get_current() { return current_arena; }
+
+EntityArena::Scope::Scope(EntityArena* arena) : previous(current_arena) {
+  current_arena = arena;
+}
+
+EntityArena::Scope::~Scope() { current_arena = previous; }
+
+}  // namespace ydk
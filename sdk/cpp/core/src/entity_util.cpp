@@ -60,10 +60,10 @@ std::string get_relative_entity_path(const Entity* current_node,
     } else {
       p = p1;
     }
-    path_buffer << p1->get_segment_path();
+    path_buffer << p1->get_cached_segment_path();
   }
   if (p) path_buffer << "/";
-  path_buffer << current_node->get_segment_path();
+  path_buffer << current_node->get_cached_segment_path();
   return path_buffer.str();
 }
 
@@ -103,7 +103,7 @@ const EntityPath get_entity_path(const Entity& entity, Entity* ancestor) {
     }
     auto a = entity.get_absolute_path();
     if (a.size() == 0) {
-      path_buffer << entity.get_segment_path();
+      path_buffer << entity.get_cached_segment_path();
     } else {
       path_buffer << a;
     }
@@ -120,11 +120,7 @@ const EntityPath get_entity_path(const Entity& entity, Entity* ancestor) {
 }
 
 std::string absolute_path(Entity& entity) {
-  string path = entity.get_segment_path();
-  if (!entity.is_top_level_class && entity.parent) {
-    path = absolute_path(*entity.parent) + "/" + path;
-  }
-  return path;
+  return entity.get_cached_absolute_path();
 }
 
 std::map<std::string, std::string> entity_to_dict(Entity& entity) {
@@ -216,32 +212,72 @@ std::map<std::string, std::pair<std::string, std::string>> entity_diff(
   return diffs;
 }
 
-Entity* path_to_entity(Entity& entity, string& abs_path) {
-  auto top_abs_path = absolute_path(entity);
-  if (top_abs_path == abs_path) return &entity;
-
-  if (!abs_path.compare(0, top_abs_path.length(), top_abs_path)) {
-    auto name_leaf_data_vector = entity.get_name_leaf_data();
-    for (auto name_leaf_data : name_leaf_data_vector) {
-      auto leaf_name = name_leaf_data.first;
-      std::ostringstream key_buffer;
-      key_buffer << "[" << leaf_name << "=";
-      if (abs_path.find(key_buffer.str()) == string::npos) {
-        std::string path = top_abs_path + "/" + leaf_name;
-        if (path == abs_path) return &entity;
-      }
-    }
+EntityPathIndex::EntityPathIndex(std::shared_ptr<Entity> top)
+    : top(top), top_path(absolute_path(*top)) {}
+
+// a shared_ptr that does not own the entity
+EntityPathIndex::EntityPathIndex(Entity& top)
+    : EntityPathIndex(shared_ptr<Entity>(shared_ptr<Entity>{}, &top)) {}
 
-    for (auto const& entry : entity.get_children()) {
-      auto& child = *entry.second;
-      auto child_abs_path = absolute_path(child);
-      if (abs_path == child_abs_path) return &child;
-      if (abs_path.compare(0, child_abs_path.length(), child_abs_path))
-        continue;
-      auto matching_entity = path_to_entity(child, abs_path);
-      if (matching_entity) return matching_entity;
+const EntityPathIndex::ChildMap& EntityPathIndex::get_children(
+    const Entity& entity) {
+  auto it = children.find(&entity);
+  if (it == children.end()) {
+    it = children.emplace(&entity, entity.get_children()).first;
+  }
+  return it->second;
+}
+
+// the end of the segment starting at begin; slashes in key values are skipped
+static size_t get_segment_end(const string& path, size_t begin) {
+  char quote = 0;
+  for (auto i = begin; i < path.size(); i++) {
+    auto c = path[i];
+    if (quote) {
+      if (c == quote) quote = 0;
+    } else if (c == '\'' || c == '"') {
+      quote = c;
+    } else if (c == '/') {
+      return i;
     }
   }
+  return path.size();
+}
+
+shared_ptr<Entity> EntityPathIndex::find(const string& path) {
+  if (path == top_path) return top;
+  size_t begin = 0;
+  if (path.size() > top_path.size() && path[top_path.size()] == '/' &&
+      !path.compare(0, top_path.size(), top_path)) {
+    begin = top_path.size() + 1;
+  }
+  auto entity = top;
+  while (entity && begin < path.size()) {
+    auto end = get_segment_end(path, begin);
+    auto const& entity_children = get_children(*entity);
+    auto child = entity_children.find(path.substr(begin, end - begin));
+    if (child == entity_children.end()) return nullptr;
+    entity = child->second;
+    begin = end + 1;
+  }
+  return entity;
+}
+
+Entity* path_to_entity(Entity& entity, string& abs_path) {
+  EntityPathIndex index{entity};
+  auto found = index.find(abs_path);
+  if (found) return found.get();
+
+  // a leaf of the entity at the parent path, other than a key
+  auto slash = abs_path.rfind('/');
+  if (slash == string::npos) return nullptr;
+  auto parent = index.find(abs_path.substr(0, slash));
+  if (!parent) return nullptr;
+  auto leaf_name = abs_path.substr(slash + 1);
+  if (abs_path.find("[" + leaf_name + "=") != string::npos) return nullptr;
+  for (auto const& name_leaf_data : parent->get_name_leaf_data()) {
+    if (name_leaf_data.first == leaf_name) return parent.get();
+  }
   return nullptr;
 }
 
@@ -23,7 +23,9 @@
 #ifndef ENTITY_UTIL_HPP
 #define ENTITY_UTIL_HPP
 
+#include <cstdint>
 #include <sstream>
+#include <unordered_map>
 
 #include "types.hpp"
 
@@ -41,11 +43,43 @@ std::string absolute_path(Entity& entity);
 
 Entity* path_to_entity(Entity& entity, std::string& abs_path);
 
+// Finds the entities of a tree by path, absolute or relative to the top
+// entity, one segment at a time. The children of every entity passed on the
+// way are indexed by segment path on first use, so once warm a lookup takes
+// O(depth). The index does not follow later changes to the tree.
+class EntityPathIndex {
+ public:
+  explicit EntityPathIndex(std::shared_ptr<Entity> top);
+  // the top entity is not owned by the index
+  explicit EntityPathIndex(Entity& top);
+
+  // the entity at the path, or nullptr
+  std::shared_ptr<Entity> find(const std::string& path);
+
+ private:
+  typedef std::map<std::string, std::shared_ptr<Entity>> ChildMap;
+  const ChildMap& get_children(const Entity& entity);
+
+  std::shared_ptr<Entity> top;
+  std::string top_path;
+  std::unordered_map<const Entity*, ChildMap> children;
+};
+
 std::map<std::string, std::string> entity_to_dict(Entity& entity);
 
 std::map<std::string, std::pair<std::string, std::string>> entity_diff(
     Entity& ent1, Entity& ent2);
 
+// FNV-1a hash of a leaf or child name. The generated set_value, set_filter
+// and get_child_by_name switch on the hashes that ydkgen computes the same way
+inline std::uint64_t name_hash(const std::string& name) {
+  std::uint64_t hash = 14695981039346656037ULL;
+  for (auto c : name) {
+    hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ULL;
+  }
+  return hash;
+}
+
 }  // namespace ydk
 
 #define ADD_KEY_TOKEN(attr, attr_name)                               \
@@ -0,0 +1,489 @@
+/// YANG Development Kit
+// Copyright 2016 Cisco Systems. All rights reserved
+//
+////////////////////////////////////////////////////////////////
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+//////////////////////////////////////////////////////////////////
+
+#include "fleet_executor.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include "crud_service.hpp"
+#include "errors.hpp"
+#include "executor_service.hpp"
+#include "logger.hpp"
+#include "netconf_provider.hpp"
+#include "types.hpp"
+
+using namespace std;
+
+namespace ydk {
+
+FleetDevice::FleetDevice(const string& name, const string& address,
+                         const string& username, const string& password,
+                         int port, const string& protocol, int timeout)
+    : name{name},
+      address{address},
+      username{username},
+      password{password},
+      port{port},
+      protocol{protocol},
+      timeout{timeout} {}
+
+//////////////////////////////////////////////////////////////////////////
+// class FleetSessionPool
+//////////////////////////////////////////////////////////////////////////
+struct PooledSession {
+  string device;
+  unique_ptr<ServiceProvider> provider;
+  bool in_use;
+  unsigned long last_used;
+};
+
+class FleetSessionPool {
+ public:
+  FleetSessionPool(const ServiceProviderFactory& factory,
+                   size_t max_sessions);
+
+  // Returns an idle session to the device, connecting a new one if needed.
+  // Blocks while every pooled session is busy.
+  shared_ptr<PooledSession> acquire(const FleetDevice& device);
+  void release(const shared_ptr<PooledSession>& session, bool discard);
+  size_t size();
+
+ private:
+  shared_ptr<PooledSession> evict_least_recently_used();
+
+  ServiceProviderFactory m_factory;
+  size_t m_max_sessions;
+  mutex m_mutex;
+  condition_variable m_released;
+  unordered_multimap<string, shared_ptr<PooledSession>> m_sessions;
+  size_t m_connecting;
+  unsigned long m_clock;
+};
+
+FleetSessionPool::FleetSessionPool(const ServiceProviderFactory& factory,
+                                   size_t max_sessions)
+    : m_factory{factory},
+      m_max_sessions{max_sessions == 0 ? 1 : max_sessions},
+      m_connecting{0},
+      m_clock{0} {}
+
+shared_ptr<PooledSession> FleetSessionPool::acquire(
+    const FleetDevice& device) {
+  unique_lock<mutex> lock{m_mutex};
+  while (true) {
+    auto range = m_sessions.equal_range(device.name);
+    for (auto s = range.first; s != range.second; ++s) {
+      if (!s->second->in_use) {
+        s->second->in_use = true;
+        return s->second;
+      }
+    }
+    if (m_sessions.size() + m_connecting < m_max_sessions) break;
+
+    auto victim = evict_least_recently_used();
+    if (victim) {
+      YLOG_DEBUG("Closing idle session to '{}'", victim->device);
+      // disconnect outside the lock
+      lock.unlock();
+      victim.reset();
+      lock.lock();
+    } else {
+      m_released.wait(lock);
+    }
+  }
+
+  m_connecting++;
+  lock.unlock();
+  unique_ptr<ServiceProvider> provider;
+  try {
+    YLOG_DEBUG("Connecting session to '{}'", device.name);
+    provider = m_factory(device);
+  } catch (...) {
+    lock.lock();
+    m_connecting--;
+    m_released.notify_all();
+    throw;
+  }
+
+  auto session = make_shared<PooledSession>();
+  session->device = device.name;
+  session->provider = move(provider);
+  session->in_use = true;
+  session->last_used = 0;
+
+  lock.lock();
+  m_connecting--;
+  m_sessions.emplace(device.name, session);
+  return session;
+}
+
+void FleetSessionPool::release(const shared_ptr<PooledSession>& session,
+                               bool discard) {
+  shared_ptr<PooledSession> discarded;
+  {
+    lock_guard<mutex> guard{m_mutex};
+    session->in_use = false;
+    session->last_used = ++m_clock;
+    if (discard) {
+      auto range = m_sessions.equal_range(session->device);
+      for (auto s = range.first; s != range.second; ++s) {
+        if (s->second == session) {
+          discarded = s->second;
+          m_sessions.erase(s);
+          break;
+        }
+      }
+    }
+    // waiters may be after this device or after any idle session to evict
+    m_released.notify_all();
+  }
+}
+
+size_t FleetSessionPool::size() {
+  lock_guard<mutex> guard{m_mutex};
+  return m_sessions.size();
+}
+
+shared_ptr<PooledSession> FleetSessionPool::evict_least_recently_used() {
+  auto victim = m_sessions.end();
+  for (auto s = m_sessions.begin(); s != m_sessions.end(); ++s) {
+    if (!s->second->in_use &&
+        (victim == m_sessions.end() ||
+         s->second->last_used < victim->second->last_used)) {
+      victim = s;
+    }
+  }
+  if (victim == m_sessions.end()) return nullptr;
+
+  auto session = victim->second;
+  m_sessions.erase(victim);
+  return session;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// class FleetWorkers
+//////////////////////////////////////////////////////////////////////////
+class FleetWorkers {
+ public:
+  explicit FleetWorkers(size_t num_threads);
+  ~FleetWorkers();
+
+  // Spreads the tasks over the worker queues and waits until all are done.
+  // The first exception thrown by a task is rethrown once they are.
+  void run(vector<function<void()>>& tasks);
+
+ private:
+  struct TaskQueue {
+    mutex queue_mutex;
+    deque<function<void()>> tasks;
+  };
+
+  bool pop(size_t index, function<void()>& task);
+  void work(size_t index);
+
+  vector<unique_ptr<TaskQueue>> m_queues;
+  vector<thread> m_threads;
+  mutex m_mutex;
+  condition_variable m_wake;
+  atomic<size_t> m_queued;
+  size_t m_next_queue;
+  bool m_stop;
+};
+
+FleetWorkers::FleetWorkers(size_t num_threads)
+    : m_queued{0}, m_next_queue{0}, m_stop{false} {
+  if (num_threads == 0) num_threads = 1;
+  for (size_t i = 0; i < num_threads; i++) {
+    m_queues.push_back(make_unique<TaskQueue>());
+  }
+  for (size_t i = 0; i < num_threads; i++) {
+    m_threads.emplace_back(&FleetWorkers::work, this, i);
+  }
+}
+
+FleetWorkers::~FleetWorkers() {
+  {
+    lock_guard<mutex> guard{m_mutex};
+    m_stop = true;
+  }
+  m_wake.notify_all();
+  for (auto& t : m_threads) t.join();
+}
+
+void FleetWorkers::run(vector<function<void()>>& tasks) {
+  mutex done_mutex;
+  condition_variable done;
+  size_t remaining = tasks.size();
+  exception_ptr error;
+
+  {
+    lock_guard<mutex> guard{m_mutex};
+    for (auto& task : tasks) {
+      auto& queue = *m_queues[m_next_queue++ % m_queues.size()];
+      lock_guard<mutex> queue_guard{queue.queue_mutex};
+      queue.tasks.emplace_back([&, task]() {
+        exception_ptr task_error;
+        try {
+          task();
+        } catch (...) {
+          task_error = current_exception();
+        }
+        lock_guard<mutex> done_guard{done_mutex};
+        if (task_error && !error) error = task_error;
+        if (--remaining == 0) done.notify_all();
+      });
+      m_queued++;
+    }
+  }
+  m_wake.notify_all();
+
+  unique_lock<mutex> lock{done_mutex};
+  done.wait(lock, [&]() { return remaining == 0; });
+  if (error) rethrow_exception(error);
+}
+
+bool FleetWorkers::pop(size_t index, function<void()>& task) {
+  // own queue from the back, other queues from the front
+  for (size_t i = 0; i < m_queues.size(); i++) {
+    auto& queue = *m_queues[(index + i) % m_queues.size()];
+    lock_guard<mutex> guard{queue.queue_mutex};
+    if (queue.tasks.empty()) continue;
+    if (i == 0) {
+      task = move(queue.tasks.back());
+      queue.tasks.pop_back();
+    } else {
+      task = move(queue.tasks.front());
+      queue.tasks.pop_front();
+    }
+    m_queued--;
+    return true;
+  }
+  return false;
+}
+
+void FleetWorkers::work(size_t index) {
+  function<void()> task;
+  while (true) {
+    if (pop(index, task)) {
+      task();
+      task = nullptr;
+      continue;
+    }
+    unique_lock<mutex> lock{m_mutex};
+    m_wake.wait(lock, [this]() { return m_stop || m_queued > 0; });
+    if (m_stop) return;
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// class FleetExecutor
+//////////////////////////////////////////////////////////////////////////
+FleetExecutor::FleetExecutor(path::Repository& repo, size_t num_threads,
+                             size_t max_sessions)
+    : FleetExecutor(
+          [&repo](const FleetDevice& device) -> unique_ptr<ServiceProvider> {
+            return make_unique<NetconfServiceProvider>(
+                repo, device.address, device.username, device.password,
+                device.port, device.protocol, true, device.timeout);
+          },
+          num_threads, max_sessions) {}
+
+FleetExecutor::FleetExecutor(const ServiceProviderFactory& factory,
+                             size_t num_threads, size_t max_sessions)
+    : m_pool{make_unique<FleetSessionPool>(factory, max_sessions)},
+      m_workers{make_unique<FleetWorkers>(num_threads)} {}
+
+FleetExecutor::~FleetExecutor() {
+  // stop the workers before the sessions they may be using
+  m_workers.reset();
+  m_pool.reset();
+}
+
+vector<FleetResult> FleetExecutor::execute(const vector<FleetDevice>& devices,
+                                           const FleetOperation& operation,
+                                           const FleetResultCallback& on_result) {
+  YLOG_INFO("Executing fleet operation on {} devices", devices.size());
+  vector<FleetResult> results(devices.size());
+  mutex callback_mutex;
+  vector<function<void()>> tasks;
+  tasks.reserve(devices.size());
+
+  for (size_t i = 0; i < devices.size(); i++) {
+    tasks.push_back([&, i]() {
+      auto& device = devices[i];
+      auto& result = results[i];
+      result.device = device.name;
+      result.succeeded = false;
+
+      shared_ptr<PooledSession> session;
+      bool discard = false;
+      try {
+        session = m_pool->acquire(device);
+        result.entity = operation(*session->provider);
+        result.succeeded = true;
+      } catch (YClientError& e) {
+        // the connection is suspect, do not hand it out again
+        discard = true;
+        result.error = e.what();
+      } catch (exception& e) {
+        result.error = e.what();
+      }
+      if (session) m_pool->release(session, discard);
+
+      if (!result.succeeded) {
+        YLOG_ERROR("Fleet operation failed on '{}': {}", device.name,
+                   result.error);
+      }
+      if (on_result) {
+        lock_guard<mutex> guard{callback_mutex};
+        on_result(result);
+      }
+    });
+  }
+
+  m_workers->run(tasks);
+  return results;
+}
+
+// Makes a copy of entity for each device, as the services write to the
+// entities they are given. The copies are made from a private one, one at a
+// time, so that the workers never touch the entity of the caller.
+static function<shared_ptr<Entity>()> copy_per_device(const Entity& entity) {
+  shared_ptr<Entity> original = entity.deep_clone();
+  if (!original) {
+    YLOG_ERROR("Entity '{}' cannot be copied", entity.yang_name);
+    throw(YInvalidArgumentError{"Entity '" + entity.yang_name.str() +
+                                "' cannot be copied for each device"});
+  }
+  auto parent = entity.parent;
+  auto copy_mutex = make_shared<mutex>();
+  return [original, parent, copy_mutex]() {
+    shared_ptr<Entity> copy;
+    {
+      lock_guard<mutex> guard{*copy_mutex};
+      copy = original->deep_clone();
+    }
+    // so that the copy has the absolute path of the entity
+    copy->parent = parent;
+    return copy;
+  };
+}
+
+static void check_succeeded(bool succeeded, const string& operation) {
+  if (!succeeded) {
+    throw(YServiceError{"Operation " + operation + " failed"});
+  }
+}
+
+vector<FleetResult> FleetExecutor::create(const vector<FleetDevice>& devices,
+                                          Entity& entity,
+                                          const FleetResultCallback& on_result) {
+  auto copy_entity = copy_per_device(entity);
+  return execute(devices,
+                 [copy_entity](ServiceProvider& provider)
+                     -> shared_ptr<Entity> {
+                   auto copy = copy_entity();
+                   CrudService crud{};
+                   check_succeeded(crud.create(provider, *copy), "create");
+                   return nullptr;
+                 },
+                 on_result);
+}
+
+vector<FleetResult> FleetExecutor::update(const vector<FleetDevice>& devices,
+                                          Entity& entity,
+                                          const FleetResultCallback& on_result) {
+  auto copy_entity = copy_per_device(entity);
+  return execute(devices,
+                 [copy_entity](ServiceProvider& provider)
+                     -> shared_ptr<Entity> {
+                   auto copy = copy_entity();
+                   CrudService crud{};
+                   check_succeeded(crud.update(provider, *copy), "update");
+                   return nullptr;
+                 },
+                 on_result);
+}
+
+vector<FleetResult> FleetExecutor::delete_(
+    const vector<FleetDevice>& devices, Entity& entity,
+    const FleetResultCallback& on_result) {
+  auto copy_entity = copy_per_device(entity);
+  return execute(devices,
+                 [copy_entity](ServiceProvider& provider)
+                     -> shared_ptr<Entity> {
+                   auto copy = copy_entity();
+                   CrudService crud{};
+                   check_succeeded(crud.delete_(provider, *copy), "delete");
+                   return nullptr;
+                 },
+                 on_result);
+}
+
+vector<FleetResult> FleetExecutor::read(const vector<FleetDevice>& devices,
+                                        Entity& filter,
+                                        const FleetResultCallback& on_result) {
+  auto copy_filter = copy_per_device(filter);
+  return execute(devices,
+                 [copy_filter](ServiceProvider& provider) {
+                   auto copy = copy_filter();
+                   CrudService crud{};
+                   return crud.read(provider, *copy);
+                 },
+                 on_result);
+}
+
+vector<FleetResult> FleetExecutor::read_config(
+    const vector<FleetDevice>& devices, Entity& filter,
+    const FleetResultCallback& on_result) {
+  auto copy_filter = copy_per_device(filter);
+  return execute(devices,
+                 [copy_filter](ServiceProvider& provider) {
+                   auto copy = copy_filter();
+                   CrudService crud{};
+                   return crud.read_config(provider, *copy);
+                 },
+                 on_result);
+}
+
+vector<FleetResult> FleetExecutor::execute_rpc(
+    const vector<FleetDevice>& devices, Entity& rpc_entity,
+    const FleetResultCallback& on_result) {
+  auto copy_rpc = copy_per_device(rpc_entity);
+  return execute(devices,
+                 [copy_rpc](ServiceProvider& provider) {
+                   auto copy = copy_rpc();
+                   ExecutorService executor{};
+                   return executor.execute_rpc(provider, *copy);
+                 },
+                 on_result);
+}
+
+size_t FleetExecutor::get_session_count() const { return m_pool->size(); }
+
+}  // namespace ydk
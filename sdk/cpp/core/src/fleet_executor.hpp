@@ -0,0 +1,145 @@
+//
+// @file fleet_executor.hpp
+// @brief Fan-out of CRUD and RPC operations across many devices.
+//
+// YANG Development Kit
+// Copyright 2016 Cisco Systems. All rights reserved
+//
+////////////////////////////////////////////////////////////////
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+//////////////////////////////////////////////////////////////////
+
+#ifndef FLEET_EXECUTOR_HPP
+#define FLEET_EXECUTOR_HPP
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "path_api.hpp"
+#include "service_provider.hpp"
+
+namespace ydk {
+
+///
+/// @brief Inventory entry of a device reachable over NETCONF.
+///
+/// The name identifies the device in results and keys its pooled session.
+///
+struct FleetDevice {
+  FleetDevice(const std::string& name, const std::string& address,
+              const std::string& username, const std::string& password,
+              int port = 830, const std::string& protocol = "ssh",
+              int timeout = -1);
+
+  std::string name;
+  std::string address;
+  std::string username;
+  std::string password;
+  int port;
+  std::string protocol;
+  int timeout;
+};
+
+///
+/// @brief Outcome of an operation on one device.
+///
+/// On success, entity holds the data returned by the operation, if any. On
+/// failure, error holds the message of the exception that was raised.
+///
+struct FleetResult {
+  std::string device;
+  bool succeeded;
+  std::shared_ptr<Entity> entity;
+  std::string error;
+};
+
+typedef std::function<std::shared_ptr<Entity>(ServiceProvider&)>
+    FleetOperation;
+typedef std::function<std::unique_ptr<ServiceProvider>(const FleetDevice&)>
+    ServiceProviderFactory;
+typedef std::function<void(const FleetResult&)> FleetResultCallback;
+
+class FleetSessionPool;
+class FleetWorkers;
+
+///
+/// @brief Runs the same operation against a fleet of devices.
+///
+/// Work is spread over a fixed number of worker threads, which steal pending
+/// devices from each other once their own share is done. Sessions are kept
+/// in a pool bounded by max_sessions and reused for later operations on the
+/// same device; when the pool is full, the least recently used idle session
+/// is closed to make room.
+///
+/// The CRUD and RPC operations give each device its own copy of the entity,
+/// filter or RPC, made with Entity::deep_clone(), so the one passed in is
+/// only read. It must not be modified until the operation returns. Entities
+/// that cannot be copied are rejected with YInvalidArgumentError.
+///
+class FleetExecutor {
+ public:
+  FleetExecutor(path::Repository& repo, std::size_t num_threads = 8,
+                std::size_t max_sessions = 64);
+  FleetExecutor(const ServiceProviderFactory& factory,
+                std::size_t num_threads = 8, std::size_t max_sessions = 64);
+  ~FleetExecutor();
+
+  ///
+  /// @brief Executes operation once per device.
+  ///
+  /// on_result, if given, is called from the worker threads as soon as each
+  /// device completes, one call at a time. The returned results follow the
+  /// order of devices. If on_result throws, the other devices still run and
+  /// the first exception it threw is rethrown once they are done.
+  ///
+  std::vector<FleetResult> execute(
+      const std::vector<FleetDevice>& devices, const FleetOperation& operation,
+      const FleetResultCallback& on_result = nullptr);
+
+  std::vector<FleetResult> create(
+      const std::vector<FleetDevice>& devices, Entity& entity,
+      const FleetResultCallback& on_result = nullptr);
+  std::vector<FleetResult> update(
+      const std::vector<FleetDevice>& devices, Entity& entity,
+      const FleetResultCallback& on_result = nullptr);
+  std::vector<FleetResult> delete_(
+      const std::vector<FleetDevice>& devices, Entity& entity,
+      const FleetResultCallback& on_result = nullptr);
+  std::vector<FleetResult> read(
+      const std::vector<FleetDevice>& devices, Entity& filter,
+      const FleetResultCallback& on_result = nullptr);
+  std::vector<FleetResult> read_config(
+      const std::vector<FleetDevice>& devices, Entity& filter,
+      const FleetResultCallback& on_result = nullptr);
+  std::vector<FleetResult> execute_rpc(
+      const std::vector<FleetDevice>& devices, Entity& rpc_entity,
+      const FleetResultCallback& on_result = nullptr);
+
+  std::size_t get_session_count() const;
+
+ private:
+  std::unique_ptr<FleetSessionPool> m_pool;
+  std::unique_ptr<FleetWorkers> m_workers;
+};
+
+}  // namespace ydk
+
+#endif /* FLEET_EXECUTOR_HPP */
@@ -52,6 +52,13 @@ NetconfServiceProvider::NetconfServiceProvider(const string& address,
     : session{address,  username,  password,     port,
               protocol, on_demand, common_cache, timeout} {}
 
+NetconfServiceProvider::NetconfServiceProvider(
+    const string& address, const string& username, const string& password,
+    int port, const string& protocol, bool on_demand,
+    path::ModelCachingOption caching_option, int timeout)
+    : session{address,  username,  password,       port,
+              protocol, on_demand, caching_option, timeout} {}
+
 NetconfServiceProvider::NetconfServiceProvider(path::Repository& repo,
                                                const string& address,
                                                const string& username,
@@ -77,6 +84,13 @@ NetconfServiceProvider::NetconfServiceProvider(const string& address,
     : session{address, username,  private_key_path, public_key_path,
               port,    on_demand, common_cache,     timeout} {}
 
+NetconfServiceProvider::NetconfServiceProvider(
+    const string& address, const string& username,
+    const string& private_key_path, const string& public_key_path, int port,
+    bool on_demand, path::ModelCachingOption caching_option, int timeout)
+    : session{address, username,  private_key_path, public_key_path,
+              port,    on_demand, caching_option,   timeout} {}
+
 NetconfServiceProvider::~NetconfServiceProvider() {}
 
 EncodingFormat NetconfServiceProvider::get_encoding() const {
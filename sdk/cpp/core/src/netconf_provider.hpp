@@ -39,6 +39,12 @@ class NetconfServiceProvider : public ServiceProvider {
                          const std::string& protocol = "ssh",
                          bool on_demand = true, bool common_cache = false,
                          int timeout = -1);
+  NetconfServiceProvider(const std::string& address,
+                         const std::string& username,
+                         const std::string& password, int port,
+                         const std::string& protocol, bool on_demand,
+                         path::ModelCachingOption caching_option,
+                         int timeout = -1);
 
   NetconfServiceProvider(path::Repository& repo, const std::string& address,
                          const std::string& username,
@@ -51,6 +57,13 @@ class NetconfServiceProvider : public ServiceProvider {
                          const std::string& public_key_path, int port = 830,
                          bool on_demand = true, bool common_cache = false,
                          int timeout = -1);
+  NetconfServiceProvider(const std::string& address,
+                         const std::string& username,
+                         const std::string& private_key_path,
+                         const std::string& public_key_path, int port,
+                         bool on_demand,
+                         path::ModelCachingOption caching_option,
+                         int timeout = -1);
   ~NetconfServiceProvider();
   EncodingFormat get_encoding() const;
   const path::Session& get_session() const;
@@ -105,13 +105,21 @@ NetconfSession::NetconfSession(path::Repository& repo, const string& address,
 NetconfSession::NetconfSession(const string& address, const string& username,
                                const string& password, int port,
                                const string& protocol, bool on_demand,
-                               bool common_cache, int timeout) {
+                               bool common_cache, int timeout)
+    : NetconfSession(address, username, password, port, protocol, on_demand,
+                     common_cache ? path::ModelCachingOption::COMMON
+                                  : path::ModelCachingOption::PER_DEVICE,
+                     timeout) {}
+
+NetconfSession::NetconfSession(const string& address, const string& username,
+                               const string& password, int port,
+                               const string& protocol, bool on_demand,
+                               path::ModelCachingOption caching_option,
+                               int timeout) {
   // Correct default settings
   if (port == 0) port = 830;
 
   initialize_client(address, username, password, port, protocol, timeout);
-  auto caching_option = common_cache ? path::ModelCachingOption::COMMON
-                                     : path::ModelCachingOption::PER_DEVICE;
   path::Repository repo(caching_option);
   initialize_repo(repo, on_demand);
   YLOG_INFO("Connected to {} on port {} using {} with timeout of {}", address,
@@ -139,14 +147,24 @@ NetconfSession::NetconfSession(path::Repository& repo, const string& address,
 NetconfSession::NetconfSession(const string& address, const string& username,
                                const string& private_key_path,
                                const string& public_key_path, int port,
-                               bool on_demand, bool common_cache, int timeout) {
+                               bool on_demand, bool common_cache, int timeout)
+    : NetconfSession(address, username, private_key_path, public_key_path, port,
+                     on_demand,
+                     common_cache ? path::ModelCachingOption::COMMON
+                                  : path::ModelCachingOption::PER_DEVICE,
+                     timeout) {}
+
+NetconfSession::NetconfSession(const string& address, const string& username,
+                               const string& private_key_path,
+                               const string& public_key_path, int port,
+                               bool on_demand,
+                               path::ModelCachingOption caching_option,
+                               int timeout) {
   // Correct default settings
   if (port == 0) port = 830;
 
   initialize_client_with_key(address, username, private_key_path,
                              public_key_path, port, timeout);
-  auto caching_option = common_cache ? path::ModelCachingOption::COMMON
-                                     : path::ModelCachingOption::PER_DEVICE;
   path::Repository repo(caching_option);
   initialize_repo(repo, on_demand);
   YLOG_INFO("Connected to {} on port {} using SSH with timeout of {}", address,
@@ -30,7 +30,7 @@ namespace path {
 static void check_ly_schema_node_for_path(lyd_node* node,
                                           const std::string& path) {
   if (node == nullptr || node->schema == nullptr ||
-      node->schema->priv == nullptr) {
+      get_schema_node_impl(node->schema) == nullptr) {
     YLOG_ERROR("Could not fetch schema node '{}'", path);
     throw(YCoreError{"Could not fetch schema node: " + path});
   }
@@ -54,8 +54,12 @@ ydk::path::DataNode& ydk::path::DataNode::create_datanode(
 //////////////////////////////////////////////////////////////////////////
 ydk::path::DataNodeImpl::DataNodeImpl(
     DataNode* parent, lyd_node* node,
-    const std::shared_ptr<RepositoryPtr>& repo)
-    : m_parent{parent}, m_node{node}, m_priv_repo{repo} {
+    const std::shared_ptr<RepositoryPtr>& repo, SchemaLock* schema_lock)
+    : m_parent{parent},
+      m_node{node},
+      m_schema_lock{parent ? dynamic_cast<DataNodeImpl*>(parent)->m_schema_lock
+                           : schema_lock},
+      m_priv_repo{repo} {
   // add the children
   if (m_node && m_node->child &&
       !(m_node->schema->nodetype == LYS_LEAF ||
@@ -78,7 +82,7 @@ ydk::path::DataNodeImpl::~DataNodeImpl() {
 
 const ydk::path::SchemaNode& ydk::path::DataNodeImpl::get_schema_node() const {
   check_ly_schema_node_for_path(m_node, get_path());
-  auto schema_ptr = reinterpret_cast<const SchemaNode*>(m_node->schema->priv);
+  const SchemaNode* schema_ptr = get_schema_node_impl(m_node->schema);
   return *schema_ptr;
 }
 
@@ -97,7 +101,7 @@ void ydk::path::DataNodeImpl::populate_new_schemas_from_path(
   if (path.empty()) return;
   YLOG_DEBUG("Populating schema for '{}'", path);
   check_ly_schema_node_for_path(m_node, path);
-  auto snode = reinterpret_cast<SchemaNodeImpl*>(m_node->schema->priv);
+  auto snode = get_schema_node_impl(m_node->schema);
   snode->populate_new_schemas_from_path(path);
 }
 
@@ -199,6 +203,8 @@ ydk::path::DataNode& ydk::path::DataNodeImpl::create_helper(
   lyd_node* first_node_created = nullptr;
   lyd_node* cn = dn->m_node;
 
+  SchemaReadGuard guard{*dn->m_schema_lock};
+
   for (size_t i = start_index; i < segments.size(); i++) {
     if (segments[i] == top_container_path) {
       YLOG_DEBUG("Skipping segment same as {}", top_container_path);
@@ -293,6 +299,7 @@ std::vector<std::shared_ptr<ydk::path::DataNode>> ydk::path::DataNodeImpl::find(
   }
 
   YLOG_DEBUG("Getting child schema with path '{}' in {}", path, get_path());
+  SchemaReadGuard guard{*m_schema_lock};
   const lys_node* found_snode = ly_ctx_get_node(
       m_node->schema->module->ctx, m_node->schema, path.c_str(), 0);
 
@@ -347,6 +354,7 @@ const ydk::path::DataNode& ydk::path::DataNodeImpl::get_root() const {
 std::string ydk::path::DataNodeImpl::xml() const {
   std::string ret;
   char* xml = nullptr;
+  SchemaReadGuard guard{*m_schema_lock};
   if (!lyd_print_mem(&xml, m_node, LYD_XML, LYP_FORMAT)) {
     ret = xml;
     std::free(xml);
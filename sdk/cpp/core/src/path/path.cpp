@@ -144,6 +144,7 @@ void ydk::path::ValidationService::validate(
   const ydk::path::DataNodeImpl& dn_impl =
       dynamic_cast<const ydk::path::DataNodeImpl&>(dn);
   struct lyd_node* lynode = dn_impl.m_node;
+  SchemaReadGuard guard{*dn_impl.m_schema_lock};
   int rc = lyd_validate(&lynode, ly_option, NULL);
   if (rc) {
     YLOG_ERROR("Data validation failed: {}. Path: {}", ly_errmsg(),
@@ -164,13 +165,6 @@ static LYD_FORMAT get_ly_format(ydk::EncodingFormat format) {
   return scheme;
 }
 
-static ydk::path::RootSchemaNodeImpl& get_root_schema_impl(
-    ydk::path::RootSchemaNode& root_schema) {
-  ydk::path::RootSchemaNodeImpl& rs_impl =
-      dynamic_cast<ydk::path::RootSchemaNodeImpl&>(root_schema);
-  return rs_impl;
-}
-
 static std::shared_ptr<ydk::path::DataNode> perform_decode(
     ydk::path::RootSchemaNodeImpl& rs_impl, struct lyd_node* lnode) {
   YLOG_DEBUG("Performing decode operation");
@@ -242,6 +236,7 @@ std::string ydk::path::Codec::encode(const ydk::path::DataNode& dn,
       throw(ydk::YInvalidArgumentError{"No data in data node"});
     }
     char* buffer = nullptr;
+    SchemaReadGuard guard{*impl.m_schema_lock};
     if (!lyd_print_mem(
             &buffer, m_node, scheme,
             (pretty ? LYP_FORMAT : 0) | LYP_WD_ALL | LYP_KEEPEMPTYCONT)) {
@@ -280,6 +275,7 @@ std::shared_ptr<ydk::path::DataNode> ydk::path::Codec::decode(
   RootSchemaNodeImpl& rs_impl = get_root_schema_impl(root_schema);
   rs_impl.populate_new_schemas_from_payload(buffer, format);
 
+  SchemaReadGuard guard{rs_impl.m_schema_lock};
   struct lyd_node* root =
       lyd_parse_mem(rs_impl.m_ctx, buffer.c_str(), get_ly_format(format),
                     LYD_OPT_TRUSTED | LYD_OPT_GET);
@@ -298,6 +294,7 @@ std::shared_ptr<ydk::path::DataNode> ydk::path::Codec::decode_rpc_output(
 
   RootSchemaNodeImpl& rs_impl = get_root_schema_impl(root_schema);
   rs_impl.populate_new_schemas_from_payload(buffer, format);
+  SchemaReadGuard guard{rs_impl.m_schema_lock};
   struct lyd_node* rpc = create_lyd_node_for_rpc(rs_impl, rpc_path);
 
   struct lyd_node* root =
@@ -327,8 +324,12 @@ std::shared_ptr<ydk::path::DataNode> ydk::path::Codec::decode_json_output(
     rs_impl.populate_new_schemas_from_payload(buffer,
                                               ydk::EncodingFormat::JSON);
 
-    struct lyd_node* dnode = lyd_parse_mem(
-        rs_impl.m_ctx, buffer.c_str(), LYD_JSON, LYD_OPT_TRUSTED | LYD_OPT_GET);
+    struct lyd_node* dnode = nullptr;
+    {
+      SchemaReadGuard guard{rs_impl.m_schema_lock};
+      dnode = lyd_parse_mem(rs_impl.m_ctx, buffer.c_str(), LYD_JSON,
+                            LYD_OPT_TRUSTED | LYD_OPT_GET);
+    }
     if (dnode == nullptr || ly_errno) {
       YLOG_ERROR("Parsing failed with message {}", ly_errmsg());
       throw(YCodecError{YCodecError::Error::XML_INVAL});
@@ -25,11 +25,15 @@
 #define YDK_PRIVATE_HPP
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <condition_variable>
 #include <cstdlib>
 #include <cstring>
 #include <functional>
+#include <future>
 #include <map>
+#include <mutex>
 #include <set>
 #include <unordered_set>
 
@@ -48,6 +52,53 @@ std::vector<std::string> segmentalize(const std::string& path);
 std::unordered_set<std::string> segmentalize_module_names(
     const std::string& value);
 
+class RootSchemaNodeImpl;
+
+// Reader/writer lock guarding the libyang context of a root schema. Readers
+// resolve schema nodes and build, parse or print data trees; writers load
+// new modules on demand and grow the SchemaNode tree. Waiting writers hold
+// off new readers, so shared locks must not be taken recursively.
+class SchemaLock {
+ public:
+  SchemaLock();
+
+  void lock();
+  void unlock();
+  void lock_shared();
+  void unlock_shared();
+
+ private:
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+  unsigned int m_readers;
+  unsigned int m_waiting_writers;
+  bool m_writer;
+};
+
+class SchemaReadGuard {
+ public:
+  explicit SchemaReadGuard(SchemaLock& lock);
+  ~SchemaReadGuard();
+
+  SchemaReadGuard(const SchemaReadGuard&) = delete;
+  SchemaReadGuard& operator=(const SchemaReadGuard&) = delete;
+
+ private:
+  SchemaLock& m_lock;
+};
+
+class SchemaNode;
+
+// The lock of the root schema the schema node belongs to
+SchemaLock& get_schema_lock(const SchemaNode& node);
+
+class SchemaNodeImpl;
+
+// Returns the SchemaNode wrapping the libyang schema node, creating the
+// wrappers between it and its closest wrapped ancestor on first access.
+// Returns nullptr for nodes outside the populated schema tree.
+SchemaNodeImpl* get_schema_node_impl(const struct lys_node* node);
+
 class RepositoryPtr : public std::enable_shared_from_this<RepositoryPtr> {
  public:
   explicit RepositoryPtr(ModelCachingOption caching_option);
@@ -66,7 +117,8 @@ class RepositoryPtr : public std::enable_shared_from_this<RepositoryPtr> {
   std::vector<const lys_module*> get_new_ly_modules_from_lookup(
       ly_ctx* ctx,
       const std::unordered_set<std::string>& namespace_module_names,
-      const std::unordered_map<std::string, path::Capability>& lookup_table);
+      const std::unordered_map<std::string, path::Capability>& lookup_table,
+      std::unordered_set<std::string>* resolved_names = nullptr);
   std::vector<const lys_module*> get_new_ly_modules_from_path(
       ly_ctx* ctx, const std::string& path,
       const std::unordered_map<std::string, path::Capability>& lookup_table);
@@ -93,11 +145,16 @@ class RepositoryPtr : public std::enable_shared_from_this<RepositoryPtr> {
                                 const std::vector<std::string>& features,
                                 bool& new_module);
 
+  std::shared_ptr<RootSchemaNodeImpl> create_root_schema_impl(
+      const std::unordered_map<std::string, path::Capability>& lookup_table,
+      const std::vector<path::Capability>& caps_to_load);
+
   void get_module_capabilities(ydk::path::Capability& capability);
   void collect_features_from_imported_modules(
       const lys_module* module,
       std::set<std::pair<lys_module*, std::string>>& features);
   std::vector<ModelProvider*> model_providers;
+  mutable std::mutex model_providers_mutex;
   bool using_temp_directory;
   ModelCachingOption caching_option;
 };
@@ -129,7 +186,17 @@ class SchemaNodeImpl : public SchemaNode {
 
   const SchemaNode* m_parent;
   struct lys_node* m_node;
-  std::vector<std::unique_ptr<SchemaNode>> m_children;
+
+ private:
+  void populate_children() const;
+  void add_child(struct lys_node* node) const;
+
+  // children are wrapped on first access
+  mutable std::vector<std::unique_ptr<SchemaNode>> m_children;
+  mutable std::unordered_multimap<std::string, SchemaNodeImpl*>
+      m_children_by_name;
+  mutable std::atomic<bool> m_children_populated;
+  mutable std::once_flag m_children_once;
 };
 
 class RootSchemaNodeImpl : public RootSchemaNode {
@@ -155,28 +222,108 @@ class RootSchemaNodeImpl : public RootSchemaNode {
   void populate_new_schemas_from_path(const std::string& path);
   void populate_new_schemas_from_payload(const std::string& payload,
                                          ydk::EncodingFormat format);
+  void populate_new_schemas(
+      const std::unordered_set<std::string>& namespace_module_names);
+
+  const std::shared_ptr<RepositoryPtr>& get_repository() const;
 
   struct ly_ctx* m_ctx;
   std::vector<std::unique_ptr<DataNode>> m_root_data_nodes;
   std::vector<std::unique_ptr<SchemaNode>> m_children;
+  SchemaLock m_schema_lock;
 
  private:
+  void add_child(struct lys_node* node);
   void populate_all_module_schemas();
   void populate_module_schema(const struct lys_module*);
   void populate_augmented_schema_nodes(const struct lys_module* module);
   void populate_augmented_schema_node(std::vector<lys_node*>& ancestors,
                                       struct lys_node* target);
   void populate_new_schemas(std::vector<const lys_module*>& new_modules);
+  bool has_unresolved_names(
+      const std::unordered_set<std::string>& namespace_module_names);
 
   const std::shared_ptr<RepositoryPtr> m_priv_repo;
   const std::unordered_map<std::string, path::Capability>
       m_name_namespace_lookup;
+  // module names and namespaces whose module is loaded in the context;
+  // guarded by m_schema_lock
+  std::unordered_set<std::string> m_resolved_names;
+  std::mutex m_root_data_nodes_mutex;
+  // top-level children indexed by node name, used to find augment targets
+  std::unordered_multimap<std::string, SchemaNodeImpl*> m_children_by_name;
+};
+
+std::string get_schema_fingerprint(
+    const std::string& search_path,
+    const std::unordered_map<std::string, Capability>& lookup_table,
+    const std::vector<Capability>& caps_to_load);
+
+// A shared root schema as used by one session. It keeps the schema alive,
+// lends it the session's model providers for on-demand loading and owns the
+// data trees the session creates, so that they go away with the session.
+class SharedRootSchemaNode : public RootSchemaNode {
+ public:
+  SharedRootSchemaNode(const std::shared_ptr<RootSchemaNodeImpl>& schema,
+                       const std::vector<ModelProvider*>& model_providers);
+  ~SharedRootSchemaNode();
+
+  std::vector<SchemaNode*> find(const std::string& path);
+
+  const std::vector<std::unique_ptr<SchemaNode>>& get_children() const;
+
+  // the shared schema, which the schema nodes found through it belong to
+  const SchemaNode& get_root() const noexcept;
+
+  DataNode& create_datanode(const std::string& path);
+
+  DataNode& create_datanode(const std::string& path, const std::string& value);
+
+  std::shared_ptr<Rpc> create_rpc(const std::string& path);
+
+ private:
+  std::shared_ptr<RootSchemaNodeImpl> m_schema;
+  std::vector<ModelProvider*> m_model_providers;
+  // destroyed before m_schema releases the libyang context
+  std::vector<std::unique_ptr<DataNode>> m_root_data_nodes;
+  std::mutex m_root_data_nodes_mutex;
+};
+
+// The RootSchemaNodeImpl behind a root schema, shared or not
+RootSchemaNodeImpl& get_root_schema_impl(RootSchemaNode& root_schema);
+
+// Process wide registry of compiled root schemas, keyed by capability
+// fingerprint. Entries expire when the last session using them goes away.
+// Schemas are compiled outside the registry lock; sessions asking for a
+// schema that is being compiled wait for it.
+class SchemaRegistry {
+ public:
+  static SchemaRegistry& get_instance();
+
+  std::shared_ptr<RootSchemaNode> get_root_schema(
+      const std::string& fingerprint,
+      const std::vector<ModelProvider*>& model_providers,
+      const std::function<std::shared_ptr<RootSchemaNodeImpl>()>& create);
+
+  std::size_t size();
+
+ private:
+  SchemaRegistry() = default;
+  void purge_expired();
+
+  typedef std::shared_future<std::weak_ptr<RootSchemaNodeImpl>> SchemaFuture;
+
+  std::mutex m_mutex;
+  std::unordered_map<std::string, SchemaFuture> m_schemas;
 };
 
 class DataNodeImpl : public DataNode {
  public:
+  // data nodes without a parent are given the lock of their root schema;
+  // the others share the lock of their parent
   DataNodeImpl(DataNode* parent, struct lyd_node* node,
-               const std::shared_ptr<RepositoryPtr>& repo);
+               const std::shared_ptr<RepositoryPtr>& repo,
+               SchemaLock* schema_lock = nullptr);
 
   // no copy constructor
   DataNodeImpl(const DataNodeImpl& dn) = delete;
@@ -242,6 +389,7 @@ class DataNodeImpl : public DataNode {
   struct lyd_node* m_node;
   std::map<struct lyd_node*, std::shared_ptr<DataNode>> child_map;
   YFilter yfilter;
+  SchemaLock* m_schema_lock;
 
  private:
   const std::shared_ptr<RepositoryPtr> m_priv_repo;
@@ -242,7 +242,7 @@ ly_ctx* ydk::path::RepositoryPtr::create_ly_context() {
   }
 
   // set module callback (only if there is a model provider)
-  if (!model_providers.empty()) {
+  if (!get_model_providers().empty()) {
     ly_ctx_set_module_imp_clb(ctx, get_module_callback, this);
   }
 
@@ -253,14 +253,27 @@ std::shared_ptr<ydk::path::RootSchemaNode>
 ydk::path::RepositoryPtr::create_root_schema(
     const std::unordered_map<std::string, path::Capability>& lookup_table,
     const std::vector<path::Capability>& caps_to_load) {
+  if (caching_option == ModelCachingOption::SHARED) {
+    auto fingerprint = get_schema_fingerprint(path, lookup_table, caps_to_load);
+    return SchemaRegistry::get_instance().get_root_schema(
+        fingerprint, get_model_providers(), [&]() {
+          return create_root_schema_impl(lookup_table, caps_to_load);
+        });
+  }
+  return create_root_schema_impl(lookup_table, caps_to_load);
+}
+
+std::shared_ptr<ydk::path::RootSchemaNodeImpl>
+ydk::path::RepositoryPtr::create_root_schema_impl(
+    const std::unordered_map<std::string, path::Capability>& lookup_table,
+    const std::vector<path::Capability>& caps_to_load) {
   ly_verb(LY_LLVRB);  // enable libyang logging
   ly_ctx* ctx = create_ly_context();
 
   load_module_from_capabilities(ctx, caps_to_load);
 
-  RootSchemaNodeImpl* rs =
-      new RootSchemaNodeImpl{ctx, shared_from_this(), lookup_table};
-  return std::shared_ptr<RootSchemaNode>(rs);
+  return std::make_shared<RootSchemaNodeImpl>(ctx, shared_from_this(),
+                                              lookup_table);
 }
 
 void ydk::path::RepositoryPtr::load_module_from_capabilities(
@@ -307,14 +320,18 @@ static bool contains_letters_dashes_colon_dot_slash(
 std::vector<const lys_module*>
 ydk::path::RepositoryPtr::get_new_ly_modules_from_lookup(
     ly_ctx* ctx, const std::unordered_set<std::string>& namespace_module_names,
-    const std::unordered_map<std::string, path::Capability>& lookup_table) {
+    const std::unordered_map<std::string, path::Capability>& lookup_table,
+    std::unordered_set<std::string>* resolved_names) {
   std::vector<const lys_module*> new_modules;
 
   for (auto k : namespace_module_names) {
     // k could be module namespace, which contains extra '/', ':', '.', need
     // to add them to predicate function
-    if (contains_letters_dashes_colon_dot_slash(k) &&
-        !contains_only_numbers(k)) {
+    if (!contains_letters_dashes_colon_dot_slash(k) ||
+        contains_only_numbers(k)) {
+      // not a module name, there is nothing to load for it
+      if (resolved_names) resolved_names->insert(k);
+    } else {
       bool new_module = true;
       auto module_name = k;
 
@@ -336,6 +353,7 @@ ydk::path::RepositoryPtr::get_new_ly_modules_from_lookup(
         YLOG_DEBUG("Added new libyang module '{}'", std::string(m->name));
         new_modules.emplace_back(m);
       }
+      if (m && resolved_names) resolved_names->insert(k);
 
       // resolve deviation module after main module
       if (kit != lookup_table.end()) {
@@ -492,6 +510,7 @@ void ydk::path::RepositoryPtr::get_module_capabilities(
 ///
 void ydk::path::RepositoryPtr::add_model_provider(
     ydk::path::ModelProvider* model_provider) {
+  std::lock_guard<std::mutex> guard{model_providers_mutex};
   model_providers.push_back(model_provider);
 }
 
@@ -502,6 +521,7 @@ void ydk::path::RepositoryPtr::add_model_provider(
 ///
 void ydk::path::RepositoryPtr::remove_model_provider(
     ydk::path::ModelProvider* model_provider) {
+  std::lock_guard<std::mutex> guard{model_providers_mutex};
   auto item =
       std::find(model_providers.begin(), model_providers.end(), model_provider);
   if (item != model_providers.end()) {
@@ -518,6 +538,7 @@ void ydk::path::RepositoryPtr::remove_model_provider(
 ///
 std::vector<ydk::path::ModelProvider*>
 ydk::path::RepositoryPtr::get_model_providers() const {
+  std::lock_guard<std::mutex> guard{model_providers_mutex};
   return model_providers;
 }
 
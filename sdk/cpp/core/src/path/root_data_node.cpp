@@ -30,7 +30,7 @@
 ydk::path::RootDataImpl::RootDataImpl(const SchemaNode& schema,
                                       struct ly_ctx* ctx,
                                       const std::string& path)
-    : DataNodeImpl(nullptr, nullptr, nullptr),
+    : DataNodeImpl(nullptr, nullptr, nullptr, &get_schema_lock(schema)),
       m_schema(schema),
       m_ctx(ctx),
       m_path(path) {}
@@ -38,7 +38,7 @@ ydk::path::RootDataImpl::RootDataImpl(const SchemaNode& schema,
 ydk::path::RootDataImpl::RootDataImpl(
     const SchemaNode& schema, struct ly_ctx* ctx, const std::string& path,
     const std::shared_ptr<RepositoryPtr>& repo)
-    : DataNodeImpl(nullptr, nullptr, repo),
+    : DataNodeImpl(nullptr, nullptr, repo, &get_schema_lock(schema)),
       m_schema(schema),
       m_ctx(ctx),
       m_path(path),
@@ -84,10 +84,13 @@ ydk::path::DataNode& ydk::path::RootDataImpl::create_datanode(
 
   std::string start_seg = m_path + segments[0];
   YLOG_DEBUG("Creating root data node with path '{}'", start_seg);
-  struct lyd_node* dnode =
-      lyd_new_path(m_node, m_ctx, start_seg.c_str(),
-                   segments.size() == 1 ? (void*)value.c_str() : nullptr,
-                   LYD_ANYDATA_SXML, 0);
+  struct lyd_node* dnode = nullptr;
+  {
+    SchemaReadGuard guard{*m_schema_lock};
+    dnode = lyd_new_path(m_node, m_ctx, start_seg.c_str(),
+                         segments.size() == 1 ? (void*)value.c_str() : nullptr,
+                         LYD_ANYDATA_SXML, 0);
+  }
 
   if (dnode == nullptr) {
     YLOG_ERROR("Path '{}' is invalid", path);
@@ -188,6 +191,7 @@ std::vector<std::shared_ptr<ydk::path::DataNode>> ydk::path::RootDataImpl::find(
   schema_path += path;
 
   YLOG_DEBUG("Looking for schema nodes path in root: '{}'", schema_path);
+  SchemaReadGuard guard{*m_schema_lock};
   const struct lys_node* found_snode = ly_ctx_get_node(
       m_node->schema->module->ctx, nullptr, schema_path.c_str(), 1);
 
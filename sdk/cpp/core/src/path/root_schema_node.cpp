@@ -115,6 +115,56 @@ static std::unordered_set<std::string> get_module_names_from_json_payload(
 }
 }  // namespace ydk
 
+//////////////////////////////////////////////////////////////////////////////
+/// SchemaLock
+/////////////////////////////////////////////////////////////////////////////
+
+ydk::path::SchemaLock::SchemaLock()
+    : m_readers{0}, m_waiting_writers{0}, m_writer{false} {}
+
+void ydk::path::SchemaLock::lock() {
+  std::unique_lock<std::mutex> lock{m_mutex};
+  ++m_waiting_writers;
+  m_condition.wait(lock, [this] { return !m_writer && m_readers == 0; });
+  --m_waiting_writers;
+  m_writer = true;
+}
+
+void ydk::path::SchemaLock::unlock() {
+  {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    m_writer = false;
+  }
+  m_condition.notify_all();
+}
+
+void ydk::path::SchemaLock::lock_shared() {
+  std::unique_lock<std::mutex> lock{m_mutex};
+  m_condition.wait(lock,
+                   [this] { return !m_writer && m_waiting_writers == 0; });
+  ++m_readers;
+}
+
+void ydk::path::SchemaLock::unlock_shared() {
+  bool last_reader = false;
+  {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    last_reader = (--m_readers == 0);
+  }
+  if (last_reader) m_condition.notify_all();
+}
+
+ydk::path::SchemaReadGuard::SchemaReadGuard(SchemaLock& lock) : m_lock(lock) {
+  m_lock.lock_shared();
+}
+
+ydk::path::SchemaReadGuard::~SchemaReadGuard() { m_lock.unlock_shared(); }
+
+ydk::path::SchemaLock& ydk::path::get_schema_lock(const SchemaNode& node) {
+  auto& root = const_cast<SchemaNode&>(node.get_root());
+  return dynamic_cast<RootSchemaNodeImpl&>(root).m_schema_lock;
+}
+
 //////////////////////////////////////////////////////////////////////////////
 /// RootSchemaNode
 /////////////////////////////////////////////////////////////////////////////
@@ -166,6 +216,11 @@ ydk::path::RootSchemaNodeImpl::~RootSchemaNodeImpl() {
   }
 }
 
+const std::shared_ptr<ydk::path::RepositoryPtr>&
+ydk::path::RootSchemaNodeImpl::get_repository() const {
+  return m_priv_repo;
+}
+
 void ydk::path::RootSchemaNodeImpl::populate_all_module_schemas() {
   uint32_t idx = 0;
   while (auto m = ly_ctx_get_module_iter(m_ctx, &idx)) {
@@ -178,38 +233,66 @@ void ydk::path::RootSchemaNodeImpl::populate_module_schema(
   YLOG_DEBUG("Populating new module schema '{}'", module->name);
   const struct lys_node* last = nullptr;
   while (auto q = lys_getnext(last, nullptr, module, 0)) {
-    m_children.push_back(std::make_unique<SchemaNodeImpl>(
-        this, const_cast<struct lys_node*>(q)));
+    add_child(const_cast<struct lys_node*>(q));
     last = q;
   }
 }
 
+void ydk::path::RootSchemaNodeImpl::add_child(struct lys_node* node) {
+  auto child = std::make_unique<SchemaNodeImpl>(this, node);
+  m_children_by_name.emplace(node->name, child.get());
+  m_children.push_back(std::move(child));
+}
+
 void ydk::path::RootSchemaNodeImpl::populate_new_schemas_from_payload(
     const std::string& payload, ydk::EncodingFormat format) {
   YLOG_DEBUG("Populating new schema from payload:\n{}", payload);
-  std::vector<const lys_module*> modules;
   if (format == ydk::EncodingFormat::XML) {
     std::string xml_str = trim(payload);
     if (xml_str.substr(0, 5) != "<?xml")
       xml_str = "<data>" + payload + "</data>";
-    auto namespaces = get_namespaces_from_xml_payload(xml_str);
-    modules = m_priv_repo->get_new_ly_modules_from_lookup(
-        m_ctx, namespaces, m_name_namespace_lookup);
+    populate_new_schemas(get_namespaces_from_xml_payload(xml_str));
   } else {
-    auto module_names = get_module_names_from_json_payload(payload);
-    modules = m_priv_repo->get_new_ly_modules_from_lookup(
-        m_ctx, module_names, m_name_namespace_lookup);
+    populate_new_schemas(get_module_names_from_json_payload(payload));
   }
-
-  populate_new_schemas(modules);
 }
 
 void ydk::path::RootSchemaNodeImpl::populate_new_schemas_from_path(
     const std::string& path) {
   if (path.empty()) return;
   YLOG_DEBUG("Getting new modules for path '{}'", path);
-  auto new_modules = m_priv_repo->get_new_ly_modules_from_path(
-      m_ctx, path, m_name_namespace_lookup);
+  populate_new_schemas(path::segmentalize_module_names(path));
+}
+
+bool ydk::path::RootSchemaNodeImpl::has_unresolved_names(
+    const std::unordered_set<std::string>& namespace_module_names) {
+  for (auto& name : namespace_module_names) {
+    if (m_resolved_names.find(name) == m_resolved_names.end()) return true;
+  }
+  return false;
+}
+
+void ydk::path::RootSchemaNodeImpl::populate_new_schemas(
+    const std::unordered_set<std::string>& namespace_module_names) {
+  // fast path: every name already resolved to a loaded module
+  {
+    SchemaReadGuard guard{m_schema_lock};
+    if (!has_unresolved_names(namespace_module_names)) return;
+  }
+
+  std::lock_guard<SchemaLock> guard{m_schema_lock};
+  std::unordered_set<std::string> unresolved;
+  for (auto& name : namespace_module_names) {
+    if (m_resolved_names.find(name) == m_resolved_names.end()) {
+      unresolved.insert(name);
+    }
+  }
+  if (unresolved.empty()) return;
+
+  // only names whose module loaded are remembered, a failed load is retried
+  // on the next lookup in case the module becomes available
+  auto new_modules = m_priv_repo->get_new_ly_modules_from_lookup(
+      m_ctx, unresolved, m_name_namespace_lookup, &m_resolved_names);
   populate_new_schemas(new_modules);
 }
 
@@ -250,25 +333,15 @@ void ydk::path::RootSchemaNodeImpl::populate_augmented_schema_node(
 
   lys_node* root = ancestors.back();
   // quick fix: populate augmented top node if we have not already done so
-  bool found = false;
-  for (auto& c : m_children) {
-    if (c->get_statement().arg == root->name) {
-      found = true;
-      break;
-    }
-  }
-  if (found == false) {
-    m_children.push_back(std::make_unique<SchemaNodeImpl>(
-        this, const_cast<struct lys_node*>(root)));
+  if (m_children_by_name.find(root->name) == m_children_by_name.end()) {
+    add_child(root);
   }
 
   // populate the rest of augmented schema nodes
   ancestors.pop_back();
-  for (auto& c : m_children) {
-    if (c->get_statement().arg == root->name) {
-      reinterpret_cast<SchemaNodeImpl*>(c.get())
-          ->populate_augmented_schema_node(ancestors, target);
-    }
+  auto range = m_children_by_name.equal_range(root->name);
+  for (auto c = range.first; c != range.second; ++c) {
+    c->second->populate_augmented_schema_node(ancestors, target);
   }
 }
 
@@ -292,11 +365,12 @@ std::vector<ydk::path::SchemaNode*> ydk::path::RootSchemaNodeImpl::find(
   std::string full_path{"/"};
   full_path += path;
 
+  SchemaReadGuard guard{m_schema_lock};
   const struct lys_node* found_node =
       ly_ctx_get_node(m_ctx, nullptr, full_path.c_str(), 0);
 
   if (found_node) {
-    auto p = reinterpret_cast<SchemaNode*>(found_node->priv);
+    SchemaNode* p = get_schema_node_impl(found_node);
     if (p) {
       ret.push_back(p);
     }
@@ -321,8 +395,12 @@ ydk::path::DataNode& ydk::path::RootSchemaNodeImpl::create_datanode(
 
   auto root_data_node =
       std::make_unique<RootDataImpl>(*this, m_ctx, "/", m_priv_repo);
-  m_root_data_nodes.push_back(std::move(root_data_node));
-  return m_root_data_nodes.back()->create_datanode(path, value);
+  DataNode* rd = root_data_node.get();
+  {
+    std::lock_guard<std::mutex> guard{m_root_data_nodes_mutex};
+    m_root_data_nodes.push_back(std::move(root_data_node));
+  }
+  return rd->create_datanode(path, value);
 }
 
 std::shared_ptr<ydk::path::Rpc> ydk::path::RootSchemaNodeImpl::create_rpc(
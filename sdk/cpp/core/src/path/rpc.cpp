@@ -35,15 +35,20 @@ ydk::path::Rpc::~Rpc() {}
 ydk::path::RpcImpl::RpcImpl(SchemaNodeImpl& sn, struct ly_ctx* ctx,
                             const std::shared_ptr<RepositoryPtr>& repo)
     : schema_node(sn), m_priv_repo(repo) {
-  struct lyd_node* dnode = lyd_new_path(nullptr, ctx, sn.get_path().c_str(),
-                                        (void*)"", LYD_ANYDATA_SXML, 0);
+  struct lyd_node* dnode = nullptr;
+  {
+    SchemaReadGuard guard{get_schema_lock(sn)};
+    dnode = lyd_new_path(nullptr, ctx, sn.get_path().c_str(), (void*)"",
+                         LYD_ANYDATA_SXML, 0);
+  }
 
   if (!dnode) {
     YLOG_ERROR("Cannot find RPC with path {}", sn.get_path());
     throw(YModelError{"Invalid RPC"});
   }
 
-  data_node = std::make_unique<DataNodeImpl>(nullptr, dnode, m_priv_repo);
+  data_node = std::make_unique<DataNodeImpl>(nullptr, dnode, m_priv_repo,
+                                             &get_schema_lock(sn));
 }
 
 ydk::path::RpcImpl::~RpcImpl() {}
@@ -36,29 +36,70 @@ ydk::path::SchemaNode::~SchemaNode() {}
 ////////////////////////////////////////////////////////////////////
 ydk::path::SchemaNodeImpl::SchemaNodeImpl(const SchemaNode* parent,
                                           struct lys_node* node)
-    : m_parent{parent}, m_node{node}, m_children{} {
-  node->priv = this;
-  if (node->nodetype != LYS_LEAF && node->nodetype != LYS_LEAFLIST) {
-    const struct lys_node* last = nullptr;
+    : m_parent{parent},
+      m_node{node},
+      m_children{},
+      m_children_populated{node->nodetype == LYS_LEAF ||
+                           node->nodetype == LYS_LEAFLIST} {
+  // released so that lookups finding the wrapper through priv without
+  // synchronizing on the population see it constructed
+  __atomic_store_n(&node->priv, static_cast<void*>(this), __ATOMIC_RELEASE);
+}
 
-    while (auto q = lys_getnext(last, node, nullptr, 0)) {
-      m_children.emplace_back(
-          make_unique<SchemaNodeImpl>(this, const_cast<struct lys_node*>(q)));
+void ydk::path::SchemaNodeImpl::populate_children() const {
+  // the children and their lys_node::priv are published once; callers of
+  // get_children() see them once call_once returns
+  call_once(m_children_once, [this] {
+    const struct lys_node* last = nullptr;
+    while (auto q = lys_getnext(last, m_node, nullptr, 0)) {
+      add_child(const_cast<struct lys_node*>(q));
       last = q;
     }
+    m_children_populated.store(true, memory_order_release);
+  });
+}
+
+void ydk::path::SchemaNodeImpl::add_child(struct lys_node* node) const {
+  auto child = make_unique<SchemaNodeImpl>(this, node);
+  m_children_by_name.emplace(node->name, child.get());
+  m_children.push_back(move(child));
+}
+
+ydk::path::SchemaNodeImpl* ydk::path::get_schema_node_impl(
+    const struct lys_node* node) {
+  if (node == nullptr) return nullptr;
+
+  // a node wrapped before resolves through its cached wrapper
+  auto impl = __atomic_load_n(&node->priv, __ATOMIC_ACQUIRE);
+  if (impl) return static_cast<SchemaNodeImpl*>(impl);
+
+  // top-level wrappers are created under the exclusive schema lock; the
+  // others only by populating the children of their closest wrapped
+  // ancestor, which this node is reached from directly or through choice,
+  // case and uses nodes, so priv is read after that population completed
+  for (auto p = lys_parent(node); p; p = lys_parent(p)) {
+    auto parent = get_schema_node_impl(p);
+    if (parent) {
+      parent->get_children();
+      break;
+    }
   }
+  return static_cast<SchemaNodeImpl*>(
+      __atomic_load_n(&node->priv, __ATOMIC_ACQUIRE));
 }
 
 void ydk::path::SchemaNodeImpl::populate_augmented_schema_node(
     vector<lys_node*>& ancestors, struct lys_node* node) {
+  // children wrapped later pick up the augmented nodes by themselves; this
+  // runs under the exclusive schema lock
+  if (!m_children_populated.load(memory_order_acquire)) return;
+
   if (!ancestors.empty()) {
     auto curr = ancestors.back();
     ancestors.pop_back();
-    for (auto& c : m_children) {
-      if (c->get_statement().arg == curr->name) {
-        reinterpret_cast<SchemaNodeImpl*>(c.get())
-            ->populate_augmented_schema_node(ancestors, node);
-      }
+    auto range = m_children_by_name.equal_range(curr->name);
+    for (auto c = range.first; c != range.second; ++c) {
+      c->second->populate_augmented_schema_node(ancestors, node);
     }
   } else {
     const struct lys_node* last = nullptr;
@@ -69,8 +110,7 @@ void ydk::path::SchemaNodeImpl::populate_augmented_schema_node(
       }
       if (p) {
         YLOG_DEBUG("Populating new schema node '{}'", string(p->name));
-        m_children.emplace_back(
-            make_unique<SchemaNodeImpl>(this, const_cast<struct lys_node*>(p)));
+        add_child(const_cast<struct lys_node*>(p));
       }
     }
   }
@@ -128,11 +168,12 @@ vector<ydk::path::SchemaNode*> ydk::path::SchemaNodeImpl::find(
   vector<SchemaNode*> ret;
   struct ly_ctx* ctx = m_node->module->ctx;
 
+  SchemaReadGuard guard{get_schema_lock(*this)};
   const struct lys_node* found_node =
       ly_ctx_get_node(ctx, m_node, path.c_str(), 0);
 
   if (found_node) {
-    auto p = reinterpret_cast<SchemaNode*>(found_node->priv);
+    SchemaNode* p = get_schema_node_impl(found_node);
     if (p) {
       ret.push_back(p);
     }
@@ -148,6 +189,7 @@ const ydk::path::SchemaNode* ydk::path::SchemaNodeImpl::get_parent()
 
 const vector<unique_ptr<ydk::path::SchemaNode>>&
 ydk::path::SchemaNodeImpl::get_children() const {
+  if (!m_children_populated.load(memory_order_acquire)) populate_children();
   return m_children;
 }
 
@@ -259,7 +301,8 @@ vector<ydk::path::Statement> ydk::path::SchemaNodeImpl::get_keys() const {
     }
     struct lys_node_list* slist = (struct lys_node_list*)m_node;
     for (uint8_t i = 0; i < slist->keys_size; ++i) {
-      SchemaNode* sn = reinterpret_cast<SchemaNode*>(slist->keys[i]->priv);
+      SchemaNode* sn =
+          get_schema_node_impl(reinterpret_cast<lys_node*>(slist->keys[i]));
       if (sn != nullptr) {
         stmts.push_back(sn->get_statement());
       }
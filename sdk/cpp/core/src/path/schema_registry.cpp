@@ -0,0 +1,219 @@
+/// YANG Development Kit
+// Copyright 2016 Cisco Systems. All rights reserved
+//
+////////////////////////////////////////////////////////////////
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+//////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <sstream>
+
+#include "../logger.hpp"
+#include "path_private.hpp"
+
+namespace ydk {
+namespace path {
+
+static std::string get_capability_fingerprint(const Capability& capability) {
+  std::vector<std::string> features{capability.features};
+  std::vector<std::string> deviations{capability.deviations};
+  std::sort(features.begin(), features.end());
+  std::sort(deviations.begin(), deviations.end());
+
+  std::ostringstream fingerprint;
+  fingerprint << capability.module << "@" << capability.revision;
+  for (auto& f : features) fingerprint << "+" << f;
+  for (auto& d : deviations) fingerprint << "~" << d;
+  return fingerprint.str();
+}
+
+///
+/// @brief Canonical fingerprint of the capabilities a root schema is built
+/// from.
+///
+/// Two repositories producing the same fingerprint compile identical schema
+/// trees, so the order in which a device reports its capabilities must not
+/// matter.
+///
+std::string get_schema_fingerprint(
+    const std::string& search_path,
+    const std::unordered_map<std::string, Capability>& lookup_table,
+    const std::vector<Capability>& caps_to_load) {
+  std::vector<std::string> caps;
+  for (auto& c : caps_to_load) caps.push_back(get_capability_fingerprint(c));
+  std::sort(caps.begin(), caps.end());
+
+  std::vector<std::string> lookup;
+  for (auto& entry : lookup_table)
+    lookup.push_back(entry.first + "=" +
+                     get_capability_fingerprint(entry.second));
+  std::sort(lookup.begin(), lookup.end());
+
+  std::ostringstream fingerprint;
+  fingerprint << search_path << "|";
+  for (auto& c : caps) fingerprint << c << ";";
+  fingerprint << "|";
+  for (auto& l : lookup) fingerprint << l << ";";
+  return fingerprint.str();
+}
+
+//////////////////////////////////////////////////////////////////////////
+// class SharedRootSchemaNode
+//////////////////////////////////////////////////////////////////////////
+SharedRootSchemaNode::SharedRootSchemaNode(
+    const std::shared_ptr<RootSchemaNodeImpl>& schema,
+    const std::vector<ModelProvider*>& model_providers)
+    : m_schema{schema}, m_model_providers{model_providers} {
+  auto& repo = m_schema->get_repository();
+  auto registered = repo->get_model_providers();
+  for (auto p : m_model_providers) {
+    if (std::find(registered.begin(), registered.end(), p) ==
+        registered.end()) {
+      repo->add_model_provider(p);
+    }
+  }
+}
+
+SharedRootSchemaNode::~SharedRootSchemaNode() {
+  m_root_data_nodes.clear();
+  // the session owning these providers is going away; on-demand loading
+  // in the shared schema must not call into them any more
+  auto& repo = m_schema->get_repository();
+  for (auto p : m_model_providers) {
+    repo->remove_model_provider(p);
+  }
+}
+
+std::vector<SchemaNode*> SharedRootSchemaNode::find(const std::string& path) {
+  return m_schema->find(path);
+}
+
+const std::vector<std::unique_ptr<SchemaNode>>&
+SharedRootSchemaNode::get_children() const {
+  return m_schema->get_children();
+}
+
+const SchemaNode& SharedRootSchemaNode::get_root() const noexcept {
+  return *m_schema;
+}
+
+DataNode& SharedRootSchemaNode::create_datanode(const std::string& path) {
+  return create_datanode(path, "");
+}
+
+DataNode& SharedRootSchemaNode::create_datanode(const std::string& path,
+                                                const std::string& value) {
+  m_schema->populate_new_schemas_from_path(path);
+
+  auto root_data_node = std::make_unique<RootDataImpl>(
+      *m_schema, m_schema->m_ctx, "/", m_schema->get_repository());
+  DataNode* rd = root_data_node.get();
+  {
+    std::lock_guard<std::mutex> guard{m_root_data_nodes_mutex};
+    m_root_data_nodes.push_back(std::move(root_data_node));
+  }
+  return rd->create_datanode(path, value);
+}
+
+std::shared_ptr<Rpc> SharedRootSchemaNode::create_rpc(const std::string& path) {
+  return m_schema->create_rpc(path);
+}
+
+RootSchemaNodeImpl& get_root_schema_impl(RootSchemaNode& root_schema) {
+  // a RootSchemaNodeImpl is its own root
+  auto& root = const_cast<SchemaNode&>(root_schema.get_root());
+  return dynamic_cast<RootSchemaNodeImpl&>(root);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// class SchemaRegistry
+//////////////////////////////////////////////////////////////////////////
+SchemaRegistry& SchemaRegistry::get_instance() {
+  static SchemaRegistry instance;
+  return instance;
+}
+
+std::shared_ptr<RootSchemaNode> SchemaRegistry::get_root_schema(
+    const std::string& fingerprint,
+    const std::vector<ModelProvider*>& model_providers,
+    const std::function<std::shared_ptr<RootSchemaNodeImpl>()>& create) {
+  for (;;) {
+    std::promise<std::weak_ptr<RootSchemaNodeImpl>> compiled;
+    SchemaFuture future;
+    bool compile = false;
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      purge_expired();
+      auto it = m_schemas.find(fingerprint);
+      if (it != m_schemas.end()) {
+        future = it->second;
+      } else {
+        future = compiled.get_future().share();
+        m_schemas[fingerprint] = future;
+        compile = true;
+      }
+    }
+
+    if (compile) {
+      YLOG_DEBUG("Compiling new shared root schema");
+      std::shared_ptr<RootSchemaNodeImpl> schema;
+      try {
+        schema = create();
+      } catch (...) {
+        {
+          std::lock_guard<std::mutex> guard(m_mutex);
+          m_schemas.erase(fingerprint);
+        }
+        compiled.set_exception(std::current_exception());
+        throw;
+      }
+      compiled.set_value(schema);
+      return std::make_shared<SharedRootSchemaNode>(schema, model_providers);
+    }
+
+    // rethrows the error of a failed compile
+    auto schema = future.get().lock();
+    if (schema) {
+      YLOG_DEBUG("Sharing compiled root schema with matching capabilities");
+      return std::make_shared<SharedRootSchemaNode>(schema, model_providers);
+    }
+    // released by its last session since; it is compiled again
+  }
+}
+
+std::size_t SchemaRegistry::size() {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  purge_expired();
+  return m_schemas.size();
+}
+
+void SchemaRegistry::purge_expired() {
+  for (auto it = m_schemas.begin(); it != m_schemas.end();) {
+    // schemas still being compiled are kept
+    if (it->second.wait_for(std::chrono::seconds(0)) ==
+            std::future_status::ready &&
+        it->second.get().expired())
+      it = m_schemas.erase(it);
+    else
+      ++it;
+  }
+}
+
+}  // namespace path
+}  // namespace ydk
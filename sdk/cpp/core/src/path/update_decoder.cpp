@@ -0,0 +1,378 @@
+/// YANG Development Kit
+// Copyright 2016 Cisco Systems. All rights reserved
+//
+////////////////////////////////////////////////////////////////
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+//////////////////////////////////////////////////////////////////
+
+#include <json.hpp>
+
+#include "../logger.hpp"
+#include "path_private.hpp"
+
+using json = nlohmann::json;
+
+namespace ydk {
+namespace path {
+
+// Builds a libyang data tree from path/value updates. Schema lookups and the
+// data nodes created so far are indexed by parent, so applying an update
+// costs a hash lookup per path element instead of a search of the siblings.
+// Must be used with the schema lock of the root schema held.
+class UpdateDecoder {
+ public:
+  explicit UpdateDecoder(RootSchemaNodeImpl& root_schema)
+      : m_ctx{root_schema.m_ctx}, m_first{nullptr} {}
+
+  ~UpdateDecoder() {
+    if (m_first) lyd_free_withsiblings(m_first);
+  }
+
+  void apply(const DataUpdate& update) {
+    lyd_node* parent = nullptr;
+    const lys_node* parent_schema = nullptr;
+    for (size_t i = 0; i < update.path.size(); i++) {
+      auto& element = update.path[i];
+      auto schema = find_schema(parent_schema, element.name);
+      bool last = i + 1 == update.path.size();
+      if (last && ((schema->nodetype & (LYS_LEAF | LYS_LEAFLIST)) ||
+                   (schema->nodetype == LYS_LIST && element.keys.empty()))) {
+        apply_value(parent, schema, update);
+        return;
+      }
+      parent = get_node(parent, schema, get_key_values(schema, element));
+      parent_schema = schema;
+    }
+
+    if (update.json && !update.values.empty()) {
+      apply_members(parent, parent_schema, json::parse(update.values[0]));
+    }
+  }
+
+  // Hands the top-level nodes over to the caller
+  lyd_node* release() {
+    lyd_node* first = m_first;
+    m_first = nullptr;
+    return first;
+  }
+
+ private:
+  const lys_node* find_schema(const lys_node* parent, const std::string& name) {
+    auto& children = m_schemas[parent];
+    auto found = children.find(name);
+    if (found != children.end()) return found->second;
+
+    std::string module_name;
+    std::string node_name = name;
+    auto colon = name.find(':');
+    if (colon != std::string::npos) {
+      module_name = name.substr(0, colon);
+      node_name = name.substr(colon + 1);
+    }
+
+    const lys_node* schema = nullptr;
+    if (parent) {
+      while ((schema = lys_getnext(schema, parent, nullptr, 0))) {
+        if (node_name == schema->name &&
+            (module_name.empty() ||
+             module_name == lys_node_module(schema)->name))
+          break;
+      }
+    } else {
+      uint32_t index = 0;
+      const lys_module* module;
+      while (!schema && (module = ly_ctx_get_module_iter(m_ctx, &index))) {
+        if (!module->implemented ||
+            (!module_name.empty() && module_name != module->name))
+          continue;
+        while ((schema = lys_getnext(schema, nullptr, module, 0))) {
+          if (node_name == schema->name) break;
+        }
+      }
+    }
+
+    if (schema == nullptr) {
+      YLOG_ERROR("Could not find schema node '{}' under '{}'", name,
+                 parent ? parent->name : "/");
+      throw(YCoreError{"Could not find schema node: " + name});
+    }
+    children.emplace(name, schema);
+    return schema;
+  }
+
+  std::vector<std::string> get_key_values(const lys_node* schema,
+                                          const PathElement& element) {
+    std::vector<std::string> values;
+    if (schema->nodetype != LYS_LIST) return values;
+
+    auto list = reinterpret_cast<const lys_node_list*>(schema);
+    for (uint8_t i = 0; i < list->keys_size; i++) {
+      const char* key_name = list->keys[i]->name;
+      auto key = std::find_if(
+          element.keys.begin(), element.keys.end(),
+          [key_name](const std::pair<std::string, std::string>& key) {
+            auto colon = key.first.find(':');
+            return key.first.compare(
+                       colon == std::string::npos ? 0 : colon + 1,
+                       std::string::npos, key_name) == 0;
+          });
+      if (key == element.keys.end()) {
+        YLOG_ERROR("Missing key '{}' of list '{}'", key_name, schema->name);
+        throw(YCoreError{"Missing key value for list: " + element.name});
+      }
+      // some targets send string keys quoted
+      auto& value = key->second;
+      if (value.size() > 1 && value.front() == '"' && value.back() == '"')
+        values.push_back(value.substr(1, value.size() - 2));
+      else
+        values.push_back(value);
+    }
+    return values;
+  }
+
+  std::vector<std::string> get_key_values(const lys_node* schema,
+                                          const json& object) {
+    std::vector<std::string> values;
+    auto list = reinterpret_cast<const lys_node_list*>(schema);
+    for (uint8_t i = 0; i < list->keys_size; i++) {
+      auto key_schema = reinterpret_cast<const lys_node*>(list->keys[i]);
+      auto key = object.find(key_schema->name);
+      if (key == object.end()) {
+        key = object.find(std::string{lys_node_module(key_schema)->name} +
+                          ":" + key_schema->name);
+      }
+      if (key == object.end()) {
+        YLOG_ERROR("Missing key '{}' of list '{}'", key_schema->name,
+                   schema->name);
+        throw(YCoreError{"Missing key value for list: " +
+                         std::string{schema->name}});
+      }
+      values.push_back(get_scalar_value(*key));
+    }
+    return values;
+  }
+
+  // Finds or creates a container or list entry
+  lyd_node* get_node(lyd_node* parent, const lys_node* schema,
+                     const std::vector<std::string>& key_values) {
+    std::string id = schema->name;
+    for (auto& value : key_values) {
+      id += '\n';
+      id += value;
+    }
+    auto& siblings = m_nodes[parent];
+    auto found = siblings.find(id);
+    if (found != siblings.end()) return found->second;
+
+    lyd_node* node = create_node(parent, schema, nullptr);
+    siblings.emplace(std::move(id), node);
+
+    if (!key_values.empty()) {
+      auto list = reinterpret_cast<const lys_node_list*>(schema);
+      auto& keys = m_nodes[node];
+      for (uint8_t i = 0; i < list->keys_size; i++) {
+        auto key_schema = reinterpret_cast<const lys_node*>(list->keys[i]);
+        keys.emplace(key_schema->name,
+                     create_node(node, key_schema, key_values[i].c_str()));
+      }
+    }
+    return node;
+  }
+
+  void set_leaf(lyd_node* parent, const lys_node* schema,
+                const std::string& value) {
+    auto& siblings = m_nodes[parent];
+    auto found = siblings.find(schema->name);
+    if (found == siblings.end()) {
+      siblings.emplace(schema->name,
+                       create_node(parent, schema, value.c_str()));
+      return;
+    }
+    // list keys are also sent as leaves and cannot be changed
+    auto leaf = reinterpret_cast<lyd_node_leaf_list*>(found->second);
+    if (value != leaf->value_str && lyd_change_leaf(leaf, value.c_str()) < 0) {
+      YLOG_ERROR("Invalid value '{}' for leaf '{}': {}", value, schema->name,
+                 ly_errmsg());
+      throw(YCoreError{"Invalid value for leaf: " +
+                       std::string{schema->name}});
+    }
+  }
+
+  lyd_node* create_node(lyd_node* parent, const lys_node* schema,
+                        const char* value) {
+    auto module = lys_node_module(schema);
+    lyd_node* node = value ? lyd_new_leaf(parent, module, schema->name, value)
+                           : lyd_new(parent, module, schema->name);
+    if (node == nullptr) {
+      YLOG_ERROR("Could not create data node '{}': {}", schema->name,
+                 ly_errmsg());
+      throw(YCoreError{"Could not create data node: " +
+                       std::string{schema->name}});
+    }
+    if (parent == nullptr) {
+      if (m_first) {
+        lyd_node* last = m_first->prev;
+        last->next = node;
+        node->prev = last;
+        m_first->prev = node;
+      } else {
+        m_first = node;
+      }
+    }
+    return node;
+  }
+
+  void apply_value(lyd_node* parent, const lys_node* schema,
+                   const DataUpdate& update) {
+    if (update.json) {
+      if (!update.values.empty())
+        apply_json(parent, schema, json::parse(update.values[0]));
+    } else if (schema->nodetype == LYS_LEAF) {
+      set_leaf(parent, schema,
+               update.values.empty() ? std::string{} : update.values[0]);
+    } else if (schema->nodetype == LYS_LEAFLIST) {
+      for (auto& value : update.values)
+        create_node(parent, schema, value.c_str());
+    } else {
+      YLOG_ERROR("List '{}' needs keys or a JSON value", schema->name);
+      throw(YCoreError{"Missing key value for list: " +
+                       std::string{schema->name}});
+    }
+  }
+
+  void apply_json(lyd_node* parent, const lys_node* schema,
+                  const json& value) {
+    switch (schema->nodetype) {
+      case LYS_LEAF:
+        set_leaf(parent, schema, get_scalar_value(value));
+        break;
+      case LYS_LEAFLIST:
+        if (value.is_array()) {
+          for (auto& entry : value)
+            create_node(parent, schema, get_scalar_value(entry).c_str());
+        } else {
+          create_node(parent, schema, get_scalar_value(value).c_str());
+        }
+        break;
+      case LYS_CONTAINER:
+        apply_members(get_node(parent, schema, {}), schema, value);
+        break;
+      case LYS_LIST:
+        if (value.is_array()) {
+          for (auto& entry : value) apply_list_entry(parent, schema, entry);
+        } else {
+          apply_list_entry(parent, schema, value);
+        }
+        break;
+      default:
+        YLOG_WARN("Skipping value of unsupported node '{}'", schema->name);
+        break;
+    }
+  }
+
+  void apply_list_entry(lyd_node* parent, const lys_node* schema,
+                        const json& entry) {
+    lyd_node* node = get_node(parent, schema, get_key_values(schema, entry));
+    apply_members(node, schema, entry);
+  }
+
+  void apply_members(lyd_node* node, const lys_node* schema,
+                     const json& object) {
+    if (!object.is_object()) return;
+    for (auto member = object.begin(); member != object.end(); ++member) {
+      // skip RFC 7952 metadata
+      if (member.key()[0] == '@') continue;
+      auto child = find_schema(schema, member.key());
+      if (schema && schema->nodetype == LYS_LIST && is_key(schema, child))
+        continue;
+      apply_json(node, child, member.value());
+    }
+  }
+
+  static bool is_key(const lys_node* list_schema, const lys_node* schema) {
+    auto list = reinterpret_cast<const lys_node_list*>(list_schema);
+    for (uint8_t i = 0; i < list->keys_size; i++) {
+      if (reinterpret_cast<const lys_node*>(list->keys[i]) == schema)
+        return true;
+    }
+    return false;
+  }
+
+  static std::string get_scalar_value(const json& value) {
+    if (value.is_string()) return value.get<std::string>();
+    if (value.is_boolean()) return value.get<bool>() ? "true" : "false";
+    // leaves of type empty are encoded as [null]
+    if (value.is_null() || value.is_array()) return "";
+    return value.dump();
+  }
+
+  struct ly_ctx* m_ctx;
+  lyd_node* m_first;
+  std::unordered_map<const lys_node*,
+                     std::unordered_map<std::string, const lys_node*>>
+      m_schemas;
+  std::unordered_map<const lyd_node*,
+                     std::unordered_map<std::string, lyd_node*>>
+      m_nodes;
+};
+
+}  // namespace path
+}  // namespace ydk
+
+std::shared_ptr<ydk::path::DataNode> ydk::path::Codec::decode_updates(
+    RootSchemaNode& root_schema, const std::vector<DataUpdate>& updates) {
+  YLOG_DEBUG("ydk::path::Codec: Decoding {} updates", updates.size());
+
+  RootSchemaNodeImpl& rs_impl = get_root_schema_impl(root_schema);
+
+  std::unordered_set<std::string> module_names;
+  for (auto& update : updates) {
+    for (auto& element : update.path) {
+      auto colon = element.name.find(':');
+      if (colon != std::string::npos)
+        module_names.insert(element.name.substr(0, colon));
+    }
+    if (update.json && !update.values.empty())
+      rs_impl.populate_new_schemas_from_payload(update.values[0],
+                                                ydk::EncodingFormat::JSON);
+  }
+  rs_impl.populate_new_schemas(module_names);
+
+  std::shared_ptr<RootDataImpl> rd =
+      std::make_shared<RootDataImpl>(rs_impl, rs_impl.m_ctx, "/");
+  {
+    SchemaReadGuard guard{rs_impl.m_schema_lock};
+    UpdateDecoder decoder{rs_impl};
+    for (auto& update : updates) {
+      try {
+        decoder.apply(update);
+      } catch (std::invalid_argument& e) {
+        YLOG_ERROR("Invalid JSON value in update: {}", e.what());
+        throw(YCodecError{YCodecError::Error::XML_INVAL});
+      }
+    }
+    rd->m_node = decoder.release();
+  }
+
+  for (lyd_node* dnode = rd->m_node; dnode; dnode = dnode->next) {
+    rd->child_map.insert(std::make_pair(
+        dnode, std::make_shared<DataNodeImpl>(rd.get(), dnode, nullptr)));
+  }
+  return rd;
+}
@@ -130,6 +130,14 @@ namespace path {
 /// DataTree's referencing it Thread safety Inspecting YANG meta data Traversing
 /// the hierarchy (iterations and find)
 ///
+/// @section Thread safety
+/// A RootSchemaNode may be shared by several threads. find, create_datanode,
+/// create_rpc and the Codec can be called concurrently, including when they
+/// load new modules on demand; module loading takes the schema exclusively
+/// while everything else proceeds in parallel. Iterating get_children() while
+/// another thread may load new modules is not safe. Individual DataNode trees
+/// are not synchronized and should be used by one thread at a time.
+///
 
 ///
 /// @page howtodata DataNode Tree
@@ -248,7 +256,15 @@ class SchemaNode;
 class RootSchemaNode;
 class RepositoryPtr;
 
-enum class ModelCachingOption { COMMON, PER_DEVICE };
+///
+/// @brief Where downloaded models are cached and how compiled schemas are
+/// reused.
+///
+/// SHARED caches models like COMMON and additionally hands out one compiled
+/// RootSchemaNode to every Repository that creates a root schema from the
+/// same set of capabilities (module, revision, features and deviations).
+///
+enum class ModelCachingOption { COMMON, PER_DEVICE, SHARED };
 
 ///
 /// @brief Validation Service
@@ -272,6 +288,30 @@ class ValidationService {
   void validate(const DataNode& dn, ydk::ValidationService::Option option);
 };
 
+///
+/// @brief Element of a DataUpdate path
+///
+/// The name is qualified with the module name ("module:name") for top-level
+/// nodes and for nodes augmented from another module.
+///
+struct PathElement {
+  std::string name;
+  /// key leaf names and values of a list entry
+  std::vector<std::pair<std::string, std::string>> keys;
+};
+
+///
+/// @brief Value of the data node at a path, as carried by a gNMI update
+///
+struct DataUpdate {
+  /// path from a top-level node down to the updated node
+  std::vector<PathElement> path;
+  /// value of a leaf, or the entries of a leaf-list; when json is set, the
+  /// single RFC 7951 encoded value of the node
+  std::vector<std::string> values;
+  bool json = false;
+};
+
 ///
 /// @brief Codec
 ///
@@ -310,6 +350,22 @@ class Codec {
                                    EncodingFormat format);
   std::shared_ptr<DataNode> decode_json_output(
       RootSchemaNode& root_schema, const std::vector<std::string>& buffer_list);
+
+  ///
+  /// @brief decode path/value updates to return a DataNode
+  ///
+  /// The nodes named by the updates are created directly in the data tree,
+  /// along with their missing ancestors, without going through a text
+  /// document.
+  ///
+  /// @param[in] root_schema The root schema to use.
+  /// @param[in] updates The updates to apply, in order.
+  /// @return The root DataNode holding the top-level nodes created.
+  /// @throws YCoreError if an update does not fit the schema.
+  /// @throws YCodecError if a JSON value is malformed.
+  ///
+  std::shared_ptr<DataNode> decode_updates(
+      RootSchemaNode& root_schema, const std::vector<DataUpdate>& updates);
   std::shared_ptr<DataNode> decode_rpc_output(RootSchemaNode& root_schema,
                                               const std::string& buffer,
                                               const std::string& rpc_path,
@@ -1050,6 +1106,13 @@ class NetconfSession : public Session {
                  const std::string& protocol = "ssh", bool on_demand = true,
                  bool common_cache = false, int timeout = -1);
 
+  // caching_option decides where the downloaded models are kept and whether
+  // the compiled schema is shared with other sessions
+  NetconfSession(const std::string& address, const std::string& username,
+                 const std::string& password, int port,
+                 const std::string& protocol, bool on_demand,
+                 ModelCachingOption caching_option, int timeout = -1);
+
   // constructor(s) for key based authentication
   NetconfSession(Repository& repo, const std::string& address,
                  const std::string& username,
@@ -1063,6 +1126,11 @@ class NetconfSession : public Session {
                  bool on_demand = true, bool common_cache = false,
                  int timeout = -1);
 
+  NetconfSession(const std::string& address, const std::string& username,
+                 const std::string& private_key_path,
+                 const std::string& public_key_path, int port, bool on_demand,
+                 ModelCachingOption caching_option, int timeout = -1);
+
   ~NetconfSession();
 
   RootSchemaNode& get_root_schema() const;
@@ -1107,7 +1175,8 @@ class RestconfSession : public Session {
                   const std::string& username, const std::string& password,
                   int port = 80, EncodingFormat encoding = EncodingFormat::JSON,
                   const std::string& config_url_root = "/data",
-                  const std::string& state_url_root = "/data");
+                  const std::string& state_url_root = "/data",
+                  const TransportOptions& transport_options = {});
 
   RestconfSession(std::shared_ptr<RestconfClient> client,
                   const std::shared_ptr<RootSchemaNode>& root_schema,
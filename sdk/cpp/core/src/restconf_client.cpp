@@ -38,8 +38,12 @@ static bool token_not_found(size_t token);
 
 RestconfClient::RestconfClient(const string &address, const string &username,
                                const string &password, int port,
-                               const string &encoding)
-    : curl(NULL), header_options_list(NULL), encoding(encoding) {
+                               const string &encoding,
+                               const TransportOptions &transport_options)
+    : curl(NULL),
+      header_options_list(NULL),
+      encoding(encoding),
+      transport_options(transport_options) {
   initialize(address, username, password, port);
   YLOG_INFO("Ready to communicate with {} using http", base_url);
 }
@@ -137,6 +141,25 @@ void RestconfClient::initialize_curl(const string &username,
   curl_easy_setopt(curl, CURLOPT_USERPWD, (username + ":" + password).c_str());
   curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, writeFunction);
 
+  // curl decodes the replies it asked to be compressed
+  if (transport_options.compression == Compression::gzip) {
+    curl_easy_setopt(curl, CURLOPT_ACCEPT_ENCODING, "gzip");
+  } else if (transport_options.compression == Compression::deflate) {
+    curl_easy_setopt(curl, CURLOPT_ACCEPT_ENCODING, "deflate");
+  }
+  if (transport_options.max_receive_message_size > 0) {
+    curl_easy_setopt(curl, CURLOPT_MAXFILESIZE_LARGE,
+                     (curl_off_t)transport_options.max_receive_message_size);
+  }
+  if (transport_options.keepalive_time_ms > 0) {
+    // TCP keepalive counts in seconds
+    curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt(curl, CURLOPT_TCP_KEEPIDLE,
+                     max(1L, transport_options.keepalive_time_ms / 1000L));
+    curl_easy_setopt(curl, CURLOPT_TCP_KEEPINTVL,
+                     max(1L, transport_options.keepalive_timeout_ms / 1000L));
+  }
+
   header_options_list = curl_slist_append(
       header_options_list, ("Content-Type: " + encoding).c_str());
   header_options_list =
@@ -19,6 +19,8 @@
 
 #include <string>
 
+#include "types.hpp"
+
 typedef void CURL;
 struct curl_slist;
 
@@ -27,7 +29,8 @@ class RestconfClient {
  public:
   RestconfClient(const std::string &address, const std::string &username,
                  const std::string &password, int port,
-                 const std::string &encoding);
+                 const std::string &encoding,
+                 const TransportOptions &transport_options = {});
   ~RestconfClient();
 
   std::string execute(const std::string &yfilter, const std::string &url,
@@ -46,6 +49,7 @@ class RestconfClient {
   curl_slist *header_options_list;
   std::string base_url;
   std::string encoding;
+  TransportOptions transport_options;
 };
 }  // namespace ydk
 
@@ -43,10 +43,12 @@ namespace ydk {
 RestconfServiceProvider::RestconfServiceProvider(
     path::Repository& repo, const string& address, const string& username,
     const string& password, int port, EncodingFormat encoding,
-    const string& config_url_root, const string& state_url_root)
+    const string& config_url_root, const string& state_url_root,
+    const TransportOptions& transport_options)
     : encoding(encoding),
       session{repo, address,  username,        password,
-              port, encoding, config_url_root, state_url_root} {}
+              port, encoding, config_url_root, state_url_root,
+              transport_options} {}
 
 RestconfServiceProvider::RestconfServiceProvider(
     std::unique_ptr<RestconfClient> client,
@@ -33,7 +33,8 @@ class RestconfServiceProvider : public ServiceProvider {
                           const std::string& password, int port = 80,
                           EncodingFormat encoding = EncodingFormat::JSON,
                           const std::string& config_url_root = "/data",
-                          const std::string& state_url_root = "/data");
+                          const std::string& state_url_root = "/data",
+                          const TransportOptions& transport_options = {});
 
   RestconfServiceProvider(
       std::unique_ptr<RestconfClient> client,
@@ -56,9 +56,11 @@ RestconfSession::RestconfSession(path::Repository& repo, const string& address,
                                  const string& username, const string& password,
                                  int port, EncodingFormat encoding,
                                  const string& config_url_root,
-                                 const string& state_url_root)
+                                 const string& state_url_root,
+                                 const TransportOptions& transport_options)
     : client(make_shared<RestconfClient>(address, username, password, port,
-                                         get_encoding_string(encoding))),
+                                         get_encoding_string(encoding),
+                                         transport_options)),
       encoding(encoding),
       config_url_root(config_url_root),
       state_url_root(state_url_root) {
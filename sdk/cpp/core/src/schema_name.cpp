@@ -0,0 +1,103 @@
+//
+// @file schema_name.cpp
+// @brief Interned names from the schema
+//
+// YANG Development Kit
+// Copyright 2016 Cisco Systems. All rights reserved
+//
+////////////////////////////////////////////////////////////////
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+//////////////////////////////////////////////////////////////////
+
+
+#include <mutex>
+#include <set>
+#include <unordered_set>
+
+#include "types.hpp"
+
+using namespace std;
+
+namespace ydk {
+
+// The tables only grow: the schema has a bounded set of names, and the
+// elements of node based containers keep their addresses. Names are spread
+// over shards by hash, so threads building entities only wait for each
+// other when they intern names of the same shard.
+static const size_t shard_count = 64;
+
+template <typename Table>
+struct InternShard {
+  mutex shard_mutex;
+  Table table;
+};
+
+static size_t get_hash(const vector<string>& names) {
+  size_t seed = names.size();
+  for (auto& name : names)
+    seed ^= hash<string>()(name) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+  return seed;
+}
+
+static const string* intern(const string& name) {
+  static InternShard<unordered_set<string>> shards[shard_count];
+  auto& shard = shards[hash<string>()(name) % shard_count];
+  lock_guard<mutex> guard(shard.shard_mutex);
+  return &*shard.table.insert(name).first;
+}
+
+static const vector<string>* intern(const vector<string>& names) {
+  static InternShard<set<vector<string>>> shards[shard_count];
+  auto& shard = shards[get_hash(names) % shard_count];
+  lock_guard<mutex> guard(shard.shard_mutex);
+  return &*shard.table.insert(names).first;
+}
+
+static const string* get_empty_name() {
+  static const string empty;
+  return &empty;
+}
+
+static const vector<string>* get_empty_name_list() {
+  static const vector<string> empty;
+  return &empty;
+}
+
+SchemaName::SchemaName() : name(get_empty_name()) {}
+
+SchemaName::SchemaName(const char* name)
+    : name(*name ? intern(name) : get_empty_name()) {}
+
+SchemaName::SchemaName(const string& name)
+    : name(name.empty() ? get_empty_name() : intern(name)) {}
+
+ostream& operator<<(ostream& stream, const SchemaName& value) {
+  stream << value.str();
+  return stream;
+}
+
+SchemaNameList::SchemaNameList() : names(get_empty_name_list()) {}
+
+SchemaNameList::SchemaNameList(initializer_list<string> names)
+    : SchemaNameList(vector<string>(names)) {}
+
+SchemaNameList::SchemaNameList(const vector<string>& names)
+    : names(names.empty() ? get_empty_name_list() : intern(names)) {}
+
+}  // namespace ydk
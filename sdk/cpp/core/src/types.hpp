@@ -28,6 +28,8 @@
 #ifndef _TYPES_HPP_
 #define _TYPES_HPP_
 
+#include <atomic>
+#include <boost/iterator/filter_iterator.hpp>
 #include <boost/iterator/transform_iterator.hpp>
 #include <initializer_list>
 #include <iostream>
@@ -64,6 +66,93 @@ typedef struct Empty {
   bool set;
 } Empty;
 
+// Name taken from the schema. Names are interned, so that a node holds a
+// pointer to the one copy shared by every node with the same name.
+class SchemaName {
+ public:
+  SchemaName();
+  SchemaName(const char* name);
+  SchemaName(const std::string& name);
+
+  const std::string& str() const { return *name; }
+  operator const std::string&() const { return *name; }
+  const char* c_str() const { return name->c_str(); }
+  bool empty() const { return name->empty(); }
+  std::size_t size() const { return name->size(); }
+
+  bool operator==(const SchemaName& other) const { return name == other.name; }
+  bool operator!=(const SchemaName& other) const { return name != other.name; }
+
+ private:
+  const std::string* name;
+};
+
+inline bool operator==(const SchemaName& left, const std::string& right) {
+  return left.str() == right;
+}
+inline bool operator==(const std::string& left, const SchemaName& right) {
+  return left == right.str();
+}
+inline bool operator==(const SchemaName& left, const char* right) {
+  return left.str() == right;
+}
+inline bool operator!=(const SchemaName& left, const std::string& right) {
+  return left.str() != right;
+}
+inline bool operator!=(const std::string& left, const SchemaName& right) {
+  return left != right.str();
+}
+inline bool operator!=(const SchemaName& left, const char* right) {
+  return left.str() != right;
+}
+std::ostream& operator<<(std::ostream& stream, const SchemaName& value);
+
+// Interned list of names, such as the keys of a list
+class SchemaNameList {
+ public:
+  SchemaNameList();
+  SchemaNameList(std::initializer_list<std::string> names);
+  SchemaNameList(const std::vector<std::string>& names);
+
+  const std::vector<std::string>& get() const { return *names; }
+  operator const std::vector<std::string>&() const { return *names; }
+  std::vector<std::string>::const_iterator begin() const {
+    return names->begin();
+  }
+  std::vector<std::string>::const_iterator end() const { return names->end(); }
+  bool empty() const { return names->empty(); }
+  std::size_t size() const { return names->size(); }
+
+  bool operator==(const SchemaNameList& other) const {
+    return names == other.names;
+  }
+  bool operator!=(const SchemaNameList& other) const {
+    return names != other.names;
+  }
+
+ private:
+  const std::vector<std::string>* names;
+};
+
+// Schema names of a generated class. Each class builds its table once and
+// its instances and leafs refer to the names in it.
+struct EntityMetadata {
+  EntityMetadata(const SchemaName& yang_name,
+                 const SchemaName& yang_parent_name,
+                 std::initializer_list<SchemaName> leaf_names,
+                 std::initializer_list<SchemaNameList> bit_names = {})
+      : yang_name(yang_name),
+        yang_parent_name(yang_parent_name),
+        leaf_names(leaf_names),
+        bit_names(bit_names) {}
+
+  SchemaName yang_name;
+  SchemaName yang_parent_name;
+  std::vector<SchemaName> leaf_names;
+  // sorted bit names of each bits leaf
+  std::vector<SchemaNameList> bit_names;
+};
+
 class Entity;
 class YLeaf;
 class YLeafList;
@@ -105,11 +194,93 @@ struct EntityPath {
 
 typedef void (*augment_capabilities_function)();
 
+// Memory for the entities of a tree. Entities made in an arena make their
+// children in it too, and the memory is released all at once when the last
+// of them is gone; the memory of entities dropped before that is not reused.
+// The arena must be owned by a shared_ptr. One thread at a time may add
+// entities to it.
+class EntityArena : public std::enable_shared_from_this<EntityArena> {
+ public:
+  explicit EntityArena(std::size_t block_size = 64 * 1024);
+  ~EntityArena();
+
+  EntityArena(const EntityArena&) = delete;
+  EntityArena& operator=(const EntityArena&) = delete;
+
+  void* allocate(std::size_t size, std::size_t alignment);
+  // bytes taken from the heap
+  std::size_t get_size() const;
+
+  // Entities made on this thread while a scope is alive come from its arena,
+  // such as the children made by the constructor of an entity
+  class Scope {
+   public:
+    explicit Scope(EntityArena* arena);
+    ~Scope();
+
+   private:
+    EntityArena* previous;
+  };
+
+  static EntityArena* get_current();
+
+ private:
+  std::size_t block_size;
+  std::vector<std::unique_ptr<char[]>> blocks;
+  char* next;
+  char* end;
+  std::size_t size;
+};
+
+// Allocates from an arena, or from the heap when there is none. The arena is
+// kept alive by the allocations made from it.
+template <typename T>
+class ArenaAllocator {
+ public:
+  typedef T value_type;
+
+  explicit ArenaAllocator(std::shared_ptr<EntityArena> arena = nullptr)
+      : arena(std::move(arena)) {}
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.arena) {}
+
+  T* allocate(std::size_t n) {
+    if (!arena) {
+      return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+    return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T* p, std::size_t) {
+    if (!arena) {
+      ::operator delete(p);
+    }
+  }
+
+  template <typename U>
+  bool operator==(const ArenaAllocator<U>& other) const {
+    return arena == other.arena;
+  }
+  template <typename U>
+  bool operator!=(const ArenaAllocator<U>& other) const {
+    return arena != other.arena;
+  }
+
+  std::shared_ptr<EntityArena> arena;
+};
+
 class YList;
 
 class Entity {
  public:
   Entity();
+  // Copies take the parent, names, filter and list of the entity but none of
+  // its caches. The leafs of a copy do not tell it of changes, so a copy made
+  // does not cache; an entity assigned to keeps its own cache_paths.
+  Entity(const Entity& other);
+  Entity(Entity&& other);
+  Entity& operator=(const Entity& other);
+  Entity& operator=(Entity&& other);
   virtual ~Entity();
 
  public:
@@ -136,6 +307,9 @@ class Entity {
   virtual std::vector<std::string> get_order_of_children() const;
 
   virtual std::shared_ptr<Entity> clone_ptr() const;
+  // A copy of the entity and its descendants, without a parent, made in the
+  // current arena if any; nullptr for classes that do not implement it
+  virtual std::shared_ptr<Entity> deep_clone() const;
 
   virtual void set_parent(Entity* p);
   virtual Entity* get_parent() const;
@@ -159,29 +333,182 @@ class Entity {
 
  public:
   Entity* parent = nullptr;
-  std::string yang_name;
-  std::string yang_parent_name;
+  SchemaName yang_name;
+  SchemaName yang_parent_name;
   YFilter yfilter;
   bool is_presence_container;
   bool is_top_level_class;
   bool has_list_ancestor;
   bool ignore_validation;
-  std::vector<std::string> ylist_key_names;
+  SchemaNameList ylist_key_names;
   std::string ylist_key;
   YList* ylist = nullptr;
+  // arena the entity was made in, if any
+  EntityArena* arena = nullptr;
+  // set by generated classes, whose key leafs have YLeaf::is_key set, whose
+  // leafs and leaf-lists have their owner set, whose children are YChild
+  // members and whose leafs are changed through YLeaf
+  bool cache_paths = false;
 
   std::string get_ylist_key() const;
+
+  // Segment path and absolute path (see absolute_path in entity_util.hpp).
+  // With cache_paths set for the entity and its ancestors they are kept until
+  // a key leaf is set or the entity or one of its ancestors moves.
+  std::string get_cached_segment_path() const;
+  std::string get_cached_absolute_path() const;
+  // drops the paths cached by the entity, and so those of its descendants
+  void invalidate_cached_paths();
+
+  // Hash of the segment path, leafs and children of the entity, the same for
+  // trees that compare equal and 0 for an entity without data. Trees with
+  // the same hash are taken to be equal. With cache_paths set it is kept
+  // until a leaf, leaf-list, list or child of the entity or of one of its
+  // descendants changes. Writes to the yfilter, is_set and value_namespace
+  // members of a leaf are not noticed, as they do not go through YLeaf: call
+  // invalidate_cached_hashes() after them, or use set_filter().
+  uint64 get_tree_hash() const;
+  // drops the hashes cached by the entity and its ancestors
+  void invalidate_cached_hashes();
+
+ private:
+  struct PathCache;
+  struct HashCache;
+  std::shared_ptr<const PathCache> get_path_cache() const;
+
+  mutable std::shared_ptr<const PathCache> path_cache;
+  // bumped when the segment path changes; a cache made before is not used
+  std::atomic<uint64> path_version{0};
+  mutable std::shared_ptr<const HashCache> hash_cache;
+  // bumped when the data of the entity or its descendants changes
+  std::atomic<uint64> hash_version{0};
+};
+
+// Makes an entity in the arena, or on the heap when there is none
+template <typename EntityType>
+std::shared_ptr<EntityType> make_entity(
+    EntityArena* arena = EntityArena::get_current()) {
+  if (arena == nullptr) {
+    return std::make_shared<EntityType>();
+  }
+  EntityArena::Scope scope{arena};
+  auto entity = std::allocate_shared<EntityType>(
+      ArenaAllocator<EntityType>{arena->shared_from_this()});
+  entity->arena = arena;
+  return entity;
+}
+
+// Child entity of a generated class, which tells the entity it is a member
+// of when a child is attached or dropped. An attached child without a parent
+// gets the entity as its parent. The owner is not copied.
+template <typename EntityType>
+class YChild : public std::shared_ptr<EntityType> {
+ public:
+  YChild() = default;
+  explicit YChild(Entity* owner, std::shared_ptr<EntityType> child = nullptr)
+      : std::shared_ptr<EntityType>(std::move(child)), owner(owner) {
+    adopt();
+  }
+  YChild(const YChild& other) : std::shared_ptr<EntityType>(other) {}
+
+  YChild& operator=(const YChild& other) {
+    return operator=(static_cast<const std::shared_ptr<EntityType>&>(other));
+  }
+  template <typename ChildType>
+  YChild& operator=(std::shared_ptr<ChildType> child) {
+    std::shared_ptr<EntityType>::operator=(std::move(child));
+    adopt();
+    changed();
+    return *this;
+  }
+  YChild& operator=(std::nullptr_t) {
+    reset();
+    return *this;
+  }
+
+  void reset() {
+    std::shared_ptr<EntityType>::reset();
+    changed();
+  }
+  template <typename ChildType>
+  void reset(ChildType* child) {
+    std::shared_ptr<EntityType>::reset(child);
+    adopt();
+    changed();
+  }
+
+ private:
+  void adopt() {
+    if (owner && *this && (*this)->parent == nullptr) {
+      (*this)->parent = owner;
+    }
+  }
+  void changed() {
+    if (owner) {
+      owner->invalidate_cached_hashes();
+    }
+  }
+
+  Entity* owner = nullptr;
 };
 
+// Set of bit names. Bits named in the schema table given to the constructor
+// are kept as a bitmask indexed by their position in the table; other names
+// are kept by name.
 class Bits {
  public:
+  // Refers to one bit, as returned by operator[]
+  class Reference {
+   public:
+    Reference& operator=(bool value);
+    Reference& operator=(const Reference& other);
+    operator bool() const;
+
+   private:
+    friend class Bits;
+    Reference(Bits& bits, std::size_t position, bool* value)
+        : bits(bits), position(position), value(value) {}
+
+    Bits& bits;
+    std::size_t position;
+    // set for names outside the schema table
+    bool* value;
+  };
+
   Bits();
+  // names must be sorted
+  explicit Bits(const SchemaNameList& names);
+  Bits(const Bits& other);
+  Bits(Bits&& other);
+  Bits& operator=(const Bits& other);
+  Bits& operator=(Bits&& other);
   virtual ~Bits();
-  bool& operator[](std::string key);
-  const std::map<std::string, bool>& get_bitmap() const;
+
+  // names that were not accessed before are added, cleared. Returns a proxy
+  // rather than bool& since the bits are not stored as bools
+  Reference operator[](const std::string& key);
+  // a copy of the accessed bits by name; changing it leaves the bits as they
+  // are
+  std::map<std::string, bool> get_bitmap() const;
+  // set bits in name order, separated by spaces
+  std::string to_string() const;
+
+  bool operator==(const Bits& other) const;
+  bool operator!=(const Bits& other) const;
 
  private:
-  std::map<std::string, bool> bitmap;
+  friend class Reference;
+  friend class YLeaf;
+  uint64* get_words(std::size_t position);
+  const uint64* get_words(std::size_t position) const;
+  std::size_t get_extra_words_size() const;
+
+  SchemaNameList names;
+  // set and accessed bits of the first 64 names in the table
+  uint64 words[2];
+  // the same, two words for every further 64 names
+  std::unique_ptr<uint64[]> extra_words;
+  std::unique_ptr<std::map<std::string, bool>> other_names;
 };
 
 class Decimal64 {
@@ -192,33 +519,46 @@ class Decimal64 {
   std::string value;
 };
 
+// Names of an identity. A generated identity class resolves its handle once,
+// so that its instances share the interned names.
+struct IdentityHandle {
+  SchemaName name_space;
+  SchemaName namespace_prefix;
+  SchemaName tag;
+};
+
 class Identity {
  public:
   Identity(const std::string& name_space, const std::string& namespace_prefix,
            const std::string& tag)
       : name_space(name_space), namespace_prefix(namespace_prefix), tag(tag) {}
+  explicit Identity(const IdentityHandle& handle)
+      : name_space(handle.name_space),
+        namespace_prefix(handle.namespace_prefix),
+        tag(handle.tag) {}
 
   virtual ~Identity() {}
 
-  std::string to_string() { return tag; }
+  std::string to_string() const { return tag; }
 
  public:
-  std::string name_space;
-  std::string namespace_prefix;
+  SchemaName name_space;
+  SchemaName namespace_prefix;
 
  private:
-  std::string tag;
+  friend class YLeaf;
+  SchemaName tag;
 };
 
 class Enum {
  public:
   class YLeaf {
    public:
-    YLeaf(int value, const std::string& name) : value(value), name(name) {}
+    YLeaf(int value, const SchemaName& name) : value(value), name(name) {}
     ~YLeaf() {}
 
     int value;
-    std::string name;
+    SchemaName name;
   };
 
   Enum() {}
@@ -245,7 +585,9 @@ enum class YType {
 
 class YLeaf {
  public:
-  YLeaf(YType type, std::string name);
+  YLeaf(YType type, const SchemaName& name);
+  // leaf of type bits, with the sorted bit names of its schema
+  YLeaf(YType type, const SchemaName& name, const SchemaNameList& bit_names);
   ~YLeaf();
 
   YLeaf(const YLeaf& val);
@@ -254,6 +596,9 @@ class YLeaf {
   YLeaf& operator=(const YLeaf& val) = delete;
   YLeaf& operator=(YLeaf&& val) = delete;
 
+  // takes the value, filter and namespaces of a leaf of the same schema node
+  void assign(const YLeaf& other);
+
   const std::string get() const;
   std::pair<std::string, LeafData> get_name_leafdata() const;
 
@@ -291,28 +636,71 @@ class YLeaf {
   bool operator==(YLeaf& other) const;
   bool operator==(const YLeaf& other) const;
 
-  bool& operator[](std::string key);
+  Bits::Reference operator[](const std::string& key);
 
  public:
   bool is_set;
+  // key of a list entry; setting it changes the paths of the owner
+  bool is_key;
+  // entity the leaf is a member of, if it is told about changes; not copied
+  Entity* owner;
   YFilter yfilter;
-  std::string value_namespace;
-  std::string value_namespace_prefix;
+  SchemaName value_namespace;
+  SchemaName value_namespace_prefix;
 
  public:
   void store_value(std::string&& val);
   std::string get_bits_string() const;
 
-  std::string name;
-  std::string value;
+  SchemaName name;
   int enum_value;
   YType type;
-  Bits bits_value;
+  // allocated for leafs of type bits only
+  std::unique_ptr<Bits> bits_value;
+
+ private:
+  // Values are kept in their native form and only formatted by get()
+  enum class Storage : char {
+    text,
+    signed_integer,
+    unsigned_integer,
+    boolean,
+    enumeration,
+    identity,
+    decimal64,
+    real,
+    bits
+  };
+
+  void mark_set();
+  void copy_value(const YLeaf& other);
+  void set_text(std::string&& text);
+  void set_signed(int64 val);
+  void set_unsigned(uint64 val);
+  void set_decimal64(std::string&& val);
+
+  Storage storage;
+  union {
+    std::string text;
+    int64 signed_integer;
+    uint64 unsigned_integer;
+    bool boolean;
+    const std::string* enumeration;
+    const std::string* identity;
+    // value times 10 to the power of fraction_digits
+    struct {
+      int64 scaled;
+      int fraction_digits;
+    } decimal64;
+    double real;
+    // the value itself is in bits_value
+    SchemaNameList bit_names;
+  };
 };
 
 class YLeafList {
  public:
-  YLeafList(YType type, const std::string& name);
+  YLeafList(YType type, const SchemaName& name);
   virtual ~YLeafList();
 
   YLeafList(const YLeafList& val);
@@ -349,16 +737,29 @@ class YLeafList {
 
  public:
   YFilter yfilter;
+  // entity the leaf-list is a member of, if it is told about changes; not
+  // copied
+  Entity* owner;
 
  public:
   std::vector<YLeaf> values;
   YType type;
-  std::string name;
+  SchemaName name;
+
+ private:
+  void add(const YLeaf& value);
+  void set_owners();
 };
 
+// Entities of a list in insertion order, found by key or by position.
+// Popping leaves a hole, which access by position skips; pop closes the holes
+// all at once when they grow many. Const members do not change the list, so
+// it may be read by several threads at a time.
 class YList {
  public:
   YList(Entity* parent_entity, std::initializer_list<std::string> key_names);
+  YList(const YList& other);
+  YList& operator=(const YList& other);
   virtual ~YList();
 
   std::shared_ptr<Entity> operator[](const std::string& key) const;
@@ -378,12 +779,36 @@ class YList {
   std::vector<std::string> ylist_key_names;
 
  protected:
-  typedef std::map<std::string, std::shared_ptr<Entity>> MapType;
+  struct Entry {
+    std::string key;
+    std::size_t hash;
+    // null for a popped entry
+    std::shared_ptr<Entity> entity;
+  };
+  typedef std::vector<Entry, ArenaAllocator<Entry>> EntryList;
 
-  MapType entity_map;
-  std::vector<std::string> key_vector;
+  EntryList entries;
+  // popped entries at the start of entries
+  std::size_t front;
   Entity* parent;
   int counter;
+
+ private:
+  std::string build_key(const Entity& entity, std::size_t& hash);
+  std::size_t find(const std::string& key, std::size_t hash) const;
+  std::size_t find(const std::vector<std::string>& key_values,
+                   std::size_t hash) const;
+  std::size_t get_position(std::size_t item) const;
+  void insert_slot(std::size_t position);
+  void erase_slot(std::size_t slot);
+  void rebuild_slots();
+  void erase(std::size_t slot);
+  void compact_entries();
+
+  // open addressing table of entry positions plus one, 0 for a free slot
+  std::vector<std::size_t, ArenaAllocator<std::size_t>> slots;
+  // sorted positions of the popped entries after front
+  std::vector<std::size_t> holes;
 };
 
 std::ostream& operator<<(std::ostream& stream, const YLeaf& value);
@@ -400,32 +825,63 @@ class YListWrapper : public YList {
 
   struct Func {
     std::pair<const std::string&, std::shared_ptr<EntityType>> operator()(
-        const MapType::const_iterator::value_type& value) const {
-      return {value.first, std::static_pointer_cast<EntityType>(value.second)};
+        const Entry& entry) const {
+      return {entry.key, std::static_pointer_cast<EntityType>(entry.entity)};
+    }
+  };
+
+  // skips popped entries
+  struct IsLive {
+    bool operator()(const Entry& entry) const {
+      return entry.entity != nullptr;
     }
   };
 
-  typedef typename boost::result_of<Func(
-      const MapType::const_iterator::value_type& value)>::type t;
+  typedef typename boost::result_of<Func(const Entry& entry)>::type t;
 
   std::shared_ptr<EntityType> operator[](const std::string& key) const {
     return std::static_pointer_cast<EntityType>(ydk::YList::operator[](key));
   }
 
-  typedef boost::transform_iterator<Func, MapType::const_iterator>
+  typedef boost::transform_iterator<
+      Func,
+      boost::filter_iterator<IsLive, typename EntryList::const_iterator>>
       MapWrapperIterator;
 
   MapWrapperIterator begin() const {
-    return boost::make_transform_iterator(entity_map.cbegin(), Func());
+    return boost::make_transform_iterator(
+        boost::make_filter_iterator<IsLive>(entries.cbegin() + front,
+                                            entries.cend()),
+        Func());
   }
 
   MapWrapperIterator end() const {
-    return boost::make_transform_iterator(entity_map.cend(), Func());
+    return boost::make_transform_iterator(
+        boost::make_filter_iterator<IsLive>(entries.cend(), entries.cend()),
+        Func());
   }
 };
 
 enum class EncodingFormat { XML, JSON };
 
+enum class Compression { none, gzip, deflate };
+
+// Transport settings of a service provider; the defaults keep those of the
+// transport
+struct TransportOptions {
+  // Compression of gRPC requests and of HTTP replies; gRPC targets compress
+  // their replies as they see fit
+  Compression compression = Compression::none;
+  // Largest reply accepted, in bytes; 0 keeps the transport default and -1
+  // removes the limit
+  int max_receive_message_size = 0;
+  // Interval between keepalive probes of an idle connection, in
+  // milliseconds; 0 disables them
+  int keepalive_time_ms = 0;
+  // Time without an acknowledgement after which the connection is closed
+  int keepalive_timeout_ms = 20000;
+};
+
 std::string to_string(YFilter yfilter);
 
 enum class Protocol { restconf, netconf };
@@ -25,6 +25,9 @@
 //
 //////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
 #include <iostream>
 #include <sstream>
 
@@ -61,116 +64,393 @@ std::string to_str(YType t) {
 #undef TOSTRING
 }
 
-YLeaf::YLeaf(YType type, std::string name)
+static std::string format_integer(uint64 magnitude, bool negative) {
+  char buffer[21];
+  char* end = buffer + sizeof(buffer);
+  char* begin = end;
+  do {
+    *--begin = static_cast<char>('0' + magnitude % 10);
+    magnitude /= 10;
+  } while (magnitude != 0);
+  if (negative) {
+    *--begin = '-';
+  }
+  return std::string(begin, end);
+}
+
+static uint64 get_magnitude(int64 val) {
+  return val < 0 ? 0 - static_cast<uint64>(val) : static_cast<uint64>(val);
+}
+
+static std::string format_decimal64(int64 scaled, int fraction_digits) {
+  auto text = format_integer(get_magnitude(scaled), false);
+  if (fraction_digits > 0) {
+    std::size_t digits = fraction_digits;
+    if (text.size() <= digits) {
+      text.insert(0, digits + 1 - text.size(), '0');
+    }
+    text.insert(text.size() - digits, 1, '.');
+  }
+  if (scaled < 0) {
+    text.insert(0, 1, '-');
+  }
+  return text;
+}
+
+// Same text as the default formatting of a stream
+static std::string format_real(double val) {
+  char buffer[32];
+  auto length = snprintf(buffer, sizeof(buffer), "%g", val);
+  return std::string(buffer, length);
+}
+
+// Only canonical text is parsed, so that formatting the value gives back the
+// same text: no sign, no leading zeros
+static bool parse_unsigned(const char* begin, const char* end, uint64& val) {
+  if (begin == end || (*begin == '0' && end - begin > 1)) {
+    return false;
+  }
+  val = 0;
+  for (auto c = begin; c != end; ++c) {
+    if (*c < '0' || *c > '9') {
+      return false;
+    }
+    uint64 digit = *c - '0';
+    if (val > (UINT64_MAX - digit) / 10) {
+      return false;
+    }
+    val = val * 10 + digit;
+  }
+  return true;
+}
+
+static bool parse_signed(const std::string& text, int64& val) {
+  bool negative = !text.empty() && text[0] == '-';
+  uint64 magnitude;
+  if (!parse_unsigned(text.data() + negative, text.data() + text.size(),
+                      magnitude)) {
+    return false;
+  }
+  if (negative) {
+    if (magnitude == 0 || magnitude > static_cast<uint64>(INT64_MAX)) {
+      return false;
+    }
+    val = -static_cast<int64>(magnitude);
+  } else {
+    if (magnitude > static_cast<uint64>(INT64_MAX)) {
+      return false;
+    }
+    val = static_cast<int64>(magnitude);
+  }
+  return true;
+}
+
+static bool parse_decimal64(const std::string& text, int64& scaled,
+                            int& fraction_digits) {
+  const char* begin = text.data();
+  const char* end = begin + text.size();
+  bool negative = begin != end && *begin == '-';
+  begin += negative;
+  const char* point = std::find(begin, end, '.');
+  uint64 magnitude;
+  if (!parse_unsigned(begin, point, magnitude) ||
+      magnitude > static_cast<uint64>(INT64_MAX)) {
+    return false;
+  }
+  fraction_digits = 0;
+  if (point != end) {
+    if (point + 1 == end || end - point - 1 > 18) {
+      return false;
+    }
+    for (auto c = point + 1; c != end; ++c) {
+      uint64 digit = *c - '0';
+      if (*c < '0' || *c > '9' ||
+          magnitude > (static_cast<uint64>(INT64_MAX) - digit) / 10) {
+        return false;
+      }
+      magnitude = magnitude * 10 + digit;
+      fraction_digits++;
+    }
+  }
+  if (negative && magnitude == 0) {
+    return false;
+  }
+  scaled = negative ? -static_cast<int64>(magnitude)
+                    : static_cast<int64>(magnitude);
+  return true;
+}
+
+// Drops trailing zero fraction digits, so that the same value written with
+// different precision compares equal
+static void normalize_decimal64(int64& scaled, int& fraction_digits) {
+  while (fraction_digits > 0 && scaled % 10 == 0) {
+    scaled /= 10;
+    fraction_digits--;
+  }
+}
+
+static bool is_signed_type(YType type) {
+  return type == YType::int8 || type == YType::int16 || type == YType::int32 ||
+         type == YType::int64;
+}
+
+static bool is_unsigned_type(YType type) {
+  return type == YType::uint8 || type == YType::uint16 ||
+         type == YType::uint32 || type == YType::uint64;
+}
+
+YLeaf::YLeaf(YType type, const SchemaName& name)
     : is_set(false),
+      is_key(false),
+      owner(nullptr),
       yfilter(YFilter::not_set),
       name(name),
-      value(""),
       enum_value(0),
-      type(type) {}
+      type(type),
+      storage(Storage::text),
+      text() {}
+
+YLeaf::YLeaf(YType type, const SchemaName& name,
+             const SchemaNameList& bit_names)
+    : is_set(false),
+      is_key(false),
+      owner(nullptr),
+      yfilter(YFilter::not_set),
+      name(name),
+      enum_value(0),
+      type(type),
+      storage(Storage::bits),
+      bit_names(bit_names) {}
 
 YLeaf::YLeaf(const YLeaf& val)
     : is_set{val.is_set},
+      is_key{val.is_key},
+      owner(nullptr),
       yfilter(YFilter::not_set),
+      value_namespace{val.value_namespace},
+      value_namespace_prefix{val.value_namespace_prefix},
       name{val.name},
-      value{val.value},
       enum_value{val.enum_value},
       type{val.type},
-      bits_value{val.bits_value} {}
+      bits_value{val.bits_value ? std::make_unique<Bits>(*val.bits_value)
+                                : nullptr},
+      storage(Storage::text),
+      text() {
+  copy_value(val);
+}
 
 YLeaf::YLeaf(YLeaf&& val)
     : is_set{val.is_set},
+      is_key{val.is_key},
+      owner(nullptr),
       yfilter(YFilter::not_set),
-      name{std::move(val.name)},
-      value{std::move(val.value)},
-      enum_value{std::move(val.enum_value)},
+      value_namespace{val.value_namespace},
+      value_namespace_prefix{val.value_namespace_prefix},
+      name{val.name},
+      enum_value{val.enum_value},
       type{val.type},
-      bits_value{val.bits_value} {}
+      bits_value{std::move(val.bits_value)},
+      storage(Storage::text),
+      text() {
+  if (val.storage == Storage::text) {
+    text = std::move(val.text);
+  } else {
+    copy_value(val);
+  }
+}
 
-YLeaf::~YLeaf() {}
+YLeaf::~YLeaf() {
+  if (storage == Storage::text) {
+    text.~basic_string();
+  }
+}
 
-const std::string YLeaf::get() const {
-  if (type == YType::bits) {
-    return get_bits_string();
+void YLeaf::assign(const YLeaf& other) {
+  if (owner) {
+    if (is_key) {
+      owner->invalidate_cached_paths();
+    }
+    owner->invalidate_cached_hashes();
   }
-  return value;
+  is_set = other.is_set;
+  yfilter = other.yfilter;
+  value_namespace = other.value_namespace;
+  value_namespace_prefix = other.value_namespace_prefix;
+  enum_value = other.enum_value;
+  bits_value =
+      other.bits_value ? std::make_unique<Bits>(*other.bits_value) : nullptr;
+  copy_value(other);
 }
 
-std::pair<std::string, LeafData> YLeaf::get_name_leafdata() const {
-  return {name,
-          {get(), yfilter, is_set, value_namespace, value_namespace_prefix}};
+void YLeaf::mark_set() {
+  is_set = true;
+  if (owner) {
+    if (is_key) {
+      owner->invalidate_cached_paths();
+    }
+    owner->invalidate_cached_hashes();
+  }
 }
 
-void YLeaf::operator=(uint8 val) {
-  std::ostringstream value_buffer;
+void YLeaf::copy_value(const YLeaf& other) {
+  if (other.storage == Storage::text) {
+    set_text(std::string(other.text));
+    return;
+  }
+  if (storage == Storage::text) {
+    text.~basic_string();
+  }
+  storage = other.storage;
+  switch (storage) {
+    case Storage::signed_integer:
+      signed_integer = other.signed_integer;
+      break;
+    case Storage::unsigned_integer:
+      unsigned_integer = other.unsigned_integer;
+      break;
+    case Storage::boolean:
+      boolean = other.boolean;
+      break;
+    case Storage::enumeration:
+      enumeration = other.enumeration;
+      break;
+    case Storage::identity:
+      identity = other.identity;
+      break;
+    case Storage::decimal64:
+      decimal64 = other.decimal64;
+      break;
+    case Storage::real:
+      real = other.real;
+      break;
+    case Storage::bits:
+      new (&bit_names) SchemaNameList(other.bit_names);
+      break;
+    case Storage::text:
+      break;
+  }
+}
 
-  value_buffer << val;
-  store_value(value_buffer.str());
+void YLeaf::set_text(std::string&& val) {
+  if (storage == Storage::text) {
+    text = std::move(val);
+  } else {
+    new (&text) std::string(std::move(val));
+    storage = Storage::text;
+  }
 }
 
-void YLeaf::operator=(uint32 val) {
-  std::ostringstream value_buffer;
+void YLeaf::set_signed(int64 val) {
+  mark_set();
+  if (type == YType::boolean) {
+    store_value(format_integer(get_magnitude(val), val < 0));
+    return;
+  }
+  if (storage == Storage::text) {
+    text.~basic_string();
+  }
+  storage = Storage::signed_integer;
+  signed_integer = val;
+}
 
-  value_buffer << val;
-  store_value(value_buffer.str());
+void YLeaf::set_unsigned(uint64 val) {
+  mark_set();
+  if (type == YType::boolean) {
+    store_value(format_integer(val, false));
+    return;
+  }
+  if (storage == Storage::text) {
+    text.~basic_string();
+  }
+  storage = Storage::unsigned_integer;
+  unsigned_integer = val;
 }
 
-void YLeaf::operator=(uint64 val) {
-  std::ostringstream value_buffer;
+const std::string YLeaf::get() const {
+  if (type == YType::bits) {
+    return get_bits_string();
+  }
+  switch (storage) {
+    case Storage::signed_integer:
+      return format_integer(get_magnitude(signed_integer),
+                            signed_integer < 0);
+    case Storage::unsigned_integer:
+      return format_integer(unsigned_integer, false);
+    case Storage::boolean:
+      return boolean ? "true" : "false";
+    case Storage::enumeration:
+      return *enumeration;
+    case Storage::identity:
+      return *identity;
+    case Storage::decimal64:
+      return format_decimal64(decimal64.scaled, decimal64.fraction_digits);
+    case Storage::real:
+      return format_real(real);
+    case Storage::bits:
+      return get_bits_string();
+    case Storage::text:
+      break;
+  }
+  return text;
+}
 
-  value_buffer << val;
-  store_value(value_buffer.str());
+std::pair<std::string, LeafData> YLeaf::get_name_leafdata() const {
+  return {name,
+          {get(), yfilter, is_set, value_namespace, value_namespace_prefix}};
 }
 
-void YLeaf::operator=(long val) {
-  std::ostringstream value_buffer;
+void YLeaf::operator=(uint8 val) { set_unsigned(val); }
 
-  value_buffer << val;
-  store_value(value_buffer.str());
-}
+void YLeaf::operator=(uint32 val) { set_unsigned(val); }
 
-void YLeaf::operator=(int8 val) {
-  std::ostringstream value_buffer;
+void YLeaf::operator=(uint64 val) { set_unsigned(val); }
 
-  value_buffer << val;
-  store_value(value_buffer.str());
-}
+void YLeaf::operator=(long val) { set_signed(val); }
 
-void YLeaf::operator=(int32 val) {
-  std::ostringstream value_buffer;
+void YLeaf::operator=(int8 val) { set_signed(val); }
 
-  value_buffer << val;
-  store_value(value_buffer.str());
-}
+void YLeaf::operator=(int32 val) { set_signed(val); }
 
-void YLeaf::operator=(Enum::YLeaf val) {
-  std::ostringstream value_buffer;
+void YLeaf::operator=(int64 val) { set_signed(val); }
 
-  value_buffer << val.name;
-  store_value(value_buffer.str());
+void YLeaf::operator=(Enum::YLeaf val) {
+  mark_set();
+  if (storage == Storage::text) {
+    text.~basic_string();
+  }
+  storage = Storage::enumeration;
+  enumeration = &val.name.str();
   enum_value = val.value;
 }
 
 void YLeaf::operator=(Bits val) {
-  std::ostringstream value_buffer;
-
-  bits_value = val;
-  value_buffer << get_bits_string();
-  store_value(value_buffer.str());
-}
-
-void YLeaf::operator=(int64 val) {
-  std::ostringstream value_buffer;
-
-  value_buffer << val;
-  store_value(value_buffer.str());
+  if (type != YType::bits) {
+    store_value(val.to_string());
+    return;
+  }
+  mark_set();
+  if (storage != Storage::bits || val.names == bit_names) {
+    bits_value = std::make_unique<Bits>(std::move(val));
+    return;
+  }
+  // move the bits over to the table of the schema
+  bits_value = std::make_unique<Bits>(bit_names);
+  for (auto const& entry : val.get_bitmap()) {
+    (*bits_value)[entry.first] = entry.second;
+  }
 }
 
 void YLeaf::operator=(double val) {
-  std::ostringstream value_buffer;
-
-  value_buffer << val;
-  store_value(value_buffer.str());
+  mark_set();
+  if (type == YType::boolean) {
+    store_value(format_real(val));
+    return;
+  }
+  if (storage == Storage::text) {
+    text.~basic_string();
+  }
+  storage = Storage::real;
+  real = val;
 }
 
 void YLeaf::operator=(Empty val) {
@@ -182,26 +462,48 @@ void YLeaf::operator=(Empty val) {
 }
 
 void YLeaf::operator=(Identity val) {
-  std::ostringstream value_buffer;
-
-  value_buffer << val.to_string();
-  store_value(value_buffer.str());
+  mark_set();
+  if (storage == Storage::text) {
+    text.~basic_string();
+  }
+  storage = Storage::identity;
+  identity = &val.tag.str();
   value_namespace = val.name_space;
   value_namespace_prefix = val.namespace_prefix;
 }
 
 void YLeaf::operator=(std::string val) {
-  std::ostringstream value_buffer;
-
-  value_buffer << val;
-  store_value(value_buffer.str());
+  int64 signed_value;
+  uint64 unsigned_value;
+  if (is_signed_type(type) && parse_signed(val, signed_value)) {
+    set_signed(signed_value);
+  } else if (is_unsigned_type(type) &&
+             parse_unsigned(val.data(), val.data() + val.size(),
+                            unsigned_value)) {
+    set_unsigned(unsigned_value);
+  } else if (type == YType::decimal64) {
+    set_decimal64(std::move(val));
+  } else {
+    store_value(std::move(val));
+  }
 }
 
-void YLeaf::operator=(Decimal64 val) {
-  std::ostringstream value_buffer;
+void YLeaf::operator=(Decimal64 val) { set_decimal64(std::move(val.value)); }
 
-  value_buffer << val.value;
-  store_value(value_buffer.str());
+void YLeaf::set_decimal64(std::string&& val) {
+  int64 scaled;
+  int fraction_digits;
+  if (!parse_decimal64(val, scaled, fraction_digits)) {
+    store_value(std::move(val));
+    return;
+  }
+  mark_set();
+  if (storage == Storage::text) {
+    text.~basic_string();
+  }
+  storage = Storage::decimal64;
+  decimal64.scaled = scaled;
+  decimal64.fraction_digits = fraction_digits;
 }
 
 void YLeaf::set(uint8 val) { YLeaf::operator=(val); }
@@ -233,38 +535,75 @@ void YLeaf::set(std::string val) { YLeaf::operator=(val); }
 void YLeaf::set(Decimal64 val) { YLeaf::operator=(val); }
 
 void YLeaf::store_value(std::string&& val) {
-  is_set = true;
+  mark_set();
   if (type == YType::boolean) {
-    value = get_bool_string(val);
-  } else {
-    value = val;
+    val = get_bool_string(val);
+    if (val == "true" || val == "false") {
+      if (storage == Storage::text) {
+        text.~basic_string();
+      }
+      storage = Storage::boolean;
+      boolean = val == "true";
+      return;
+    }
   }
+  set_text(std::move(val));
 }
 
 YLeaf::operator std::string() const { return get(); }
 
-bool YLeaf::operator==(YLeaf& other) const { return get() == other.get(); }
+bool YLeaf::operator==(YLeaf& other) const {
+  return operator==(static_cast<const YLeaf&>(other));
+}
 
 bool YLeaf::operator==(const YLeaf& other) const {
+  if (storage == other.storage && type != YType::bits &&
+      other.type != YType::bits) {
+    switch (storage) {
+      case Storage::signed_integer:
+        return signed_integer == other.signed_integer;
+      case Storage::unsigned_integer:
+        return unsigned_integer == other.unsigned_integer;
+      case Storage::boolean:
+        return boolean == other.boolean;
+      case Storage::enumeration:
+        return enumeration == other.enumeration;
+      case Storage::identity:
+        return identity == other.identity;
+      case Storage::decimal64: {
+        auto scaled = decimal64.scaled;
+        auto fraction_digits = decimal64.fraction_digits;
+        normalize_decimal64(scaled, fraction_digits);
+        auto other_scaled = other.decimal64.scaled;
+        auto other_fraction_digits = other.decimal64.fraction_digits;
+        normalize_decimal64(other_scaled, other_fraction_digits);
+        return scaled == other_scaled &&
+               fraction_digits == other_fraction_digits;
+      }
+      case Storage::text:
+        return text == other.text;
+      case Storage::real:
+      case Storage::bits:
+        break;
+    }
+  }
   return get() == other.get();
 }
 
-bool& YLeaf::operator[](std::string key) {
-  is_set = true;
-  return bits_value[key];
+Bits::Reference YLeaf::operator[](const std::string& key) {
+  mark_set();
+  if (!bits_value) {
+    bits_value = std::make_unique<Bits>(
+        storage == Storage::bits ? bit_names : SchemaNameList{});
+  }
+  return (*bits_value)[key];
 }
 
 std::string YLeaf::get_bits_string() const {
-  std::string value;
-  for (auto const& entry : bits_value.get_bitmap()) {
-    if (entry.second) {
-      value += entry.first + " ";
-    }
+  if (!bits_value) {
+    return "";
   }
-
-  value = value.substr(0, value.size() - 1);
-
-  return (value);
+  return bits_value->to_string();
 }
 
 std::ostream& operator<<(std::ostream& stream, const YLeaf& value) {
@@ -25,6 +25,7 @@
 //
 //////////////////////////////////////////////////////////////////
 
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 
@@ -60,17 +61,19 @@ string to_string(YType t) {
   return "";
 }
 
-YLeafList::YLeafList(YType type, const std::string& name)
-    : yfilter(YFilter::not_set), type(type), name(name) {}
+YLeafList::YLeafList(YType type, const SchemaName& name)
+    : yfilter(YFilter::not_set), owner(nullptr), type(type), name(name) {}
 
 YLeafList::YLeafList(const YLeafList& other)
     : yfilter(YFilter::not_set),
+      owner(nullptr),
       values(other.getYLeafs()),
       type(other.type),
       name(other.name) {}
 
 YLeafList::YLeafList(YLeafList&& other)
     : yfilter(YFilter::not_set),
+      owner(nullptr),
       values(other.getYLeafs()),
       type(other.type),
       name(other.name) {}
@@ -80,6 +83,7 @@ ydk::YLeafList& YLeafList::operator=(const YLeafList& other) {
   name = other.name;
   values = other.getYLeafs();
   yfilter = other.yfilter;
+  set_owners();
   return *this;
 }
 
@@ -88,6 +92,7 @@ ydk::YLeafList& YLeafList::operator=(YLeafList&& other) {
   name = other.name;
   values = other.getYLeafs();
   yfilter = other.yfilter;
+  set_owners();
   return *this;
 }
 
@@ -97,98 +102,121 @@ void YLeafList::append(uint8 val) {
   YLeaf value{type, name};
   value = val;
 
-  values.push_back(value);
+  add(value);
 }
 
 void YLeafList::append(uint32 val) {
   YLeaf value{type, name};
   value = val;
 
-  values.push_back(value);
+  add(value);
 }
 
 void YLeafList::append(uint64 val) {
   YLeaf value{type, name};
   value = val;
 
-  values.push_back(value);
+  add(value);
 }
 
 void YLeafList::append(long val) {
   YLeaf value{type, name};
   value = val;
 
-  values.push_back(value);
+  add(value);
 }
 
 void YLeafList::append(double val) {
   YLeaf value{type, name};
   value = val;
 
-  values.push_back(value);
+  add(value);
 }
 
 void YLeafList::append(int8 val) {
   YLeaf value{type, name};
   value = val;
 
-  values.push_back(value);
+  add(value);
 }
 
 void YLeafList::append(int32 val) {
   YLeaf value{type, name};
   value = val;
 
-  values.push_back(value);
+  add(value);
 }
 
 void YLeafList::append(Enum::YLeaf val) {
   YLeaf value{type, name};
   value = val;
 
-  values.push_back(value);
+  add(value);
 }
 
 void YLeafList::append(int64 val) {
   YLeaf value{type, name};
   value = val;
 
-  values.push_back(value);
+  add(value);
 }
 
 void YLeafList::append(Empty val) {
   YLeaf value{type, name};
   value = val;
 
-  values.push_back(value);
+  add(value);
 }
 
 void YLeafList::append(Identity val) {
   YLeaf value{type, name};
   value = val;
 
-  values.push_back(value);
+  add(value);
 }
 
 void YLeafList::append(Bits val) {
   YLeaf value{type, name};
   value = val;
 
-  values.push_back(value);
+  add(value);
 }
 
 void YLeafList::append(string val) {
   YLeaf value{type, name};
   value = val;
 
-  values.push_back(value);
+  add(value);
 }
 
 void YLeafList::append(Decimal64 val) {
   YLeaf value{type, name};
   value = val.value;
 
+  add(value);
+}
+
+void YLeafList::add(const YLeaf& value) {
+  auto data = values.data();
   values.push_back(value);
+  // the owner is not copied with the values that were moved
+  if (values.data() != data) {
+    set_owners();
+    return;
+  }
+  values.back().owner = owner;
+  if (owner) {
+    owner->invalidate_cached_hashes();
+  }
+}
+
+void YLeafList::set_owners() {
+  for (auto& value : values) {
+    value.owner = owner;
+  }
+  if (owner) {
+    owner->invalidate_cached_hashes();
+  }
 }
 
 bool YLeafList::operator==(YLeafList& other) const {
@@ -210,7 +238,12 @@ YLeaf& YLeafList::operator[](size_t key) {
 
 vector<YLeaf> YLeafList::getYLeafs() const { return values; }
 
-void YLeafList::clear() { values.clear(); }
+void YLeafList::clear() {
+  values.clear();
+  if (owner) {
+    owner->invalidate_cached_hashes();
+  }
+}
 
 std::vector<std::pair<std::string, LeafData>> YLeafList::get_name_leafdata()
     const {
@@ -226,68 +259,345 @@ std::vector<std::pair<std::string, LeafData>> YLeafList::get_name_leafdata()
 
 using namespace std;
 
-YList::YList(Entity* parent_entity, initializer_list<string> key_names)
-    : parent(parent_entity), counter(1000000) {
-  ylist_key_names = vector<string>{};
-  entity_map = map<string, shared_ptr<Entity>>{};
-  key_vector = vector<string>{};
+static const size_t npos = static_cast<size_t>(-1);
+
+// FNV-1a, so that a key is hashed while it is built
+static const size_t hash_offset = static_cast<size_t>(14695981039346656037ULL);
+static const size_t hash_prime = static_cast<size_t>(1099511628211ULL);
 
-  for (auto key : key_names) {
-    ylist_key_names.push_back(key);
+static void hash_append(size_t& hash, const string& text) {
+  for (auto c : text) {
+    hash = (hash ^ static_cast<unsigned char>(c)) * hash_prime;
   }
 }
 
-YList::~YList() {}
+static size_t hash_key(const string& key) {
+  size_t hash = hash_offset;
+  hash_append(hash, key);
+  return hash;
+}
 
-string YList::build_key(shared_ptr<Entity> ep) {
-  ostringstream value_buffer;
-  string key;
-  vector<pair<string, LeafData>> name_leaf_data_vector =
-      ep->get_name_leaf_data();
-  for (auto ylist_key : ylist_key_names) {
-    for (auto name_leaf_data : name_leaf_data_vector) {
-      if (ylist_key == name_leaf_data.first) {
-        key = value_buffer.str();
-        if (key.length() > 0) {
-          value_buffer << ",";
-        }
-        value_buffer << name_leaf_data.second.value;
+// The values of the key leafs of an entity in key order, so that its key is
+// hashed and compared without joining them
+static vector<string> get_key_values(const Entity& entity,
+                                     const vector<string>& key_names) {
+  vector<string> values;
+  if (key_names.empty()) {
+    return values;
+  }
+  auto name_leaf_data_vector = entity.get_name_leaf_data();
+  for (auto const& key_name : key_names) {
+    for (auto& name_leaf_data : name_leaf_data_vector) {
+      if (key_name == name_leaf_data.first) {
+        values.push_back(move(name_leaf_data.second.value));
         break;
       }
     }
   }
-  key = value_buffer.str();
-  if (key.length() == 0) {
+  return values;
+}
+
+// Values are separated by commas once the key is not empty
+static size_t hash_key_values(const vector<string>& values) {
+  size_t hash = hash_offset;
+  bool empty = true;
+  for (auto const& value : values) {
+    if (!empty) {
+      hash_append(hash, ",");
+    }
+    hash_append(hash, value);
+    empty = empty && value.empty();
+  }
+  return hash;
+}
+
+static bool key_equals(const string& key, const vector<string>& values) {
+  size_t position = 0;
+  bool empty = true;
+  for (auto const& value : values) {
+    if (!empty) {
+      if (position == key.size() || key[position] != ',') {
+        return false;
+      }
+      position++;
+    }
+    if (key.compare(position, value.size(), value) != 0) {
+      return false;
+    }
+    position += value.size();
+    empty = empty && value.empty();
+  }
+  return position == key.size();
+}
+
+static string join_key_values(const vector<string>& values) {
+  string key;
+  for (auto const& value : values) {
+    if (!key.empty()) {
+      key += ',';
+    }
+    key += value;
+  }
+  return key;
+}
+
+static shared_ptr<EntityArena> get_current_arena() {
+  auto arena = EntityArena::get_current();
+  return arena ? arena->shared_from_this() : nullptr;
+}
+
+YList::YList(Entity* parent_entity, initializer_list<string> key_names)
+    : ylist_key_names(key_names),
+      entries(ArenaAllocator<Entry>{get_current_arena()}),
+      front(0),
+      parent(parent_entity),
+      counter(1000000),
+      slots(ArenaAllocator<size_t>{get_current_arena()}) {}
+
+YList::YList(const YList& other)
+    : ylist_key_names(other.ylist_key_names),
+      entries(other.entries),
+      front(other.front),
+      parent(other.parent),
+      counter(other.counter),
+      slots(other.slots),
+      holes(other.holes) {}
+
+YList& YList::operator=(const YList& other) {
+  ylist_key_names = other.ylist_key_names;
+  entries = other.entries;
+  front = other.front;
+  parent = other.parent;
+  counter = other.counter;
+  slots = other.slots;
+  holes = other.holes;
+  if (parent) {
+    parent->invalidate_cached_hashes();
+  }
+  return *this;
+}
+
+YList::~YList() {}
+
+string YList::build_key(shared_ptr<Entity> ep) {
+  size_t hash;
+  return build_key(*ep, hash);
+}
+
+string YList::build_key(const Entity& entity, size_t& hash) {
+  auto values = get_key_values(entity, ylist_key_names);
+  string key = join_key_values(values);
+  if (key.empty()) {
     // No key list or no matching key, use internal counter
     counter++;
-    value_buffer << counter;
-    key = value_buffer.str();
+    key = std::to_string(counter);
+    hash = hash_key(key);
+  } else {
+    hash = hash_key_values(values);
   }
   return key;
 }
 
+size_t YList::find(const string& key, size_t hash) const {
+  if (slots.empty()) {
+    return npos;
+  }
+  auto mask = slots.size() - 1;
+  for (auto slot = hash & mask; slots[slot] != 0; slot = (slot + 1) & mask) {
+    auto const& entry = entries[slots[slot] - 1];
+    if (entry.hash == hash && entry.key == key) {
+      return slot;
+    }
+  }
+  return npos;
+}
+
+size_t YList::find(const vector<string>& key_values, size_t hash) const {
+  if (slots.empty()) {
+    return npos;
+  }
+  auto mask = slots.size() - 1;
+  for (auto slot = hash & mask; slots[slot] != 0; slot = (slot + 1) & mask) {
+    auto const& entry = entries[slots[slot] - 1];
+    if (entry.hash == hash && key_equals(entry.key, key_values)) {
+      return slot;
+    }
+  }
+  return npos;
+}
+
+size_t YList::get_position(size_t item) const {
+  // before the hole at holes[i] lie holes[i] - front - i entries
+  size_t low = 0;
+  size_t high = holes.size();
+  while (low < high) {
+    auto middle = low + (high - low) / 2;
+    if (holes[middle] - front - middle <= item) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  return front + item + low;
+}
+
+void YList::insert_slot(size_t position) {
+  if (2 * len() > slots.size()) {
+    rebuild_slots();
+    return;
+  }
+  auto mask = slots.size() - 1;
+  auto slot = entries[position].hash & mask;
+  while (slots[slot] != 0) {
+    slot = (slot + 1) & mask;
+  }
+  slots[slot] = position + 1;
+}
+
+void YList::erase_slot(size_t slot) {
+  // move back the entries that probed past the freed slot
+  auto mask = slots.size() - 1;
+  auto hole = slot;
+  for (auto next = (slot + 1) & mask; slots[next] != 0;
+       next = (next + 1) & mask) {
+    auto home = entries[slots[next] - 1].hash & mask;
+    if (((next - home) & mask) >= ((next - hole) & mask)) {
+      slots[hole] = slots[next];
+      hole = next;
+    }
+  }
+  slots[hole] = 0;
+}
+
+void YList::rebuild_slots() {
+  auto live = count_if(entries.begin(), entries.end(),
+                       [](const Entry& entry) { return entry.entity; });
+  size_t size = 16;
+  while (size < 4 * static_cast<size_t>(live)) {
+    size *= 2;
+  }
+  slots.assign(size, 0);
+  auto mask = size - 1;
+  for (size_t position = 0; position < entries.size(); position++) {
+    if (!entries[position].entity) {
+      continue;
+    }
+    auto slot = entries[position].hash & mask;
+    while (slots[slot] != 0) {
+      slot = (slot + 1) & mask;
+    }
+    slots[slot] = position + 1;
+  }
+}
+
+void YList::erase(size_t slot) {
+  if (parent) {
+    parent->invalidate_cached_hashes();
+  }
+  auto position = slots[slot] - 1;
+  erase_slot(slot);
+  entries[position].entity.reset();
+  entries[position].key.clear();
+  if (position == front) {
+    // holes right after the start become part of it
+    for (front++; !holes.empty() && holes.front() == front; front++) {
+      holes.erase(holes.begin());
+    }
+  } else if (position + 1 == entries.size()) {
+    entries.pop_back();
+    while (!holes.empty() && holes.back() + 1 == entries.size()) {
+      holes.pop_back();
+      entries.pop_back();
+    }
+  } else {
+    holes.insert(lower_bound(holes.begin(), holes.end(), position), position);
+  }
+  // close the holes once finding a position or moving them costs more than
+  // doing so; give back the space of the popped entries once they are the
+  // majority
+  if (2 * front > entries.size() ||
+      holes.size() * holes.size() > 16 * (len() + 16)) {
+    compact_entries();
+  }
+}
+
+void YList::compact_entries() {
+  entries.erase(remove_if(entries.begin(), entries.end(),
+                          [](const Entry& entry) { return !entry.entity; }),
+                entries.end());
+  front = 0;
+  holes.clear();
+  rebuild_slots();
+}
+
 void YList::append(shared_ptr<Entity> ep) {
+  if (parent) {
+    parent->invalidate_cached_hashes();
+  }
   ep->parent = parent;
 
-  string key = build_key(ep);
-  if (!entity_map[key]) {
-    key_vector.push_back(key);
+  auto values = get_key_values(*ep, ylist_key_names);
+  auto hash = hash_key_values(values);
+  auto keyed = any_of(values.begin(), values.end(),
+                      [](const string& value) { return !value.empty(); });
+  auto slot = keyed ? find(values, hash) : npos;
+  string key;
+  if (slot != npos) {
+    auto& entry = entries[slots[slot] - 1];
+    entry.entity = ep;
+    key = entry.key;
+  } else {
+    if (keyed) {
+      key = join_key_values(values);
+    } else {
+      // No key list or no matching key, use internal counter
+      counter++;
+      key = std::to_string(counter);
+      hash = hash_key(key);
+    }
+    entries.push_back(Entry{key, hash, ep});
+    insert_slot(entries.size() - 1);
   }
-  entity_map[key] = ep;
-  ep->ylist_key = key;
+  ep->ylist_key = move(key);
   ep->ylist = this;
+  // the segment path of a keyless entry holds its position
+  ep->invalidate_cached_paths();
 }
 
 void YList::review(shared_ptr<Entity> ep) {
-  string key = build_key(ep);
-  if (key != ep->ylist_key) {
-    pop(ep->ylist_key);
-    if (!entity_map[key]) {
-      key_vector.push_back(key);
+  auto values = get_key_values(*ep, ylist_key_names);
+  if (key_equals(ep->ylist_key, values) && !ep->ylist_key.empty()) {
+    return;
+  }
+  size_t hash;
+  string key = join_key_values(values);
+  if (key.empty()) {
+    counter++;
+    key = std::to_string(counter);
+    hash = hash_key(key);
+  } else {
+    hash = hash_key_values(values);
+  }
+  auto old_slot = find(ep->ylist_key, hash_key(ep->ylist_key));
+  auto slot = find(key, hash);
+  if (slot != npos) {
+    // takes the place of the entry with the new key
+    entries[slots[slot] - 1].entity = ep;
+    if (old_slot != npos) {
+      erase(old_slot);
     }
-    entity_map[key] = ep;
-    ep->ylist_key = key;
+  } else if (old_slot != npos) {
+    auto position = slots[old_slot] - 1;
+    erase_slot(old_slot);
+    entries[position].key = key;
+    entries[position].hash = hash;
+    insert_slot(position);
+  } else {
+    entries.push_back(Entry{key, hash, ep});
+    insert_slot(entries.size() - 1);
   }
+  ep->ylist_key = move(key);
+  ep->invalidate_cached_paths();
 }
 
 void YList::extend(initializer_list<shared_ptr<Entity>> ep_list) {
@@ -297,58 +607,63 @@ void YList::extend(initializer_list<shared_ptr<Entity>> ep_list) {
 }
 
 shared_ptr<Entity> YList::operator[](const string& key) const {
-  auto it = entity_map.find(key);
-  if (it != entity_map.end())
-    return it->second;
+  auto slot = find(key, hash_key(key));
+  if (slot != npos)
+    return entries[slots[slot] - 1].entity;
   else {
     return nullptr;
   }
 }
 
 shared_ptr<Entity> YList::operator[](const std::size_t item) const {
-  if (item < key_vector.size()) {
-    auto key = key_vector[item];
-    return entity_map.at(key);
+  if (item >= len()) {
+    return nullptr;
   }
-  return nullptr;
+  return entries[get_position(item)].entity;
 }
 
 vector<shared_ptr<Entity>> YList::entities() const {
   vector<shared_ptr<Entity>> ev{};
-  for (auto key : key_vector) {
-    ev.push_back(entity_map.at(key));
+  ev.reserve(len());
+  for (auto const& entry : entries) {
+    if (entry.entity) {
+      ev.push_back(entry.entity);
+    }
   }
   return ev;
 }
 
-vector<string> YList::keys() const { return key_vector; }
+vector<string> YList::keys() const {
+  vector<string> keys{};
+  keys.reserve(len());
+  for (auto const& entry : entries) {
+    if (entry.entity) {
+      keys.push_back(entry.key);
+    }
+  }
+  return keys;
+}
 
-size_t YList::len() const { return key_vector.size(); }
+size_t YList::len() const { return entries.size() - front - holes.size(); }
 
 shared_ptr<Entity> YList::pop(const string& key) {
-  for (vector<string>::iterator it = key_vector.begin(); it != key_vector.end();
-       ++it) {
-    if (*it == key) {
-      shared_ptr<Entity> found = entity_map[key];
-      entity_map.erase(key);
-      key_vector.erase(it);
-      return found;
-    }
+  auto slot = find(key, hash_key(key));
+  if (slot == npos) {
+    return nullptr;
   }
-  return nullptr;
+  auto found = entries[slots[slot] - 1].entity;
+  erase(slot);
+  return found;
 }
 
 shared_ptr<Entity> YList::pop(const std::size_t item) {
-  if (item < key_vector.size()) {
-    vector<string>::iterator it = key_vector.begin();
-    for (size_t i = 0; i < item; i++) ++it;
-    shared_ptr<Entity> found = entity_map[*it];
-    entity_map.erase(*it);
-    key_vector.erase(it);
+  if (item < len()) {
+    auto const& entry = entries[get_position(item)];
+    auto found = entry.entity;
+    erase(find(entry.key, entry.hash));
     return found;
   } else {
-    YLOG_ERROR("Index value {} is out of range [0,{}]", item,
-               key_vector.size());
+    YLOG_ERROR("Index value {} is out of range [0,{}]", item, len());
     throw(YInvalidArgumentError{"Index value is out of range"});
   }
   return nullptr;
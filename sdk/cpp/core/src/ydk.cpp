@@ -127,6 +127,32 @@ static const char* string_to_array(const string& str) {
   return cstr;
 }
 
+namespace {
+struct FlatDataNode {
+  string path;
+  // offset of the segment path in path
+  size_t segment;
+  string value;
+  ydk::path::Statement statement;
+  int parent;
+};
+}  // namespace
+
+static void flatten(ydk::path::DataNode& datanode, int parent,
+                    vector<FlatDataNode>& nodes) {
+  string path = datanode.get_path();
+  auto segments = ydk::path::segmentalize(path);
+  size_t segment =
+      path.size() - (segments.empty() ? 0 : segments.back().size());
+  nodes.push_back({path, segment, datanode.get_value(),
+                   datanode.get_schema_node().get_statement(), parent});
+
+  int index = static_cast<int>(nodes.size() - 1);
+  for (auto& child : datanode.get_children()) {
+    flatten(*child, index, nodes);
+  }
+}
+
 void handle_error_message(YDKState* state, const char* message) {
   state->error_occurred = true;
   if (state->error_message) {
@@ -753,6 +779,100 @@ const char* DataNodeGetSegmentPath(DataNode datanode) {
   return string_to_array(segments.back());
 }
 
+int DataNodeCreateMany(YDKStatePtr state, DataNode datanode,
+                       const char* paths[], const char* values[],
+                       const char* operations[], const int parents[],
+                       int count) {
+  int created = 0;
+  try {
+    DataNodeWrapper* datanode_wrapper = (DataNodeWrapper*)datanode;
+    ydk::path::DataNode* real_datanode = unwrap(datanode_wrapper);
+    vector<ydk::path::DataNode*> results;
+    results.reserve(count);
+    for (; created < count; created++) {
+      int parent = parents ? parents[created] : -1;
+      if (parent >= created) {
+        throw(ydk::YInvalidArgumentError{
+            "Parent of data node " + std::to_string(created) +
+            " is not created before it"});
+      }
+      const char* value = values && values[created] ? values[created] : "";
+      ydk::path::DataNode& result =
+          (parent < 0 ? real_datanode : results[parent])
+              ->create_datanode(paths[created], value);
+      results.push_back(&result);
+
+      const char* operation = operations ? operations[created] : nullptr;
+      if (operation && *operation) {
+        result.add_annotation({"ietf-netconf", "operation", operation});
+      }
+    }
+  } catch (...) {
+    YDKState* real_state = static_cast<YDKState*>(state);
+    handle_error(real_state);
+  }
+  return created;
+}
+
+DataNodeArena* DataNodeFlatten(YDKStatePtr state, DataNode datanode) {
+  try {
+    DataNodeWrapper* datanode_wrapper = (DataNodeWrapper*)datanode;
+    ydk::path::DataNode* real_datanode = unwrap(datanode_wrapper);
+    vector<FlatDataNode> nodes;
+    flatten(*real_datanode, -1, nodes);
+
+    // the arena, the arrays of strings, the parents and then the strings
+    size_t count = nodes.size();
+    size_t strings_offset = sizeof(DataNodeArena) + 6 * count * sizeof(char*);
+    size_t parents_offset = strings_offset;
+    strings_offset += count * sizeof(int);
+    size_t size = strings_offset;
+    for (auto& node : nodes) {
+      size += node.path.size() + node.value.size() +
+              node.statement.keyword.size() + node.statement.arg.size() +
+              node.statement.module_name.size() + 5;
+    }
+
+    char* buffer = static_cast<char*>(malloc(size));
+    DataNodeArena* arena = reinterpret_cast<DataNodeArena*>(buffer);
+    const char** arrays =
+        reinterpret_cast<const char**>(buffer + sizeof(DataNodeArena));
+    arena->count = static_cast<int>(count);
+    arena->paths = arrays;
+    arena->segment_paths = arrays + count;
+    arena->values = arrays + 2 * count;
+    arena->keywords = arrays + 3 * count;
+    arena->arguments = arrays + 4 * count;
+    arena->module_names = arrays + 5 * count;
+    arena->parents = reinterpret_cast<int*>(buffer + parents_offset);
+
+    char* next = buffer + strings_offset;
+    auto copy = [&next](const string& str) -> const char* {
+      char* cstr = next;
+      std::memcpy(cstr, str.c_str(), str.size() + 1);
+      next += str.size() + 1;
+      return cstr;
+    };
+    for (size_t i = 0; i < count; i++) {
+      auto& node = nodes[i];
+      arena->paths[i] = copy(node.path);
+      arena->segment_paths[i] = arena->paths[i] + node.segment;
+      arena->values[i] = copy(node.value);
+      arena->keywords[i] = copy(node.statement.keyword);
+      arena->arguments[i] = copy(node.statement.arg);
+      arena->module_names[i] = copy(node.statement.module_name);
+      arena->parents[i] = node.parent;
+    }
+    return arena;
+  } catch (...) {
+    YDKState* real_state = static_cast<YDKState*>(state);
+    handle_error(real_state);
+    return NULL;
+  }
+}
+
+void DataNodeArenaFree(DataNodeArena* arena) { free(arena); }
+
 void EnableLogging(LogLevel) {
   //    auto console = spdlog::sinks::stdout_color_mt("ydk");
   //    switch(level)
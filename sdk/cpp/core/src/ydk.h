@@ -50,6 +50,22 @@ typedef struct DataNodeChildren {
   int count;
 } DataNodeChildren;
 
+// Subtree flattened by DataNodeFlatten, in pre-order so that every node
+// follows its parent. The arrays and strings share a single allocation,
+// released by DataNodeArenaFree.
+typedef struct DataNodeArena {
+  int count;
+  const char** paths;
+  // suffixes of paths
+  const char** segment_paths;
+  const char** values;
+  const char** keywords;
+  const char** arguments;
+  const char** module_names;
+  // index of the parent of each node, -1 for the root of the subtree
+  int* parents;
+} DataNodeArena;
+
 typedef int boolean;
 
 typedef enum EncodingFormat { XML = 0, JSON } EncodingFormat;
@@ -173,6 +189,17 @@ void DataNodeAddAnnotation(DataNode, const char*);
 DataNodeChildren DataNodeGetChildren(DataNode);
 const char* DataNodeGetSegmentPath(DataNode);
 
+// Creates count nodes with the given values and ietf-netconf operations,
+// the i-th at paths[i] relative to the parents[i]-th node created, or to the
+// given node if parents[i] is -1. values, operations and parents may be NULL.
+// Returns the number of nodes created, which is less than count if an error
+// occurred.
+int DataNodeCreateMany(YDKStatePtr, DataNode, const char* paths[],
+                       const char* values[], const char* operations[],
+                       const int parents[], int count);
+DataNodeArena* DataNodeFlatten(YDKStatePtr, DataNode);
+void DataNodeArenaFree(DataNodeArena*);
+
 // what if duplicates? where to initialize?
 void EnableLogging(LogLevel);
 // void EnableLogging(YDKState*, LogLevel);
@@ -176,6 +176,56 @@ TEST_CASE("decode_multiple_json") {
   REQUIRE(json_str == json_int_payload + json_bgp_payload);
 }
 
+TEST_CASE("decode_updates") {
+  std::string searchdir{TEST_HOME};
+  mock::MockSession sp{searchdir, test_openconfig};
+  auto& schema = sp.get_root_schema();
+
+  ydk::path::DataUpdate name{};
+  name.path = {{"openconfig-interfaces:interfaces", {}},
+               {"interface", {{"name", "Loopback10"}}},
+               {"config", {}},
+               {"name", {}}};
+  name.values = {"Loopback10"};
+
+  ydk::path::DataUpdate bgp{};
+  bgp.path = {{"openconfig-bgp:bgp", {}}};
+  bgp.values = {R"({"global": {"config": {"as": 65172}}})"};
+  bgp.json = true;
+
+  ydk::path::Codec s{};
+  auto rdn = s.decode_updates(schema, {name, bgp});
+  REQUIRE(rdn != nullptr);
+  REQUIRE(rdn->get_children().size() == 2);
+
+  auto json_str = s.encode(*rdn, EncodingFormat::JSON, true);
+  REQUIRE(json_str == R"({
+  "openconfig-interfaces:interfaces": {
+    "interface": [
+      {
+        "name": "Loopback10",
+        "config": {
+          "name": "Loopback10"
+        }
+      }
+    ]
+  }
+}
+{
+  "openconfig-bgp:bgp": {
+    "global": {
+      "config": {
+        "as": 65172
+      }
+    }
+  }
+}
+)");
+
+  name.path[3].name = "no-such-leaf";
+  REQUIRE_THROWS_AS(s.decode_updates(schema, {name}), ydk::path::YCoreError);
+}
+
 TEST_CASE("test_no_key_list_path") {
   std::string searchdir{TEST_HOME};
   mock::MockSession sp{searchdir, test_openconfig};
@@ -25,9 +25,12 @@
 //
 //////////////////////////////////////////////////////////////////
 
+#include <chrono>
 #include <iostream>
+#include <thread>
 
 #include "../src/entity_util.hpp"
+#include "../src/errors.hpp"
 #include "../src/types.hpp"
 #include "catch.hpp"
 
@@ -40,7 +43,7 @@ class TestEntity : public Entity {
       : name{YType::str, "name"},
         enabled{YType::boolean, "enabled"},
         bits_field{YType::bits, "bits-field"},
-        child(make_shared<TestEntity::Child>()) {
+        child(make_entity<TestEntity::Child>()) {
     yang_name = "test";
     yang_parent_name = "";
   }
@@ -65,7 +68,7 @@ class TestEntity : public Entity {
       if (child != nullptr) {
         return child;
       } else {
-        child = make_shared<TestEntity::Child>();
+        child = make_entity<TestEntity::Child>(arena);
         child->parent = this;
         return child;
       }
@@ -79,6 +82,9 @@ class TestEntity : public Entity {
 
   void set_filter(const std::string& name1, YFilter yfilter) {}
 
+  void set_child_by_name(const std::string& yang_name,
+                         std::shared_ptr<Entity> child) {}
+
   void set_value(const std::string& name1, const std::string& value,
                  const std::string& value1, const std::string& value2) {
     if (name1 == "name") {
@@ -125,7 +131,7 @@ class TestEntity : public Entity {
             return ch;
           }
         }
-        auto ch = make_shared<TestEntity::Child::MultiChild>();
+        auto ch = make_entity<TestEntity::Child::MultiChild>(arena);
         ch->parent = this;
         multi_child.push_back(ch);
         return multi_child.back();
@@ -140,6 +146,9 @@ class TestEntity : public Entity {
 
     void set_filter(const std::string& name1, YFilter yfilter) {}
 
+    void set_child_by_name(const std::string& yang_name,
+                           std::shared_ptr<Entity> child) {}
+
     void set_value(const std::string& leaf_name, const std::string& value,
                    const std::string& value1, const std::string& value2) {
       if (leaf_name == "child-val") {
@@ -184,6 +193,9 @@ class TestEntity : public Entity {
 
       void set_filter(const std::string& name1, YFilter yfilter) {}
 
+      void set_child_by_name(const std::string& yang_name,
+                             std::shared_ptr<Entity> child) {}
+
       void set_value(const std::string& leaf_name, const std::string& value,
                      const std::string& value2, const std::string& value3) {
         if (leaf_name == "child-key") {
@@ -360,7 +372,7 @@ TEST_CASE("test_multi_read") {
   REQUIRE(m != nullptr);
 }
 
-static string vector_to_string(vector<string>& string_vector) {
+static string vector_to_string(const vector<string>& string_vector) {
   ostringstream buf;
   for (auto item : string_vector) {
     if (buf.str().length() > 0) buf << ", ";
@@ -457,3 +469,659 @@ TEST_CASE("test_ylist_race") {
 
   delete list_holder;
 }
+
+TEST_CASE("test_ylist_review_in_place") {
+  TestEntity list_holder{};
+  YList ylist{&list_holder, {"name"}};
+  vector<shared_ptr<TestEntity>> entries;
+  for (auto name : {"one", "two", "three"}) {
+    entries.push_back(make_shared<TestEntity>());
+    entries.back()->name = name;
+    ylist.append(entries.back());
+  }
+
+  // keeps its position under the new key
+  entries[1]->name = "second";
+  ylist.review(entries[1]);
+  REQUIRE(vector_to_string(ylist.keys()) == R"("one", "second", "three")");
+  REQUIRE(ylist["two"] == nullptr);
+  REQUIRE(ylist["second"] == entries[1]);
+  REQUIRE(entries[1]->ylist_key == "second");
+
+  // takes the place of the entry that has the new key
+  entries[2]->name = "one";
+  ylist.review(entries[2]);
+  REQUIRE(vector_to_string(ylist.keys()) == R"("one", "second")");
+  REQUIRE(ylist[0] == entries[2]);
+  REQUIRE(ylist.len() == 2);
+
+  // composite keys
+  YList composite{&list_holder, {"name", "enabled"}};
+  auto entry = make_shared<TestEntity>();
+  entry->name = "one";
+  entry->enabled = true;
+  composite.append(entry);
+  REQUIRE(composite["one,true"] == entry);
+  REQUIRE(composite.pop("one,true") == entry);
+  REQUIRE(composite.len() == 0);
+}
+
+TEST_CASE("test_ylist_pop") {
+  TestEntity list_holder{};
+  YList ylist{&list_holder, {"name"}};
+  vector<string> expected;
+  for (int i = 0; i < 1000; i++) {
+    auto entry = make_shared<TestEntity>();
+    entry->name = "entry" + to_string(i);
+    ylist.append(entry);
+    expected.push_back("entry" + to_string(i));
+  }
+  // pop by key and by position, checking against a plain vector
+  for (size_t i = 0; expected.size() > 100; i += 7) {
+    auto index = i % expected.size();
+    if (i % 2 == 0) {
+      REQUIRE(ylist.pop(expected[index]) != nullptr);
+    } else {
+      auto entry = dynamic_pointer_cast<TestEntity>(ylist.pop(index));
+      REQUIRE(entry->name == expected[index]);
+    }
+    expected.erase(expected.begin() + index);
+    REQUIRE(ylist.len() == expected.size());
+  }
+  REQUIRE(ylist.keys() == expected);
+  for (size_t i = 0; i < expected.size(); i++) {
+    REQUIRE(ylist[expected[i]] == ylist[i]);
+  }
+  REQUIRE(ylist.pop("entry1") == nullptr);
+  REQUIRE_THROWS_AS(ylist.pop(expected.size()), YInvalidArgumentError);
+}
+
+TEST_CASE("test_ylist_const_access") {
+  TestEntity list_holder{};
+  YListWrapper<TestEntity> ylist{&list_holder, {"name"}};
+  for (int i = 0; i < 100; i++) {
+    auto entry = make_shared<TestEntity>();
+    entry->name = "entry" + to_string(i);
+    ylist.append(entry);
+  }
+  for (int i = 1; i < 100; i += 3) {
+    ylist.pop("entry" + to_string(i));
+  }
+
+  // readers share the list and leave it as it is
+  const YListWrapper<TestEntity>& shared = ylist;
+  auto keys = shared.keys();
+  vector<thread> readers;
+  vector<int> consistent(4);
+  for (size_t r = 0; r < consistent.size(); r++) {
+    readers.emplace_back([&shared, &keys, &consistent, r] {
+      bool same = shared.len() == keys.size();
+      size_t i = 0;
+      for (auto const& entry : shared) {
+        same = same && entry.first == keys[i] &&
+               shared[i]->ylist_key == keys[i] && entry.second == shared[i];
+        i++;
+      }
+      consistent[r] = same && i == keys.size();
+    });
+  }
+  for (auto& reader : readers) reader.join();
+  for (int same : consistent) {
+    REQUIRE(same);
+  }
+  REQUIRE(shared.keys() == keys);
+  REQUIRE(shared[keys.size()] == nullptr);
+}
+
+TEST_CASE("test_ylist_benchmark", "[.benchmark]") {
+  const int entries = 100000;
+  TestEntity list_holder{};
+  YList ylist{&list_holder, {"name"}};
+  vector<shared_ptr<TestEntity>> made;
+  for (int i = 0; i < entries; i++) {
+    made.push_back(make_shared<TestEntity>());
+    made.back()->name = "GigabitEthernet0/0/0/" + to_string(i);
+  }
+
+  auto start = chrono::steady_clock::now();
+  for (auto& entry : made) {
+    ylist.append(entry);
+  }
+  auto append =
+      chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+  start = chrono::steady_clock::now();
+  size_t found = 0;
+  for (int i = 0; i < entries; i++) {
+    found += ylist[i] != nullptr;
+    found += ylist["GigabitEthernet0/0/0/" + to_string(i)] != nullptr;
+  }
+  auto access =
+      chrono::duration<double>(chrono::steady_clock::now() - start).count();
+  REQUIRE(found == 2 * entries);
+
+  start = chrono::steady_clock::now();
+  for (int i = 0; i < entries; i += 2) {
+    made[i]->name = "Loopback" + to_string(i);
+    ylist.review(made[i]);
+  }
+  auto review =
+      chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+  start = chrono::steady_clock::now();
+  for (int i = 0; i < entries; i += 2) {
+    ylist.pop("Loopback" + to_string(i));
+    // every pop followed by an access by position
+    found -= ylist[0] != nullptr;
+  }
+  auto pop =
+      chrono::duration<double>(chrono::steady_clock::now() - start).count();
+  REQUIRE(ylist.len() == entries / 2);
+
+  cout << entries << " list entries, append " << append
+       << " s, access by position and key " << access << " s, review "
+       << review << " s, pop " << pop << " s" << endl;
+}
+
+TEST_CASE("test_entity_arena") {
+  auto arena = make_shared<EntityArena>(1024);
+  weak_ptr<EntityArena> released = arena;
+  auto test = make_entity<TestEntity>(arena.get());
+  arena.reset();
+  // kept alive by the entities made in it
+  REQUIRE(!released.expired());
+  REQUIRE(test->arena != nullptr);
+  REQUIRE(test->child->arena == test->arena);
+  REQUIRE(EntityArena::get_current() == nullptr);
+
+  auto multi_child = test->child->get_child_by_name("multi-child", "");
+  REQUIRE(multi_child->arena == test->arena);
+  multi_child->set_value("child-key", "one", "", "");
+  REQUIRE(multi_child->get_segment_path() == "multi-child[child-key='one']");
+
+  {
+    EntityArena::Scope scope{test->arena};
+    YList ylist{test.get(), {"name"}};
+    for (int i = 0; i < 100; i++) {
+      auto entry = make_entity<TestEntity>();
+      entry->name = "entry" + to_string(i);
+      ylist.append(entry);
+    }
+    REQUIRE(ylist.len() == 100);
+    auto entry = dynamic_cast<TestEntity*>(ylist["entry42"].get());
+    REQUIRE(entry->arena == test->arena);
+    REQUIRE(entry->name == "entry42");
+  }
+  REQUIRE(EntityArena::get_current() == nullptr);
+  REQUIRE(test->arena->get_size() > 1024);
+
+  // larger than a block
+  auto memory = test->arena->allocate(4096, 16);
+  REQUIRE(reinterpret_cast<uintptr_t>(memory) % 16 == 0);
+
+  test.reset();
+  REQUIRE(!released.expired());
+  multi_child.reset();
+  REQUIRE(released.expired());
+
+  // no arena, on the heap
+  auto heap = make_entity<TestEntity>();
+  REQUIRE(heap->arena == nullptr);
+  REQUIRE(heap->child->arena == nullptr);
+}
+
+TEST_CASE("test_name_hash") {
+  // the generator computes the same values for the name switches
+  REQUIRE(name_hash("") == 0xcbf29ce484222325ULL);
+  REQUIRE(name_hash("a") == 0xaf63dc4c8601ec8cULL);
+  REQUIRE(name_hash("foobar") == 0x85944171f73967e8ULL);
+  REQUIRE(name_hash("in-octets") != name_hash("out-octets"));
+}
+
+// Entry of a list keyed by id with nested entries, as the generator makes it
+class TreeNode : public Entity {
+ public:
+  TreeNode() : id{YType::str, "id"} {
+    yang_name = "node";
+    yang_parent_name = "node";
+    cache_paths = true;
+    id.is_key = true;
+    id.owner = this;
+  }
+
+  bool has_data() const { return id.is_set; }
+
+  bool has_operation() const { return false; }
+
+  std::string get_segment_path() const {
+    std::ostringstream path_buffer;
+    path_buffer << "node";
+    ADD_KEY_TOKEN(id, "id");
+    return path_buffer.str();
+  }
+
+  std::vector<std::pair<std::string, LeafData>> get_name_leaf_data() const {
+    return {id.get_name_leafdata()};
+  }
+
+  std::shared_ptr<Entity> get_child_by_name(const std::string& child_path,
+                                            const string& u) {
+    return nullptr;
+  }
+
+  bool has_leaf_or_child_of_name(const std::string& name) const override {
+    return false;
+  }
+
+  void set_filter(const std::string& name1, YFilter yfilter) {}
+
+  void set_child_by_name(const std::string& yang_name,
+                         std::shared_ptr<Entity> child) {}
+
+  void set_value(const std::string& leaf_name, const std::string& value,
+                 const std::string& value1, const std::string& value2) {
+    if (leaf_name == "id") {
+      id = value;
+    }
+  }
+
+  std::map<std::string, std::shared_ptr<Entity>> get_children() const {
+    std::map<std::string, std::shared_ptr<Entity>> children;
+    for (auto const& node : nodes) {
+      children[node->get_cached_segment_path()] = node;
+    }
+    return children;
+  }
+
+  shared_ptr<TreeNode> add(const string& node_id) {
+    auto node = make_shared<TreeNode>();
+    node->id = node_id;
+    node->parent = this;
+    nodes.push_back(node);
+    // as YList::append()
+    invalidate_cached_hashes();
+    return node;
+  }
+
+  // as generated, with the nodes kept in a vector instead of a YList
+  std::shared_ptr<Entity> deep_clone() const override {
+    auto clone = make_entity<TreeNode>();
+    copy_to(*clone);
+    return clone;
+  }
+
+  void copy_to(TreeNode& clone) const {
+    clone.yfilter = yfilter;
+    clone.id.assign(id);
+    for (auto const& node : nodes) {
+      auto item = make_entity<TreeNode>(clone.arena);
+      node->copy_to(*item);
+      item->parent = &clone;
+      clone.nodes.push_back(item);
+    }
+  }
+
+  YLeaf id;
+  vector<shared_ptr<TreeNode>> nodes;
+};
+
+static void add_tree_nodes(TreeNode& node, int depth, int fanout) {
+  if (depth == 0) {
+    return;
+  }
+  for (int i = 0; i < fanout; i++) {
+    auto child = node.add("GigabitEthernet0/0/0/" + to_string(i));
+    add_tree_nodes(*child, depth - 1, fanout);
+  }
+}
+
+static void set_cache_paths(TreeNode& node, bool cache_paths) {
+  node.cache_paths = cache_paths;
+  for (auto const& child : node.nodes) {
+    set_cache_paths(*child, cache_paths);
+  }
+}
+
+TEST_CASE("test_entity_path_cache") {
+  for (bool cache_paths : {true, false}) {
+    TreeNode root{};
+    root.is_top_level_class = true;
+    root.id = "r";
+    auto a = root.add("a");
+    auto x = a->add("x");
+    set_cache_paths(root, cache_paths);
+    REQUIRE(absolute_path(*x) == "node[id='r']/node[id='a']/node[id='x']");
+    REQUIRE(x->get_cached_segment_path() == "node[id='x']");
+
+    // a key leaf changes
+    a->id = "b";
+    REQUIRE(absolute_path(*x) == "node[id='r']/node[id='b']/node[id='x']");
+    string path = "node[id='r']/node[id='b']/node[id='x']";
+    REQUIRE(path_to_entity(root, path) == x.get());
+
+    // the entity moves
+    x->parent = &root;
+    REQUIRE(absolute_path(*x) == "node[id='r']/node[id='x']");
+
+    // an ancestor moves
+    auto y = x->add("y");
+    REQUIRE(absolute_path(*y) == "node[id='r']/node[id='x']/node[id='y']");
+    x->parent = a.get();
+    REQUIRE(absolute_path(*y) ==
+            "node[id='r']/node[id='b']/node[id='x']/node[id='y']");
+    x->parent = nullptr;
+    REQUIRE(absolute_path(*y) == "node[id='x']/node[id='y']");
+  }
+}
+
+TEST_CASE("test_entity_path_index") {
+  auto root = make_shared<TreeNode>();
+  root->is_top_level_class = true;
+  root->id = "r";
+  auto a = root->add("a/b");
+  auto x = a->add("x");
+  auto y = a->add("y");
+  EntityPathIndex index{root};
+  REQUIRE(index.find("node[id='r']") == root);
+  REQUIRE(index.find("node[id='r']/node[id='a/b']/node[id='y']") == y);
+  // relative to the top
+  REQUIRE(index.find("node[id='a/b']/node[id='x']") == x);
+  REQUIRE(index.find("node[id='a/b']/node[id='z']") == nullptr);
+  REQUIRE(index.find("node[id='r']/node[id='x']") == nullptr);
+
+  string path = "node[id='r']/node[id='a/b']/node[id='x']";
+  REQUIRE(path_to_entity(*root, path) == x.get());
+  // a key is not a leaf of its own
+  path = "node[id='r']/node[id='a/b']/id";
+  REQUIRE(path_to_entity(*root, path) == nullptr);
+}
+
+TEST_CASE("test_entity_deep_clone") {
+  TreeNode root{};
+  root.is_top_level_class = true;
+  root.id = "r";
+  auto a = root.add("a");
+  a->id.yfilter = YFilter::replace;
+  a->add("x");
+  auto clone = dynamic_pointer_cast<TreeNode>(root.deep_clone());
+  REQUIRE(clone != nullptr);
+  REQUIRE(clone->get_parent() == nullptr);
+  REQUIRE(entity_to_dict(*clone) == entity_to_dict(root));
+  auto clone_a = clone->nodes[0];
+  REQUIRE(clone_a.get() != a.get());
+  REQUIRE(clone_a->get_parent() == clone.get());
+  REQUIRE(clone_a->id.yfilter == YFilter::replace);
+  REQUIRE(absolute_path(*clone_a->nodes[0]) ==
+          "node[id='r']/node[id='a']/node[id='x']");
+
+  // the clone is independent of the original
+  clone_a->id = "b";
+  REQUIRE(a->id.get() == "a");
+  a->add("y");
+  REQUIRE(clone_a->nodes.size() == 1);
+
+  // made in the current arena
+  auto arena = make_shared<EntityArena>();
+  {
+    EntityArena::Scope scope{arena.get()};
+    clone = dynamic_pointer_cast<TreeNode>(root.deep_clone());
+  }
+  REQUIRE(clone->arena == arena.get());
+  REQUIRE(clone->nodes[0]->nodes[1]->arena == arena.get());
+  REQUIRE(entity_to_dict(*clone) == entity_to_dict(root));
+
+  // classes without a clone
+  TestEntity test{};
+  REQUIRE(test.deep_clone() == nullptr);
+}
+
+TEST_CASE("test_entity_tree_hash") {
+  TreeNode first{};
+  first.is_top_level_class = true;
+  first.id = "r";
+  first.add("a")->add("x");
+  auto second = dynamic_pointer_cast<TreeNode>(first.deep_clone());
+  REQUIRE(first.get_tree_hash() != 0);
+  REQUIRE(first.get_tree_hash() == second->get_tree_hash());
+  REQUIRE(first == *second);
+
+  // a change below is noticed at the top
+  auto a = second->nodes[0];
+  auto x = a->nodes[0];
+  x->id = "y";
+  REQUIRE(first != *second);
+  x->id = "x";
+  REQUIRE(first == *second);
+
+  a->add("z");
+  REQUIRE(first != *second);
+  a->nodes.pop_back();
+  a->invalidate_cached_hashes();
+  REQUIRE(first == *second);
+
+  // children without data are left out
+  a->nodes.push_back(make_shared<TreeNode>());
+  REQUIRE(first == *second);
+
+  // filters are written past the leaf, which does not tell the entity
+  x->id.yfilter = YFilter::delete_;
+  REQUIRE(first == *second);
+  x->invalidate_cached_hashes();
+  REQUIRE(first.get_tree_hash() != second->get_tree_hash());
+  REQUIRE(first != *second);
+  x->id.yfilter = YFilter::not_set;
+  x->invalidate_cached_hashes();
+  REQUIRE(first == *second);
+
+  x->id.value_namespace = "urn:other";
+  x->invalidate_cached_hashes();
+  REQUIRE(first.get_tree_hash() != second->get_tree_hash());
+  REQUIRE(first != *second);
+  x->id.value_namespace = "";
+  x->invalidate_cached_hashes();
+  REQUIRE(first == *second);
+
+  // a new sibling is noticed at the top
+  auto b = second->add("b");
+  REQUIRE(first != *second);
+  b->id = "c";
+  REQUIRE(first != *second);
+  second->nodes.pop_back();
+  second->invalidate_cached_hashes();
+  REQUIRE(first == *second);
+
+  x->id.yfilter = YFilter::delete_;
+  x->invalidate_cached_hashes();
+  REQUIRE(first != *second);
+
+  // not cached
+  set_cache_paths(*second, false);
+  x->id.yfilter = YFilter::not_set;
+  REQUIRE(first == *second);
+
+  TestEntity empty{};
+  REQUIRE(empty.get_tree_hash() == 0);
+  REQUIRE(empty == TestEntity{});
+  REQUIRE_FALSE(empty != TestEntity{});
+  // entities without data are equal whatever their paths
+  TreeNode other{};
+  other.yang_name = "other";
+  REQUIRE(empty == other);
+  REQUIRE_FALSE(empty != other);
+}
+
+// A container with one child container, as generated
+class TreeHolder : public TestEntity {
+ public:
+  TreeHolder() : node(this, make_entity<TreeNode>()) { cache_paths = true; }
+
+  bool has_data() const { return node && node->has_data(); }
+
+  std::map<std::string, std::shared_ptr<Entity>> get_children() const {
+    std::map<std::string, std::shared_ptr<Entity>> children;
+    if (node) {
+      children["node"] = node;
+    }
+    return children;
+  }
+
+  YChild<TreeNode> node;
+};
+
+TEST_CASE("test_entity_tree_hash_child") {
+  TreeHolder first{};
+  TreeHolder second{};
+  first.node->id = "a";
+  second.node->id = "a";
+  REQUIRE(first == second);
+
+  // a child put in place is noticed
+  auto replaced = make_shared<TreeNode>();
+  replaced->id = "b";
+  second.node = replaced;
+  REQUIRE(second.node->parent == &second);
+  REQUIRE(first != second);
+  second.node = make_shared<TreeNode>();
+  second.node->id = "a";
+  REQUIRE(first == second);
+
+  // and so is one taken away
+  second.node = nullptr;
+  REQUIRE(first != second);
+  first.node.reset();
+  REQUIRE(first == second);
+  first.node.reset(new TreeNode());
+  REQUIRE(first.node->parent == &first);
+}
+
+TEST_CASE("test_entity_copy") {
+  TreeNode first{};
+  first.id = "r";
+  first.add("a");
+  REQUIRE(first.get_tree_hash() != 0);
+
+  // a copy does not cache, as its leafs still tell the original
+  TreeNode second{first};
+  REQUIRE_FALSE(second.cache_paths);
+  REQUIRE(second == first);
+  second.id.owner = &second;
+  second.id = "s";
+  REQUIRE(second != first);
+
+  // the entity part of an assignment leaves the caching as it was
+  TestEntity third{};
+  third.cache_paths = true;
+  REQUIRE(third.get_tree_hash() == 0);
+  static_cast<Entity&>(third) = first;
+  REQUIRE(third.cache_paths);
+  REQUIRE(third.yang_name == "node");
+}
+
+TEST_CASE("test_entity_path_benchmark", "[.benchmark]") {
+  // a read result of 6 levels of 6 list entries each
+  TreeNode root{};
+  root.is_top_level_class = true;
+  root.id = "root";
+  add_tree_nodes(root, 6, 6);
+  vector<string> paths;
+  for (auto const& entry : entity_to_dict(root)) {
+    paths.push_back(entry.first);
+  }
+
+  for (bool cache_paths : {false, true}) {
+    set_cache_paths(root, cache_paths);
+    auto start = chrono::steady_clock::now();
+    auto dict = entity_to_dict(root);
+    auto to_dict =
+        chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    REQUIRE(dict.size() == paths.size());
+
+    // every 100th entry looked up from the top
+    start = chrono::steady_clock::now();
+    size_t found = 0;
+    for (size_t i = 0; i < paths.size(); i += 100) {
+      found += path_to_entity(root, paths[i]) != nullptr;
+    }
+    auto lookup =
+        chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    REQUIRE(found == (paths.size() + 99) / 100);
+
+    // every entry looked up in one index
+    start = chrono::steady_clock::now();
+    EntityPathIndex index{root};
+    found = 0;
+    for (auto const& path : paths) {
+      found += index.find(path) != nullptr;
+    }
+    auto indexed =
+        chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    REQUIRE(found == paths.size());
+
+    cout << (cache_paths ? "cached" : "built") << " paths: " << paths.size()
+         << " entities, entity_to_dict " << to_dict << " s, "
+         << (paths.size() + 99) / 100 << " path_to_entity " << lookup
+         << " s, " << found << " indexed lookups " << indexed << " s" << endl;
+  }
+}
+
+TEST_CASE("test_entity_clone_benchmark", "[.benchmark]") {
+  TreeNode root{};
+  root.is_top_level_class = true;
+  root.id = "root";
+  auto start = chrono::steady_clock::now();
+  add_tree_nodes(root, 6, 6);
+  auto build =
+      chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+  start = chrono::steady_clock::now();
+  auto clone = root.deep_clone();
+  auto deep_clone =
+      chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+  // a walk over the same tree
+  start = chrono::steady_clock::now();
+  auto dict = entity_to_dict(*clone);
+  auto to_dict =
+      chrono::duration<double>(chrono::steady_clock::now() - start).count();
+  REQUIRE(dict == entity_to_dict(root));
+
+  cout << dict.size() << " entities: built " << build << " s, deep_clone "
+       << deep_clone << " s, entity_to_dict " << to_dict << " s" << endl;
+}
+
+TEST_CASE("test_entity_equality_benchmark", "[.benchmark]") {
+  // two configs of 16^5 leaf entities and their ancestors, a leaf each
+  TreeNode first{};
+  first.is_top_level_class = true;
+  first.id = "root";
+  add_tree_nodes(first, 5, 16);
+  auto second = dynamic_pointer_cast<TreeNode>(first.deep_clone());
+
+  auto start = chrono::steady_clock::now();
+  REQUIRE(first == *second);
+  auto hashed =
+      chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+  start = chrono::steady_clock::now();
+  REQUIRE(first == *second);
+  auto cached =
+      chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+  // one leaf changed
+  auto leaf = second->nodes[7]->nodes[7]->nodes[7]->nodes[7]->nodes[7];
+  leaf->id = "changed";
+  start = chrono::steady_clock::now();
+  REQUIRE(first != *second);
+  auto changed =
+      chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+  // as compared without the hashes
+  start = chrono::steady_clock::now();
+  REQUIRE(entity_to_dict(first) != entity_to_dict(*second));
+  auto to_dict =
+      chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+  cout << "two trees of 1118481 leafs: first compare " << hashed
+       << " s, unchanged " << cached << " s, after a change " << changed
+       << " s, entity_to_dict " << to_dict << " s" << endl;
+}
@@ -0,0 +1,496 @@
+/// YANG Development Kit
+// Copyright 2016 Cisco Systems. All rights reserved
+//
+////////////////////////////////////////////////////////////////
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+//////////////////////////////////////////////////////////////////
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <set>
+#include <thread>
+
+#include "../src/errors.hpp"
+#include "../src/fleet_executor.hpp"
+#include "catch.hpp"
+
+using namespace ydk;
+using namespace std;
+
+namespace {
+// Stands in for a NETCONF device listening on its own port: every operation
+// costs one round trip of the given latency.
+class MockDeviceProvider : public ServiceProvider {
+ public:
+  MockDeviceProvider(const FleetDevice& device, chrono::microseconds latency,
+                     atomic<int>& open_sessions)
+      : device{device}, latency{latency}, open_sessions(open_sessions) {
+    if (device.port == 0) throw YClientError{"Connection refused"};
+    this_thread::sleep_for(latency);
+    open_sessions++;
+  }
+
+  ~MockDeviceProvider() { open_sessions--; }
+
+  EncodingFormat get_encoding() const { return EncodingFormat::XML; }
+
+  const path::Session& get_session() const {
+    throw YOperationNotSupportedError{"No session in mock provider"};
+  }
+
+  const string get_provider_type() const { return device.name; }
+
+  shared_ptr<Entity> execute_operation(const string&, Entity&,
+                                       map<string, string>) {
+    this_thread::sleep_for(latency);
+    return nullptr;
+  }
+
+  vector<shared_ptr<Entity>> execute_operation(const string&, vector<Entity*>,
+                                               map<string, string>) {
+    this_thread::sleep_for(latency);
+    return {};
+  }
+
+  FleetDevice device;
+  chrono::microseconds latency;
+  atomic<int>& open_sessions;
+};
+
+// Takes note of the entities given to it
+class RecordingProvider : public MockDeviceProvider {
+ public:
+  RecordingProvider(const FleetDevice& device, atomic<int>& open_sessions,
+                    mutex& seen_mutex, set<Entity*>& seen)
+      : MockDeviceProvider{device, chrono::microseconds{0}, open_sessions},
+        seen_mutex(seen_mutex),
+        seen(seen) {}
+
+  shared_ptr<Entity> execute_operation(const string&, Entity& entity,
+                                       map<string, string>) {
+    lock_guard<mutex> guard{seen_mutex};
+    seen.insert(&entity);
+    return nullptr;
+  }
+
+  mutex& seen_mutex;
+  set<Entity*>& seen;
+};
+
+class CopiedEntity : public Entity {
+ public:
+  CopiedEntity() : name{YType::str, "name"} {
+    yang_name = "copied";
+    is_top_level_class = true;
+  }
+
+  bool has_data() const { return name.is_set; }
+  bool has_operation() const { return false; }
+  std::string get_segment_path() const { return "copied"; }
+  std::vector<std::pair<std::string, LeafData>> get_name_leaf_data() const {
+    return {name.get_name_leafdata()};
+  }
+  std::shared_ptr<Entity> get_child_by_name(const std::string&,
+                                            const std::string&) {
+    return nullptr;
+  }
+  bool has_leaf_or_child_of_name(const std::string&) const { return false; }
+  void set_filter(const std::string&, YFilter) {}
+  void set_child_by_name(const std::string&, std::shared_ptr<Entity>) {}
+  void set_value(const std::string&, const std::string& value,
+                 const std::string&, const std::string&) {
+    name = value;
+  }
+  std::map<std::string, std::shared_ptr<Entity>> get_children() const {
+    return {};
+  }
+
+  std::shared_ptr<Entity> deep_clone() const override {
+    if (!copyable) return nullptr;
+    auto clone = make_entity<CopiedEntity>();
+    clone->name.assign(name);
+    return clone;
+  }
+
+  YLeaf name;
+  bool copyable = true;
+};
+
+// One end of a NETCONF session over TCP
+class NetconfSocket {
+ public:
+  explicit NetconfSocket(int fd) : fd{fd} {}
+  ~NetconfSocket() {
+    if (fd >= 0) close(fd);
+  }
+
+  void send(const string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+      auto n = ::send(fd, data.data() + sent, data.size() - sent, 0);
+      if (n <= 0) throw YClientError{"Connection closed"};
+      sent += n;
+    }
+  }
+
+  // Reads the next message, which ends with framing
+  bool receive(const string& framing, string& message) {
+    char buffer[4096];
+    size_t end;
+    while ((end = pending.find(framing)) == string::npos) {
+      auto n = recv(fd, buffer, sizeof(buffer), 0);
+      if (n <= 0) return false;
+      pending.append(buffer, n);
+    }
+    message = pending.substr(0, end + framing.size());
+    pending.erase(0, end + framing.size());
+    return true;
+  }
+
+  int fd;
+
+ private:
+  string pending;
+};
+
+static const char STAND_IN_HELLO[] =
+    "<hello xmlns=\"urn:ietf:params:xml:ns:netconf:base:1.0\">"
+    "<capabilities><capability>urn:ietf:params:netconf:base:1.1"
+    "</capability></capabilities></hello>]]>]]>";
+
+// Stands in for a NETCONF device listening on its own local port. It speaks
+// NETCONF 1.1 over TCP and answers every RPC with an empty reply after the
+// given latency.
+class NetconfStandIn {
+ public:
+  explicit NetconfStandIn(chrono::microseconds latency) : latency{latency} {
+    listener = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t length = sizeof(address);
+    if (listener < 0 ||
+        ::bind(listener, (sockaddr*)&address, sizeof(address)) != 0 ||
+        listen(listener, 16) != 0 ||
+        getsockname(listener, (sockaddr*)&address, &length) != 0) {
+      throw YClientError{"Cannot listen on a local port"};
+    }
+    port = ntohs(address.sin_port);
+    acceptor = thread{&NetconfStandIn::accept_sessions, this};
+  }
+
+  ~NetconfStandIn() {
+    // wakes up accept()
+    shutdown(listener, SHUT_RDWR);
+    close(listener);
+    acceptor.join();
+  }
+
+  int port;
+
+ private:
+  void accept_sessions() {
+    vector<thread> sessions;
+    int fd;
+    while ((fd = accept(listener, nullptr, nullptr)) >= 0) {
+      sessions.emplace_back(&NetconfStandIn::serve, this, fd);
+    }
+    // the clients close their sessions before the stand-in goes
+    for (auto& session : sessions) session.join();
+  }
+
+  void serve(int fd) {
+    NetconfSocket session{fd};
+    string message;
+    session.send(STAND_IN_HELLO);
+    if (!session.receive("]]>]]>", message)) return;
+    try {
+      while (session.receive("\n##\n", message)) {
+        this_thread::sleep_for(latency);
+        auto id = message.find("message-id=\"");
+        auto id_end = message.find('"', id + 12);
+        string reply =
+            "<rpc-reply xmlns=\"urn:ietf:params:xml:ns:netconf:base:1.0\" " +
+            message.substr(id, id_end + 1 - id) + "><data/></rpc-reply>";
+        session.send("\n#" + to_string(reply.size()) + "\n" + reply +
+                     "\n##\n");
+      }
+    } catch (YClientError&) {
+      // the client went away
+    }
+  }
+
+  int listener;
+  thread acceptor;
+  chrono::microseconds latency;
+};
+
+// Client of a NetconfStandIn, which sends a <get> for every operation
+class NetconfStandInProvider : public MockDeviceProvider {
+ public:
+  NetconfStandInProvider(const FleetDevice& device, atomic<int>& open_sessions)
+      : MockDeviceProvider{device, chrono::microseconds{0}, open_sessions},
+        session{socket(AF_INET, SOCK_STREAM, 0)},
+        message_id{0} {
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(device.port);
+    inet_pton(AF_INET, device.address.c_str(), &address.sin_addr);
+    string hello;
+    if (session.fd < 0 ||
+        connect(session.fd, (sockaddr*)&address, sizeof(address)) != 0 ||
+        !session.receive("]]>]]>", hello) ||
+        hello.find("urn:ietf:params:netconf:base:1.1") == string::npos) {
+      throw YClientError{"Connection refused"};
+    }
+    session.send(STAND_IN_HELLO);
+  }
+
+  shared_ptr<Entity> execute_operation(const string&, Entity&,
+                                       map<string, string>) {
+    get();
+    return nullptr;
+  }
+
+  vector<shared_ptr<Entity>> execute_operation(const string&, vector<Entity*>,
+                                               map<string, string>) {
+    get();
+    return {};
+  }
+
+ private:
+  void get() {
+    auto id = "\"" + to_string(++message_id) + "\"";
+    string rpc =
+        "<rpc xmlns=\"urn:ietf:params:xml:ns:netconf:base:1.0\" "
+        "message-id=" + id + "><get/></rpc>";
+    session.send("\n#" + to_string(rpc.size()) + "\n" + rpc + "\n##\n");
+    string reply;
+    if (!session.receive("\n##\n", reply) ||
+        reply.find("message-id=" + id) == string::npos) {
+      throw YClientError{"No reply from " + device.name};
+    }
+  }
+
+  NetconfSocket session;
+  unsigned long message_id;
+};
+}  // namespace
+
+static vector<FleetDevice> create_inventory(int count) {
+  vector<FleetDevice> devices;
+  for (int i = 0; i < count; i++) {
+    devices.emplace_back("router" + to_string(i), "127.0.0.1", "admin",
+                         "admin", 12022 + i, "tcp");
+  }
+  return devices;
+}
+
+static ServiceProviderFactory mock_factory(chrono::microseconds latency,
+                                           atomic<int>& open_sessions,
+                                           atomic<int>& connects) {
+  return [latency, &open_sessions,
+          &connects](const FleetDevice& device) -> unique_ptr<ServiceProvider> {
+    connects++;
+    return unique_ptr<ServiceProvider>(
+        new MockDeviceProvider(device, latency, open_sessions));
+  };
+}
+
+static ServiceProviderFactory netconf_stand_in_factory(
+    atomic<int>& open_sessions, atomic<int>& connects) {
+  return [&open_sessions,
+          &connects](const FleetDevice& device) -> unique_ptr<ServiceProvider> {
+    connects++;
+    return unique_ptr<ServiceProvider>(
+        new NetconfStandInProvider(device, open_sessions));
+  };
+}
+
+static vector<FleetDevice> create_stand_in_inventory(
+    const vector<unique_ptr<NetconfStandIn>>& stand_ins) {
+  vector<FleetDevice> devices;
+  for (size_t i = 0; i < stand_ins.size(); i++) {
+    devices.emplace_back("router" + to_string(i), "127.0.0.1", "admin",
+                         "admin", stand_ins[i]->port, "tcp");
+  }
+  return devices;
+}
+
+static shared_ptr<Entity> netconf_get(ServiceProvider& provider) {
+  vector<Entity*> filters;
+  provider.execute_operation("read", filters, {});
+  return nullptr;
+}
+
+static shared_ptr<Entity> mock_read(ServiceProvider& provider) {
+  if (provider.get_provider_type() == "router13") {
+    throw YServiceError{"Device rejected request"};
+  }
+  vector<Entity*> filters;
+  provider.execute_operation("read", filters, {});
+  return nullptr;
+}
+
+TEST_CASE("fleet_executor_results_per_device") {
+  atomic<int> open_sessions{0}, connects{0};
+  FleetExecutor executor{
+      mock_factory(chrono::microseconds{100}, open_sessions, connects), 4, 8};
+  auto devices = create_inventory(40);
+  devices[7].port = 0;
+
+  mutex seen_mutex;
+  vector<string> seen;
+  auto results = executor.execute(devices, mock_read,
+                                  [&](const FleetResult& result) {
+                                    lock_guard<mutex> guard{seen_mutex};
+                                    seen.push_back(result.device);
+                                  });
+
+  REQUIRE(results.size() == devices.size());
+  REQUIRE(seen.size() == devices.size());
+  for (size_t i = 0; i < devices.size(); i++) {
+    REQUIRE(results[i].device == devices[i].name);
+    REQUIRE(results[i].succeeded == (i != 7 && i != 13));
+  }
+  REQUIRE(results[7].error == "Connection refused");
+  REQUIRE(results[13].error == "Device rejected request");
+  REQUIRE(open_sessions <= 8);
+  REQUIRE(executor.get_session_count() <= 8);
+}
+
+TEST_CASE("fleet_executor_reuses_sessions") {
+  atomic<int> open_sessions{0}, connects{0};
+  FleetExecutor executor{
+      mock_factory(chrono::microseconds{0}, open_sessions, connects), 4, 16};
+  auto devices = create_inventory(16);
+
+  executor.execute(devices, mock_read);
+  REQUIRE(connects == 16);
+  executor.execute(devices, mock_read);
+  REQUIRE(connects == 16);
+  REQUIRE(open_sessions == 16);
+
+  // a larger fleet recycles the least recently used sessions
+  executor.execute(create_inventory(32), mock_read);
+  REQUIRE(open_sessions == 16);
+  REQUIRE(executor.get_session_count() == 16);
+}
+
+TEST_CASE("fleet_executor_callback_error") {
+  atomic<int> open_sessions{0}, connects{0};
+  FleetExecutor executor{
+      mock_factory(chrono::microseconds{0}, open_sessions, connects), 4, 8};
+  auto devices = create_inventory(20);
+
+  atomic<int> calls{0};
+  REQUIRE_THROWS_AS(
+      executor.execute(devices, mock_read,
+                       [&](const FleetResult& result) {
+                         calls++;
+                         if (result.device == "router3") {
+                           throw YServiceError{"Callback failed"};
+                         }
+                       }),
+      YServiceError);
+  REQUIRE(calls == 20);
+
+  // the workers are still there
+  REQUIRE(executor.execute(devices, mock_read).size() == devices.size());
+}
+
+TEST_CASE("fleet_executor_copies_entity_per_device") {
+  atomic<int> open_sessions{0};
+  mutex seen_mutex;
+  set<Entity*> seen;
+  FleetExecutor executor{
+      [&](const FleetDevice& device) -> unique_ptr<ServiceProvider> {
+        return unique_ptr<ServiceProvider>(
+            new RecordingProvider(device, open_sessions, seen_mutex, seen));
+      },
+      4, 8};
+  auto devices = create_inventory(8);
+
+  CopiedEntity entity{};
+  entity.name = "config";
+  auto results = executor.create(devices, entity);
+  for (auto& result : results) {
+    REQUIRE(result.succeeded);
+  }
+  REQUIRE(!seen.empty());
+  REQUIRE(seen.count(&entity) == 0);
+
+  entity.copyable = false;
+  REQUIRE_THROWS_AS(executor.create(devices, entity), YInvalidArgumentError);
+}
+
+TEST_CASE("fleet_executor_netconf_stand_in") {
+  vector<unique_ptr<NetconfStandIn>> stand_ins;
+  for (int i = 0; i < 4; i++) {
+    stand_ins.emplace_back(new NetconfStandIn{chrono::microseconds{0}});
+  }
+  auto devices = create_stand_in_inventory(stand_ins);
+
+  atomic<int> open_sessions{0}, connects{0};
+  FleetExecutor executor{netconf_stand_in_factory(open_sessions, connects), 2,
+                         8};
+  for (int round = 0; round < 2; round++) {
+    for (auto& result : executor.execute(devices, netconf_get)) {
+      REQUIRE(result.succeeded);
+    }
+  }
+  REQUIRE(connects == 4);
+}
+
+TEST_CASE("fleet_executor_throughput", "[.benchmark]") {
+  // one NETCONF stand-in per device, each on its own local port
+  const int device_count = 200;
+  const chrono::microseconds latency{2000};
+  vector<unique_ptr<NetconfStandIn>> stand_ins;
+  for (int i = 0; i < device_count; i++) {
+    stand_ins.emplace_back(new NetconfStandIn{latency});
+  }
+  auto devices = create_stand_in_inventory(stand_ins);
+
+  for (size_t threads : {1, 8, 32, 128}) {
+    atomic<int> open_sessions{0}, connects{0};
+    FleetExecutor executor{netconf_stand_in_factory(open_sessions, connects),
+                           threads, 256};
+    for (int round = 0; round < 2; round++) {
+      auto start = chrono::steady_clock::now();
+      auto results = executor.execute(devices, netconf_get);
+      auto seconds =
+          chrono::duration<double>(chrono::steady_clock::now() - start)
+              .count();
+      for (auto& result : results) {
+        REQUIRE(result.succeeded);
+      }
+      cout << threads << " threads, " << (round ? "pooled" : "new")
+           << " sessions: " << device_count / seconds << " devices/s, "
+           << connects << " connects" << endl;
+    }
+  }
+}
@@ -0,0 +1,150 @@
+/// YANG Development Kit
+// Copyright 2016 Cisco Systems. All rights reserved
+//
+////////////////////////////////////////////////////////////////
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+//////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#include "../src/path/path_private.hpp"
+#include "catch.hpp"
+#include "config.hpp"
+#include "mock_data.hpp"
+
+using namespace ydk;
+using namespace std;
+
+static const string json_interfaces_payload = R"({
+  "openconfig-interfaces:interfaces": {
+    "interface": [
+      {
+        "name": "Loopback10",
+        "config": {
+          "name": "Loopback10"
+        }
+      }
+    ]
+  }
+}
+)";
+
+static const string json_bgp_payload = R"({
+  "openconfig-bgp:bgp": {
+    "global": {
+      "config": {
+        "as": 65172
+      }
+    }
+  }
+}
+)";
+
+static const string xml_runner_payload =
+    "<runner xmlns=\"http://cisco.com/ns/yang/ydktest-sanity\"><ytypes>"
+    "<built-in-t><number8>10</number8></built-in-t></ytypes></runner>";
+
+// Mixes lookups, data creation and decoding on a schema that starts empty,
+// so the threads race to load the same modules on demand.
+static void exercise_root_schema(path::RootSchemaNode& schema, int thread_id,
+                                 int iterations, atomic<int>& failures) {
+  path::Codec codec{};
+  for (int i = 0; i < iterations; i++) {
+    try {
+      switch ((thread_id + i) % 4) {
+        case 0: {
+          auto dn = codec.decode(schema, json_bgp_payload,
+                                 EncodingFormat::JSON);
+          if (!dn || codec.encode(*dn, EncodingFormat::JSON, false).empty())
+            failures++;
+          break;
+        }
+        case 1: {
+          auto dn = codec.decode(schema, xml_runner_payload,
+                                 EncodingFormat::XML);
+          if (!dn) failures++;
+          break;
+        }
+        case 2: {
+          auto& dn = schema.create_datanode(
+              "openconfig-interfaces:interfaces/interface[name='Loopback" +
+                  to_string(thread_id) + "']",
+              "");
+          if (dn.get_path().empty()) failures++;
+          break;
+        }
+        default: {
+          if (schema.find("openconfig-bgp:bgp/global/config/as").empty())
+            failures++;
+          if (schema.find("ydktest-sanity:runner/ytypes").empty()) failures++;
+          break;
+        }
+      }
+    } catch (YError& e) {
+      cerr << "Thread " << thread_id << ": " << e.what() << endl;
+      failures++;
+    }
+  }
+}
+
+static double run_concurrent(path::RootSchemaNode& schema, int threads,
+                             int iterations, atomic<int>& failures) {
+  vector<thread> workers;
+  auto start = chrono::steady_clock::now();
+  for (int t = 0; t < threads; t++) {
+    workers.emplace_back(exercise_root_schema, ref(schema), t, iterations,
+                         ref(failures));
+  }
+  for (auto& w : workers) w.join();
+  return chrono::duration<double>(chrono::steady_clock::now() - start)
+      .count();
+}
+
+TEST_CASE("root_schema_concurrent_on_demand_loading") {
+  mock::MockSession sp{TEST_HOME, {}};
+  auto& schema = sp.get_root_schema();
+  atomic<int> failures{0};
+
+  run_concurrent(schema, 8, 40, failures);
+
+  REQUIRE(failures == 0);
+  path::Codec codec{};
+  auto dn = codec.decode_json_output(
+      schema, {json_interfaces_payload, json_bgp_payload});
+  REQUIRE(codec.encode(*dn, EncodingFormat::JSON, true) ==
+          json_interfaces_payload + json_bgp_payload);
+}
+
+TEST_CASE("root_schema_concurrent_scaling", "[.benchmark]") {
+  mock::MockSession sp{TEST_HOME, test_openconfig};
+  auto& schema = sp.get_root_schema();
+  const int operations = 4000;
+
+  for (int threads : {1, 2, 4, 8}) {
+    atomic<int> failures{0};
+    auto seconds =
+        run_concurrent(schema, threads, operations / threads, failures);
+    REQUIRE(failures == 0);
+    cout << threads << " threads: " << operations / seconds << " ops/s"
+         << endl;
+  }
+}
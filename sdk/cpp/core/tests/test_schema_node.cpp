@@ -0,0 +1,71 @@
+/// YANG Development Kit
+// Copyright 2016 Cisco Systems. All rights reserved
+//
+////////////////////////////////////////////////////////////////
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+//////////////////////////////////////////////////////////////////
+
+#include "../src/path/path_private.hpp"
+#include "catch.hpp"
+#include "config.hpp"
+#include "mock_data.hpp"
+
+using namespace ydk;
+using namespace std;
+
+TEST_CASE("lazy_schema_node_children") {
+  path::Repository repo{TEST_HOME};
+  auto schema = repo.create_root_schema(test_openconfig_lookup, {});
+
+  // looking up a deep node wraps its ancestors on the way
+  auto found = schema->find("openconfig-bgp:bgp/global/config/as");
+  REQUIRE(found.size() == 1);
+  auto as = found[0];
+  REQUIRE(as->get_statement().arg == "as");
+  REQUIRE(as->get_children().empty());
+  REQUIRE(as->get_parent()->get_statement().arg == "config");
+  REQUIRE(&as->get_root() == schema.get());
+
+  auto global = as->get_parent()->get_parent();
+  bool has_config = false;
+  for (auto& c : global->get_children()) {
+    if (c.get() == as->get_parent()) has_config = true;
+  }
+  REQUIRE(has_config);
+
+  auto list = schema->find("openconfig-interfaces:interfaces/interface")[0];
+  auto keys = list->get_keys();
+  REQUIRE(keys.size() == 1);
+  REQUIRE(keys[0].arg == "name");
+}
+
+TEST_CASE("schema_node_lookup_cached") {
+  path::Repository repo{TEST_HOME};
+  auto schema = repo.create_root_schema(test_openconfig_lookup, {});
+
+  // a node wrapped by populating its parent is found as that wrapper
+  auto config = schema->find("openconfig-bgp:bgp/global/config")[0];
+  path::SchemaNode* as = nullptr;
+  for (auto& c : config->get_children()) {
+    if (c->get_statement().arg == "as") as = c.get();
+  }
+  REQUIRE(as != nullptr);
+  REQUIRE(schema->find("openconfig-bgp:bgp/global/config/as")[0] == as);
+  REQUIRE(schema->find("openconfig-bgp:bgp/global/config/as")[0] == as);
+}
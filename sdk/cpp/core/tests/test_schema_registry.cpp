@@ -0,0 +1,319 @@
+/// YANG Development Kit
+// Copyright 2016 Cisco Systems. All rights reserved
+//
+////////////////////////////////////////////////////////////////
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+//////////////////////////////////////////////////////////////////
+
+#include <arpa/inet.h>
+#include <ftw.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+#include "../src/errors.hpp"
+#include "../src/path/path_private.hpp"
+#include "catch.hpp"
+#include "config.hpp"
+#include "mock_data.hpp"
+
+using namespace ydk;
+using namespace std;
+
+static shared_ptr<path::RootSchemaNode> create_test_root_schema(
+    path::ModelCachingOption caching_option,
+    const vector<path::Capability>& caps) {
+  path::Repository repo{TEST_HOME, caching_option};
+  return repo.create_root_schema(test_openconfig_lookup, caps);
+}
+
+static long get_resident_memory_kb() {
+  long pages = 0, resident = 0;
+  ifstream statm{"/proc/self/statm"};
+  statm >> pages >> resident;
+  return resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+TEST_CASE("shared_root_schema_same_capabilities") {
+  auto reordered = test_openconfig;
+  reverse(reordered.begin(), reordered.end());
+
+  auto s1 = create_test_root_schema(path::ModelCachingOption::SHARED,
+                                    test_openconfig);
+  auto s2 = create_test_root_schema(path::ModelCachingOption::SHARED,
+                                    reordered);
+  REQUIRE(s1.get() != s2.get());
+  REQUIRE(&s1->get_root() == &s2->get_root());
+
+  auto& bgp = s2->create_datanode("openconfig-bgp:bgp", "");
+  bgp.create_datanode("global/config/as", "65172");
+  path::Codec codec{};
+  REQUIRE(!codec.encode(bgp, EncodingFormat::XML, false).empty());
+
+  // the data trees of a session are its own
+  REQUIRE(path::get_root_schema_impl(*s1).m_root_data_nodes.empty());
+}
+
+TEST_CASE("shared_root_schema_concurrent") {
+  // the first caller compiles, the others wait for its schema
+  vector<shared_ptr<path::RootSchemaNode>> schemas(4);
+  vector<thread> threads;
+  for (auto& schema : schemas) {
+    threads.emplace_back([&schema] {
+      schema = create_test_root_schema(path::ModelCachingOption::SHARED,
+                                       test_openconfig);
+    });
+  }
+  for (auto& t : threads) t.join();
+  for (auto& schema : schemas) {
+    REQUIRE(&schema->get_root() == &schemas[0]->get_root());
+  }
+}
+
+TEST_CASE("shared_root_schema_different_capabilities") {
+  vector<path::Capability> caps{test_openconfig};
+  caps.back().features.push_back("test-feature");
+
+  auto s1 = create_test_root_schema(path::ModelCachingOption::SHARED,
+                                    test_openconfig);
+  auto s2 = create_test_root_schema(path::ModelCachingOption::SHARED, caps);
+  auto s3 = create_test_root_schema(path::ModelCachingOption::PER_DEVICE,
+                                    test_openconfig);
+  REQUIRE(&s1->get_root() != &s2->get_root());
+  REQUIRE(&s1->get_root() != &s3->get_root());
+}
+
+TEST_CASE("shared_root_schema_released") {
+  auto& registry = path::SchemaRegistry::get_instance();
+  auto before = registry.size();
+  {
+    auto s1 = create_test_root_schema(path::ModelCachingOption::SHARED,
+                                      test_openconfig);
+    REQUIRE(registry.size() == before + 1);
+  }
+  REQUIRE(registry.size() == before);
+}
+
+static const char RESTCONF_CAPABILITIES[] =
+    "<capabilities xmlns=\"urn:ietf:params:xml:ns:yang:"
+    "ietf-restconf-monitoring\">"
+    "<capability>http://openconfig.net/yang/bgp?module=openconfig-bgp&amp;"
+    "revision=2016-06-21</capability>"
+    "<capability>http://openconfig.net/yang/interfaces?"
+    "module=openconfig-interfaces&amp;revision=2016-05-26</capability>"
+    "</capabilities>";
+
+// Stands in for a RESTCONF server on a local port. It answers the
+// capabilities request of a session and nothing else.
+class RestconfStandIn {
+ public:
+  RestconfStandIn() {
+    listener = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t length = sizeof(address);
+    if (listener < 0 ||
+        ::bind(listener, (sockaddr*)&address, sizeof(address)) != 0 ||
+        listen(listener, 16) != 0 ||
+        getsockname(listener, (sockaddr*)&address, &length) != 0) {
+      throw YClientError{"Cannot listen on a local port"};
+    }
+    port = ntohs(address.sin_port);
+    acceptor = thread{&RestconfStandIn::accept_requests, this};
+  }
+
+  ~RestconfStandIn() {
+    // wakes up accept()
+    shutdown(listener, SHUT_RDWR);
+    close(listener);
+    acceptor.join();
+  }
+
+  int port;
+
+ private:
+  // one request per connection, the replies close it
+  void accept_requests() {
+    int fd;
+    while ((fd = accept(listener, nullptr, nullptr)) >= 0) {
+      string request;
+      char buffer[4096];
+      ssize_t n;
+      while (request.find("\r\n\r\n") == string::npos &&
+             (n = recv(fd, buffer, sizeof(buffer), 0)) > 0) {
+        request.append(buffer, n);
+      }
+      string reply = "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\n"
+                     "Connection: close\r\n\r\n";
+      if (request.find("/capabilities ") != string::npos) {
+        reply = string{"HTTP/1.1 200 OK\r\n"
+                       "Content-Type: application/xml\r\n"
+                       "Connection: close\r\nContent-Length: "} +
+                to_string(sizeof(RESTCONF_CAPABILITIES) - 1) + "\r\n\r\n" +
+                RESTCONF_CAPABILITIES;
+      }
+      send(fd, reply.data(), reply.size(), 0);
+      close(fd);
+    }
+  }
+
+  int listener;
+  thread acceptor;
+};
+
+TEST_CASE("shared_root_schema_restconf_sessions") {
+  RestconfStandIn device{};
+  path::Repository repo{TEST_HOME, path::ModelCachingOption::SHARED};
+
+  path::RestconfSession s1{repo, "127.0.0.1", "admin", "admin", device.port};
+  path::RestconfSession s2{repo, "127.0.0.1", "admin", "admin", device.port};
+  REQUIRE(&s1.get_root_schema() != &s2.get_root_schema());
+  REQUIRE(&s1.get_root_schema().get_root() ==
+          &s2.get_root_schema().get_root());
+  REQUIRE(s2.get_root_schema().find("openconfig-bgp:bgp").size() == 1);
+}
+
+TEST_CASE("shared_root_schema_memory", "[.benchmark]") {
+  const int sessions = 100;
+  for (auto option : {path::ModelCachingOption::PER_DEVICE,
+                      path::ModelCachingOption::SHARED}) {
+    vector<shared_ptr<path::RootSchemaNode>> schemas;
+    auto start = get_resident_memory_kb();
+    for (int i = 0; i < sessions; i++) {
+      schemas.push_back(create_test_root_schema(option, test_openconfig));
+    }
+    auto used = get_resident_memory_kb() - start;
+    cout << (option == path::ModelCachingOption::SHARED ? "shared"
+                                                        : "per-device")
+         << ": " << sessions << " sessions, " << used << " kB resident, "
+         << used / sessions << " kB per session" << endl;
+  }
+}
+
+TEST_CASE("root_schema_creation_time", "[.benchmark]") {
+  const int sessions = 20;
+  vector<shared_ptr<path::RootSchemaNode>> schemas;
+  auto start = chrono::steady_clock::now();
+  auto start_kb = get_resident_memory_kb();
+  for (int i = 0; i < sessions; i++) {
+    schemas.push_back(create_test_root_schema(
+        path::ModelCachingOption::PER_DEVICE, test_openconfig));
+  }
+  auto seconds =
+      chrono::duration<double>(chrono::steady_clock::now() - start).count();
+  auto used = get_resident_memory_kb() - start_kb;
+  cout << "root schema: " << seconds * 1000 / sessions << " ms, "
+       << used / sessions << " kB per session" << endl;
+}
+
+static int remove_entry(const char* path, const struct stat*, int,
+                        struct FTW*) {
+  return remove(path);
+}
+
+// Directory of models, removed with its content at the end of the test
+class TempModelDir {
+ public:
+  TempModelDir() {
+    char dir_template[] = "/tmp/ydk-test-models-XXXXXX";
+    if (mkdtemp(dir_template) == nullptr) {
+      throw runtime_error{"Cannot create a model directory"};
+    }
+    path = dir_template;
+  }
+
+  ~TempModelDir() {
+    nftw(path.c_str(), remove_entry, 16, FTW_DEPTH | FTW_PHYS);
+  }
+
+  string path;
+};
+
+static void write_augment_module(const string& dir, int index,
+                                 int containers) {
+  ofstream aug{dir + "/augment-bench-" + to_string(index) + ".yang"};
+  aug << "module augment-bench-" << index << " {\n"
+      << "  namespace \"urn:augment-bench-" << index << "\";\n"
+      << "  prefix aug" << index << ";\n"
+      << "  import augment-bench-base { prefix base; }\n"
+      << "  augment \"/base:root/base:c" << index % containers << "\" {\n"
+      << "    leaf value" << index << " { type string; }\n"
+      << "  }\n}\n";
+}
+
+static void write_augment_bundle(const string& dir, int containers,
+                                 int augments) {
+  ofstream base{dir + "/augment-bench-base.yang"};
+  base << "module augment-bench-base {\n"
+       << "  namespace \"urn:augment-bench-base\";\n"
+       << "  prefix base;\n"
+       << "  container root {\n";
+  for (int i = 0; i < containers; i++)
+    base << "    container c" << i << " { leaf name { type string; } }\n";
+  base << "  }\n}\n";
+
+  for (int i = 0; i < augments; i++) write_augment_module(dir, i, containers);
+}
+
+TEST_CASE("lazy_schema_retries_failed_module") {
+  TempModelDir dir{};
+  write_augment_bundle(dir.path, 1, 0);
+
+  path::Repository repo{dir.path, path::ModelCachingOption::PER_DEVICE};
+  auto schema = repo.create_root_schema({}, {{"augment-bench-base", ""}});
+  const string path = "augment-bench-base:root/c0/augment-bench-0:value0";
+
+  // the augmenting module is not in the repository yet
+  REQUIRE(schema->find(path).empty());
+
+  write_augment_module(dir.path, 0, 1);
+  auto found = schema->find(path);
+  REQUIRE(found.size() == 1);
+  REQUIRE(found[0]->get_statement().arg == "value0");
+}
+
+TEST_CASE("augment_population_load_time", "[.benchmark]") {
+  const int containers = 2000, augments = 1000;
+  TempModelDir dir{};
+  write_augment_bundle(dir.path, containers, augments);
+
+  path::Repository repo{dir.path, path::ModelCachingOption::PER_DEVICE};
+  auto schema = repo.create_root_schema({}, {{"augment-bench-base", ""}});
+  // wrap the augment targets so that every load populates augmented nodes
+  for (int i = 0; i < containers; i++)
+    schema->find("augment-bench-base:root/c" + to_string(i));
+
+  auto start = chrono::steady_clock::now();
+  for (int i = 0; i < augments; i++) {
+    auto found = schema->find("augment-bench-base:root/c" +
+                              to_string(i % containers) + "/augment-bench-" +
+                              to_string(i) + ":value" + to_string(i));
+    REQUIRE(found.size() == 1);
+  }
+  auto seconds =
+      chrono::duration<double>(chrono::steady_clock::now() - start).count();
+  cout << augments << " augmenting modules loaded in " << seconds * 1000
+       << " ms" << endl;
+}
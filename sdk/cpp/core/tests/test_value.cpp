@@ -1,5 +1,6 @@
 #include <spdlog/spdlog.h>
 
+#include <chrono>
 #include <iostream>
 
 #include "../src/errors.hpp"
@@ -13,6 +14,18 @@ class TestIdentity1 : public Identity {
   TestIdentity1() : Identity("http://test.com", "test", "test-identity") {}
 };
 
+// resolves its names once, as a generated identity does
+class TestIdentity2 : public virtual Identity {
+ public:
+  TestIdentity2() : Identity(get_identity_handle()) {}
+
+  static const IdentityHandle& get_identity_handle() {
+    static const IdentityHandle handle{"http://test.com", "test",
+                                       "test:test-identity2"};
+    return handle;
+  }
+};
+
 class TestEnum1 : public Enum {
  public:
   TestEnum1() {}
@@ -152,6 +165,72 @@ TEST_CASE("test_bits_assign") {
   REQUIRE(test_value.get() == "bit1 bit2 bit4");
 }
 
+TEST_CASE("test_bits_schema") {
+  SchemaNameList bit_names{"auto-sense-speed", "bit1", "bit2"};
+  YLeaf test_value{YType::bits, "bits-field", bit_names};
+  REQUIRE(test_value.get() == "");
+  test_value["bit2"] = true;
+  test_value["auto-sense-speed"] = true;
+  // not in the schema
+  test_value["other"] = true;
+  REQUIRE(test_value.get() == "auto-sense-speed bit2 other");
+  test_value["bit2"] = false;
+  REQUIRE(test_value.get() == "auto-sense-speed other");
+  REQUIRE(test_value["auto-sense-speed"]);
+  REQUIRE(!test_value["bit1"]);
+
+  Bits by_name{};
+  by_name["other"] = true;
+  by_name["auto-sense-speed"] = true;
+  by_name["bit1"] = false;
+  by_name["bit2"] = false;
+  REQUIRE(by_name.get_bitmap() == test_value.bits_value->get_bitmap());
+  YLeaf assigned{YType::bits, "bits-field", bit_names};
+  assigned = by_name;
+  REQUIRE(assigned.get() == "auto-sense-speed other");
+  REQUIRE(*assigned.bits_value == *test_value.bits_value);
+
+  YLeaf copy{test_value};
+  REQUIRE(copy.get() == test_value.get());
+  copy["bit1"] = true;
+  REQUIRE(copy.get() == "auto-sense-speed bit1 other");
+  REQUIRE(test_value.get() == "auto-sense-speed other");
+}
+
+TEST_CASE("test_bits_schema_words") {
+  std::vector<std::string> names;
+  for (int i = 0; i < 150; i++) {
+    names.push_back("bit" + std::to_string(1000 + i));
+  }
+  YLeaf test_value{YType::bits, "bits-field", names};
+  Bits by_name{};
+  for (std::size_t i = 0; i < names.size(); i += 7) {
+    test_value[names[i]] = true;
+    by_name[names[i]] = true;
+  }
+  Bits copy{*test_value.bits_value};
+  REQUIRE(copy == *test_value.bits_value);
+  REQUIRE(copy.to_string() == by_name.to_string());
+  copy[names[141]] = true;
+  REQUIRE(copy != *test_value.bits_value);
+  REQUIRE(test_value.get() == by_name.to_string());
+}
+
+TEST_CASE("test_identity_handle") {
+  YLeaf test_value{YType::identityref, "name"};
+  test_value = TestIdentity2{};
+  REQUIRE(test_value.get() == "test:test-identity2");
+  REQUIRE(test_value.value_namespace == "http://test.com");
+  REQUIRE(test_value.value_namespace_prefix == "test");
+
+  YLeaf by_name{YType::identityref, "name"};
+  by_name = Identity{"http://test.com", "test", "test:test-identity2"};
+  REQUIRE(by_name == test_value);
+  YLeaf text{YType::identityref, "name"};
+  text = "test:test-identity2";
+  REQUIRE(text == test_value);
+}
+
 TEST_CASE("test_deci64") {
   YLeaf test_value{YType::decimal64, "value"};
   test_value = Decimal64("3.2");
@@ -160,3 +239,179 @@ TEST_CASE("test_deci64") {
   test_value = Decimal64("1.2");
   REQUIRE(test_value.get() == "1.2");
 }
+
+TEST_CASE("test_value_text") {
+  YLeaf int_value{YType::int64, "counter"};
+  int_value = std::string("-9223372036854775807");
+  REQUIRE(int_value.get() == "-9223372036854775807");
+  // text that would not format back the same is kept as it is
+  int_value = std::string("007");
+  REQUIRE(int_value.get() == "007");
+
+  YLeaf uint_value{YType::uint64, "counter"};
+  uint_value = std::string("18446744073709551615");
+  REQUIRE(uint_value.get() == "18446744073709551615");
+  uint_value = static_cast<uint64>(0);
+  REQUIRE(uint_value.get() == "0");
+
+  YLeaf bool_value{YType::boolean, "enabled"};
+  bool_value = std::string("1");
+  REQUIRE(bool_value.get() == "true");
+  bool_value = 2;
+  REQUIRE(bool_value.get() == "2");
+
+  YLeaf decimal_value{YType::decimal64, "rate"};
+  decimal_value = Decimal64("-0.05");
+  REQUIRE(decimal_value.get() == "-0.05");
+  decimal_value = Decimal64("12.340");
+  REQUIRE(decimal_value.get() == "12.340");
+  decimal_value = Decimal64("-0.0");
+  REQUIRE(decimal_value.get() == "-0.0");
+  // decoded text is kept in fixed point as well
+  decimal_value = std::string("2.50");
+  REQUIRE(decimal_value.get() == "2.50");
+  YLeaf decimal_copy{YType::decimal64, "rate"};
+  decimal_copy = Decimal64("2.50");
+  REQUIRE(decimal_copy == decimal_value);
+  // values are compared regardless of the precision they are written with
+  decimal_copy = Decimal64("2.5");
+  REQUIRE(decimal_copy == decimal_value);
+  decimal_copy = Decimal64("2.500");
+  REQUIRE(decimal_copy == decimal_value);
+  decimal_copy = Decimal64("2.05");
+  REQUIRE_FALSE(decimal_copy == decimal_value);
+  decimal_copy = Decimal64("3");
+  decimal_value = Decimal64("3.00");
+  REQUIRE(decimal_copy == decimal_value);
+
+  YLeaf real_value{YType::str, "ratio"};
+  real_value = 3.14159265;
+  REQUIRE(real_value.get() == "3.14159");
+}
+
+TEST_CASE("test_value_compare") {
+  YLeaf first{YType::int32, "number"};
+  YLeaf second{YType::int32, "number"};
+  first = 42;
+  second = std::string("42");
+  REQUIRE(first == second);
+
+  YLeaf text{YType::str, "number"};
+  text = "42";
+  REQUIRE(first == text);
+
+  YLeaf enum_value{YType::enumeration, "enumval"};
+  enum_value = TestEnum1::two;
+  YLeaf copy{enum_value};
+  REQUIRE(copy == enum_value);
+  REQUIRE(copy.get() == "two");
+  REQUIRE(copy.enum_value == 2);
+
+  YLeaf moved{std::move(text)};
+  REQUIRE(moved.get() == "42");
+}
+
+TEST_CASE("test_value_assign") {
+  YLeaf identity{YType::identityref, "name"};
+  identity = TestIdentity1{};
+  identity.yfilter = YFilter::merge;
+  YLeaf target{YType::identityref, "name"};
+  target = "text";
+  target.assign(identity);
+  REQUIRE(target == identity);
+  REQUIRE(target.get() == "test-identity");
+  REQUIRE(target.yfilter == YFilter::merge);
+  REQUIRE(target.value_namespace == "http://test.com");
+  REQUIRE(target.value_namespace_prefix == "test");
+
+  YLeaf bits{YType::bits, "bits-field"};
+  bits["bit1"] = true;
+  YLeaf bits_target{YType::bits, "bits-field"};
+  bits_target.assign(bits);
+  bits["bit2"] = true;
+  REQUIRE(bits_target.get() == "bit1");
+
+  YLeaf unset{YType::identityref, "name"};
+  target.assign(unset);
+  REQUIRE(!target.is_set);
+  REQUIRE(target.yfilter == YFilter::not_set);
+  REQUIRE(target.value_namespace.empty());
+}
+
+TEST_CASE("test_schema_name") {
+  SchemaName name{"number"};
+  REQUIRE(name == "number");
+  REQUIRE(name == std::string("number"));
+  REQUIRE(name != "name");
+  REQUIRE(SchemaName{}.empty());
+
+  // leafs built from the same name share its storage
+  YLeaf first{YType::int32, "number"};
+  YLeaf second{YType::int32, std::string("number")};
+  REQUIRE(first.name == second.name);
+  REQUIRE(&first.name.str() == &second.name.str());
+
+  first = 7;
+  auto name_leaf_data = first.get_name_leafdata();
+  REQUIRE(name_leaf_data.first == "number");
+  REQUIRE(name_leaf_data.second.value == "7");
+}
+
+TEST_CASE("test_value_counters_benchmark", "[.benchmark]") {
+  const int leafs = 1000000;
+  std::vector<YLeaf> counters;
+  counters.reserve(leafs);
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < leafs; i++) {
+    counters.emplace_back(YType::uint64, "in-octets");
+    counters.back() = static_cast<uint64>(1000000007ULL * i);
+  }
+  auto populate = std::chrono::duration<double>(
+                      std::chrono::steady_clock::now() - start)
+                      .count();
+
+  start = std::chrono::steady_clock::now();
+  std::size_t text_size = 0;
+  for (auto& counter : counters) {
+    text_size += counter.get_name_leafdata().second.value.size();
+  }
+  auto format = std::chrono::duration<double>(
+                    std::chrono::steady_clock::now() - start)
+                    .count();
+  REQUIRE(text_size > 0);
+
+  std::cout << leafs << " counters, populate " << populate << " s, format "
+            << format << " s" << std::endl;
+}
+
+TEST_CASE("test_value_bits_identity_benchmark", "[.benchmark]") {
+  const int leafs = 200000;
+  SchemaNameList bit_names{"auto-sense-speed", "bit1", "bit2", "bit3",
+                           "bit4", "bit5", "bit6", "bit7"};
+  std::vector<YLeaf> values;
+  values.reserve(2 * leafs);
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < leafs; i++) {
+    values.emplace_back(YType::bits, "flags", bit_names);
+    values.back()["auto-sense-speed"] = true;
+    values.back()["bit" + std::to_string(1 + i % 7)] = true;
+    values.emplace_back(YType::identityref, "type");
+    values.back() = TestIdentity2{};
+  }
+  auto populate = std::chrono::duration<double>(
+                      std::chrono::steady_clock::now() - start)
+                      .count();
+
+  start = std::chrono::steady_clock::now();
+  std::size_t text_size = 0;
+  for (auto& value : values) {
+    text_size += value.get_name_leafdata().second.value.size();
+  }
+  auto format = std::chrono::duration<double>(
+                    std::chrono::steady_clock::now() - start)
+                    .count();
+  REQUIRE(text_size > 0);
+
+  std::cout << leafs << " bits and identity leafs, populate " << populate
+            << " s, format " << format << " s" << std::endl;
+}
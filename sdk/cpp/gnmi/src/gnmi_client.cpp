@@ -67,19 +67,41 @@ static void check_status(grpc::Status status, const string& message) {
   }
 }
 
+static grpc::ChannelArguments get_channel_arguments(
+    const TransportOptions& options) {
+  grpc::ChannelArguments args;
+  if (options.compression == Compression::gzip) {
+    args.SetCompressionAlgorithm(GRPC_COMPRESS_GZIP);
+  } else if (options.compression == Compression::deflate) {
+    args.SetCompressionAlgorithm(GRPC_COMPRESS_DEFLATE);
+  }
+  if (options.max_receive_message_size != 0) {
+    args.SetMaxReceiveMessageSize(options.max_receive_message_size);
+  }
+  if (options.keepalive_time_ms > 0) {
+    args.SetInt(GRPC_ARG_KEEPALIVE_TIME_MS, options.keepalive_time_ms);
+    args.SetInt(GRPC_ARG_KEEPALIVE_TIMEOUT_MS, options.keepalive_timeout_ms);
+    // subscriptions may stay silent for long
+    args.SetInt(GRPC_ARG_KEEPALIVE_PERMIT_WITHOUT_CALLS, 1);
+    args.SetInt(GRPC_ARG_HTTP2_MAX_PINGS_WITHOUT_DATA, 0);
+  }
+  return args;
+}
+
 static std::shared_ptr<Channel> connect_to_server(
     const std::string& address, int port, const std::string& server_certificate,
-    const std::string& private_key) {
+    const std::string& private_key, const TransportOptions& options) {
   std::ostringstream address_buffer{};
   address_buffer << address << ":" << port;
   auto address_str = address_buffer.str();
+  auto args = get_channel_arguments(options);
 
   if (server_certificate.length() == 0) {
-    return grpc::CreateChannel(address_str, grpc::InsecureChannelCredentials());
+    return grpc::CreateCustomChannel(
+        address_str, grpc::InsecureChannelCredentials(), args);
   }
 
   grpc::SslCredentialsOptions ssl_opts;
-  grpc::ChannelArguments args;
 
   string server_cert;
   ifstream p(server_certificate);
@@ -169,20 +191,23 @@ static string format_notification_response(pair<string, string> prefix_suffix,
 gNMIClient::gNMIClient(const std::string& address, int port,
                        const std::string& username, const std::string& password,
                        const std::string& certificate,
-                       const std::string& private_key)
+                       const std::string& private_key,
+                       const TransportOptions& transport_options)
     : host(address),
       port(port),
       username(username),
       password(password),
       server_certificate(certificate),
-      private_key(private_key) {
+      private_key(private_key),
+      transport_options(transport_options) {
   connect();
 }
 
 gNMIClient::~gNMIClient() {}
 
 int gNMIClient::connect() {
-  auto channel = connect_to_server(host, port, server_certificate, private_key);
+  auto channel = connect_to_server(host, port, server_certificate, private_key,
+                                  transport_options);
   stub_ = gNMI::NewStub(channel);
   return EXIT_SUCCESS;
 }
@@ -313,37 +338,28 @@ GnmiClientCapabilityResponse gNMIClient::execute_get_capabilities() {
   return reply;
 }
 
-static string get_value_from_update(gnmi::Update update) {
-  gnmi::TypedValue value;
-  string value_for_payload;
-
-  if (update.has_val()) {
-    value = update.val();
-    value_for_payload.append(value.json_ietf_val());
-  }
-  return value_for_payload;
+static const string& get_value_from_update(const gnmi::Update& update) {
+  return update.val().json_ietf_val();
 }
 
-static pair<string, string> get_path_from_update(gnmi::Update update) {
+static pair<string, string> get_path_from_update(const gnmi::Update& update) {
   string path_to_prepend;
   string path_to_append;
-  string path_element_to_add;
-  string value = get_value_from_update(update);
+  const string& value = get_value_from_update(update);
 
   if (update.has_path()) {
-    gnmi::Path path = update.path();
+    auto& path = update.path();
     int elem_size = path.elem_size();
     if (elem_size > 0) {
-      string origin = path.origin();
+      auto& origin = path.origin();
       if (origin.length() > 0) {
         path_to_prepend.append("\"" + origin + ":");
       }
       int l;
       for (l = 0; l < elem_size; l++) {
-        path_element_to_add = path.elem(l).name();
         if (l > 0 || path_to_prepend.length() == 0)
           path_to_prepend.append("\"");
-        path_to_prepend.append(path_element_to_add + "\":");
+        path_to_prepend.append(path.elem(l).name() + "\":");
 
         if (l == elem_size - 1 && value.length() > 0) break;
 
@@ -355,7 +371,7 @@ static pair<string, string> get_path_from_update(gnmi::Update update) {
           path_to_prepend.append("[{");
           path_to_append = "}]" + path_to_append;
           string keys_to_append;
-          for (auto key : path.elem(l).key()) {
+          for (auto& key : path.elem(l).key()) {
             const char* ckey = key.second.c_str();
             bool is_number =
                 all_of(key.second.begin(), key.second.end(), ::isdigit);
@@ -389,21 +405,16 @@ static pair<string, string> get_path_from_update(gnmi::Update update) {
   return make_pair(path_to_prepend, path_to_append);
 }
 
-static vector<string> parse_get_response(gnmi::GetResponse* response) {
+static vector<string> parse_get_response(const gnmi::GetResponse& response) {
   vector<string> response_list{};
 
-  for (int i = 0; i < response->notification_size(); ++i) {
-    gnmi::Notification notification = response->notification(i);
-    string path_to_prepend;
+  for (auto& notification : response.notification()) {
     string reply_to_parse;
     string value;
-    if (notification.update_size() != 0) {
-      for (int k = 0; k < notification.update_size(); ++k) {
-        gnmi::Update update = notification.update(k);
-        auto prefix_suffix = get_path_from_update(update);
-        value.append(get_value_from_update(update));
-        reply_to_parse = format_notification_response(prefix_suffix, value);
-      }
+    for (auto& update : notification.update()) {
+      auto prefix_suffix = get_path_from_update(update);
+      value.append(get_value_from_update(update));
+      reply_to_parse = format_notification_response(prefix_suffix, value);
     }
     response_list.push_back(reply_to_parse);
   }
@@ -413,10 +424,17 @@ static vector<string> parse_get_response(gnmi::GetResponse* response) {
 vector<string> gNMIClient::execute_get_operation(
     const std::vector<GnmiClientRequest>& get_request_list,
     const std::string& operation) {
-  gnmi::GetRequest gnmi_get_request;
   gnmi::GetResponse gnmi_get_response;
+  execute_get_operation(get_request_list, operation, gnmi_get_response);
+  return parse_get_response(gnmi_get_response);
+}
 
-  for (auto ydk_request : get_request_list) {
+void gNMIClient::execute_get_operation(
+    const std::vector<GnmiClientRequest>& get_request_list,
+    const std::string& operation, gnmi::GetResponse& gnmi_get_response) {
+  gnmi::GetRequest gnmi_get_request;
+
+  for (auto& ydk_request : get_request_list) {
     // Populate gnmi::GetRequest
     gnmi::Path* path = gnmi_get_request.add_path();
     if (ydk_request.path != nullptr) path->CopyFrom(*ydk_request.path);
@@ -434,9 +452,8 @@ vector<string> gNMIClient::execute_get_operation(
 
   YLOG_INFO("\n=============== Get Request Sent ================\n{}\n",
             gnmi_get_request.DebugString());
-  auto reply = execute_get_payload(gnmi_get_request, &gnmi_get_response);
+  execute_get_payload(gnmi_get_request, &gnmi_get_response);
   YLOG_INFO("Get Operation Succeeded");
-  return reply;
 }
 
 bool gNMIClient::execute_set_operation(
@@ -487,8 +504,16 @@ bool gNMIClient::execute_set_operation(
   return reply;
 }
 
-vector<string> gNMIClient::execute_get_payload(const GetRequest& request,
-                                               GetResponse* response) {
+void gNMIClient::execute_set_operation(const gnmi::SetRequest& request,
+                                       gnmi::SetResponse& response) {
+  YLOG_INFO("\n=============== Set Request Sent ================\n{}\n",
+            request.DebugString());
+  execute_set_payload(request, &response);
+  YLOG_INFO("Set Operation Succeeded");
+}
+
+void gNMIClient::execute_get_payload(const GetRequest& request,
+                                     GetResponse* response) {
   grpc::ClientContext context;
   context.AddMetadata("username", username);
   context.AddMetadata("password", password);
@@ -497,7 +522,6 @@ vector<string> gNMIClient::execute_get_payload(const GetRequest& request,
   YLOG_INFO("\n============= Get Response Received =============\n{}\n",
             response->DebugString().c_str());
   YLOG_DEBUG("Get RPC succeeded");
-  return parse_get_response(response);
 }
 
 bool gNMIClient::execute_set_payload(const SetRequest& request,
@@ -512,12 +536,31 @@ bool gNMIClient::execute_set_payload(const SetRequest& request,
   return true;
 }
 
+string format_subscribe_response(const gnmi::SubscribeResponse& response) {
+  string text;
+  google::protobuf::TextFormat::PrintToString(response, &text);
+  return text;
+}
+
+string gNMIClient::get_last_subscribe_response() {
+  lock_guard<mutex> guard(last_subscribe_mutex);
+  return last_subscribe_response;
+}
+
+gnmi::SubscribeResponse gNMIClient::get_last_subscribe_message() {
+  lock_guard<mutex> guard(last_subscribe_mutex);
+  return last_subscribe_message;
+}
+
+uint64 gNMIClient::get_subscribe_response_count() {
+  lock_guard<mutex> guard(last_subscribe_mutex);
+  return subscribe_response_count;
+}
+
 void gNMIClient::send_poll_request(bool last) {
   gnmi::SubscribeRequest req;
   req.mutable_poll();
-  YLOG_INFO(
-      "\n=============== Sending Poll SubscribeRequest ================\n{}\n",
-      req.DebugString());
+  YLOG_INFO("Sending Poll SubscribeRequest");
   if (last) {
     ::grpc::WriteOptions options{};
     options.set_last_message();
@@ -527,45 +570,68 @@ void gNMIClient::send_poll_request(bool last) {
   }
 }
 
-void poll_thread_callback_control(
-    gNMIClient* client, std::function<bool(const char* response)> poll_func) {
-  YLOG_DEBUG(
-      "Invoking polling/streaming thread control from user defined callback");
-  if (poll_func == nullptr) {
-    // Send poll request just once
-    client->send_poll_request();
-    return;
+bool gNMIClient::wait_for_subscribe_response(
+    uint64 count, std::chrono::milliseconds timeout) {
+  unique_lock<mutex> lock(last_subscribe_mutex);
+  return subscribe_response_received.wait_for(lock, timeout, [&]() {
+    return subscribe_response_count != count || !client_reader_is_active;
+  });
+}
+
+// Waits until a subscribe response arrives after the given count
+static void wait_for_subscribe_response(gNMIClient* client, uint64 count) {
+  if (!client->wait_for_subscribe_response(count, std::chrono::seconds(10))) {
+    YLOG_INFO("Could not receive subscribe response for 10 seconds");
+  } else {
+    YLOG_DEBUG("Received subscribe response");
   }
-  std::thread writer([client, poll_func]() {
-    std::string str_response = client->get_last_subscribe_response();
-    while (poll_func(str_response.c_str())) {
+}
+
+static void run_poll_control(gNMIClient* client,
+                             std::function<bool()> poll_again) {
+  std::thread writer([client, poll_again]() {
+    while (poll_again()) {
       if (!client->client_reader_is_active) {
         YLOG_DEBUG(
             "Client subscription reader is not active. Ending "
             "Polling/Streaming control thread");
         break;
       }
+      auto count = client->get_subscribe_response_count();
       client->send_poll_request();
-
-      // Wait some time for response to arrive
-      int counter = 0;
-      while (client->get_last_subscribe_response() == str_response &&
-             ++counter < 100) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
-      }
-      if (counter >= 100) {
-        YLOG_INFO("Could not receive subscribe response for 10 seconds");
-      } else {
-        YLOG_DEBUG("Received subscribe response in {} milliseconds",
-                   counter * 100);
-        str_response = client->get_last_subscribe_response();
-      }
+      wait_for_subscribe_response(client, count);
     }
     client->client_reader_writer->WritesDone();
   });
   writer.detach();
 }
 
+void poll_thread_callback_control(
+    gNMIClient* client, std::function<bool(const char* response)> poll_func) {
+  YLOG_DEBUG(
+      "Invoking polling/streaming thread control from user defined callback");
+  if (poll_func == nullptr) {
+    // Send poll request just once
+    client->send_poll_request();
+    return;
+  }
+  run_poll_control(client, [client, poll_func]() {
+    return poll_func(client->get_last_subscribe_response().c_str());
+  });
+}
+
+void poll_thread_callback_control(gNMIClient* client,
+                                  GnmiPollCallback poll_func) {
+  YLOG_DEBUG(
+      "Invoking polling/streaming thread control from user defined callback");
+  if (poll_func == nullptr) {
+    client->send_poll_request();
+    return;
+  }
+  run_poll_control(client, [client, poll_func]() {
+    return poll_func(client->get_last_subscribe_message());
+  });
+}
 static string get_current_local_time() {
   time_t now = time(0);
   string cur_time = ctime(&now);
@@ -588,7 +654,6 @@ static void print_prompt(const std::string& list_mode) {
 void poll_thread_cin_control(gNMIClient* client, const std::string& list_mode) {
   YLOG_DEBUG("Invoking polling/streaming thread control from standard input");
   std::thread writer([client, list_mode]() {
-    std::string str_response = client->get_last_subscribe_response();
     string input;
     print_prompt(list_mode);
     while (cin) {
@@ -601,22 +666,9 @@ void poll_thread_cin_control(gNMIClient* client, const std::string& list_mode) {
       cin >> input;
       cout << get_current_local_time() << ": " << input << endl;
       if (input == "poll" && list_mode == "POLL") {
-        string before_poll = client->get_last_subscribe_response();
+        auto count = client->get_subscribe_response_count();
         client->send_poll_request();
-
-        // Wait some time for response to arrive
-        int counter = 0;
-        while (client->get_last_subscribe_response() == str_response &&
-               ++counter < 100) {
-          std::this_thread::sleep_for(std::chrono::milliseconds(100));
-        }
-        if (counter >= 100) {
-          YLOG_INFO("Could not receive subscribe response for 10 seconds");
-        } else {
-          YLOG_DEBUG("Received subscribe response in {} milliseconds",
-                     counter * 100);
-          str_response = client->get_last_subscribe_response();
-        }
+        wait_for_subscribe_response(client, count);
       } else if (input == "last") {
         client->send_poll_request(true);
         break;
@@ -632,16 +684,17 @@ void poll_thread_cin_control(gNMIClient* client, const std::string& list_mode) {
   writer.detach();
 }
 
-void gNMIClient::execute_subscribe_operation(
+void gNMIClient::add_credentials(grpc::ClientContext& context) {
+  context.AddMetadata("username", username);
+  context.AddMetadata("password", password);
+}
+
+gnmi::SubscribeRequest gNMIClient::build_subscribe_request(
     const std::vector<GnmiClientSubscription>& subscription_list, uint32 qos,
-    const std::string& list_mode, const std::string& encoding,
-    std::function<void(const char* response)> out_func,
-    std::function<bool(const char* response)> poll_func) {
-  grpc::ClientContext context;
-  gnmi::SubscribeResponse response{};
+    const std::string& list_mode, const std::string& encoding) {
   gnmi::SubscribeRequest request{};
 
-  gnmi::SubscriptionList* sl = new gnmi::SubscriptionList;
+  gnmi::SubscriptionList* sl = request.mutable_subscribe();
   sl->set_mode(get_sublist_mode(list_mode));
   sl->set_encoding(gnmi::Encoding::PROTO);
   if (encoding == "JSON")
@@ -652,27 +705,68 @@ void gNMIClient::execute_subscribe_operation(
     sl->set_encoding(gnmi::Encoding::BYTES);
   else if (encoding == "ASCII")
     sl->set_encoding(gnmi::Encoding::ASCII);
-
-  gnmi::QOSMarking* qosmarking = new gnmi::QOSMarking;
-  qosmarking->set_marking(qos);
-  sl->set_allocated_qos(qosmarking);
+  sl->mutable_qos()->set_marking(qos);
 
   for (auto subscription : subscription_list) {
     populate_subscribe_request(sl, subscription);
   }
-  request.set_allocated_subscribe(sl);
+  return request;
+}
+
+void gNMIClient::start_subscribe(
+    const std::vector<GnmiClientSubscription>& subscription_list, uint32 qos,
+    const std::string& list_mode, const std::string& encoding,
+    grpc::ClientContext& context) {
+  auto request =
+      build_subscribe_request(subscription_list, qos, list_mode, encoding);
 
   YLOG_INFO("\n=============== Sending SubscribeRequest ================\n{}\n",
             request.DebugString());
 
-  context.AddMetadata("username", username);
-  context.AddMetadata("password", password);
-
-  auto a = stub_->Subscribe(&context);
-  client_reader_writer = move(a);
+  add_credentials(context);
+  client_reader_writer = stub_->Subscribe(&context);
   client_reader_writer->Write(request);
+  {
+    lock_guard<mutex> guard(last_subscribe_mutex);
+    last_subscribe_response = "";
+    last_subscribe_message.Clear();
+    subscribe_response_count = 0;
+  }
   client_reader_is_active = true;
-  last_subscribe_response = "";
+}
+
+void gNMIClient::read_subscribe_responses(const GnmiSubscribeCallback& out_func,
+                                          bool keep_last_message) {
+  // the same message is reused for every read, so its storage is
+  // allocated once for the whole subscription
+  gnmi::SubscribeResponse response{};
+  while (client_reader_writer->Read(&response)) {
+    if (keep_last_message) {
+      lock_guard<mutex> guard(last_subscribe_mutex);
+      last_subscribe_message = response;
+    }
+    out_func(response);
+    lock_guard<mutex> guard(last_subscribe_mutex);
+    subscribe_response_count++;
+    subscribe_response_received.notify_all();
+  }
+  auto status = client_reader_writer->Finish();
+  {
+    lock_guard<mutex> guard(last_subscribe_mutex);
+    client_reader_is_active = false;
+    subscribe_response_received.notify_all();
+  }
+  check_status(status, "SubscribeRequest failed with error");
+  YLOG_INFO("Subscribe Operation Succeeded");
+}
+
+void gNMIClient::execute_subscribe_operation(
+    const std::vector<GnmiClientSubscription>& subscription_list, uint32 qos,
+    const std::string& list_mode, const std::string& encoding,
+    std::function<void(const char* response)> out_func,
+    std::function<bool(const char* response)> poll_func) {
+  grpc::ClientContext context;
+  start_subscribe(subscription_list, qos, list_mode, encoding, context);
 
   if (list_mode == "POLL" || list_mode == "STREAM") {
     if (poll_func != nullptr) {
@@ -683,32 +777,46 @@ void gNMIClient::execute_subscribe_operation(
     }
   }
 
-  while (client_reader_writer->Read(&response)) {
-    YLOG_INFO(
-        "\n=============== Received SubscribeResponse ================\n{}\n",
-        response.DebugString());
-
-    google::protobuf::TextFormat::PrintToString(response,
-                                                &last_subscribe_response);
-    if (out_func != nullptr) {
-      YLOG_DEBUG("Invoking user callback to receive the subscription data");
-      out_func(last_subscribe_response.c_str());
+  read_subscribe_responses(
+      [this, &out_func](const gnmi::SubscribeResponse& response) {
+        string text = format_subscribe_response(response);
+        {
+          lock_guard<mutex> guard(last_subscribe_mutex);
+          last_subscribe_response = text;
+        }
+        if (out_func != nullptr) {
+          YLOG_DEBUG("Invoking user callback to receive the subscription data");
+          out_func(text.c_str());
+        } else {
+          // By default put the response to stdout
+          cout << text << endl;
+        }
+      },
+      false);
+}
+
+void gNMIClient::execute_subscribe_operation_typed(
+    const std::vector<GnmiClientSubscription>& subscription_list, uint32 qos,
+    const std::string& list_mode, const std::string& encoding,
+    GnmiSubscribeCallback out_func, GnmiPollCallback poll_func) {
+  if (out_func == nullptr) {
+    out_func = [](const gnmi::SubscribeResponse& response) {
+      cout << format_subscribe_response(response) << endl;
+    };
+  }
+
+  grpc::ClientContext context;
+  start_subscribe(subscription_list, qos, list_mode, encoding, context);
+
+  if (list_mode == "POLL" || list_mode == "STREAM") {
+    if (poll_func != nullptr) {
+      poll_thread_callback_control(this, poll_func);
     } else {
-      // By default put the response to stdout
-      cout << last_subscribe_response << endl;
+      poll_thread_cin_control(this, list_mode);
     }
   }
-  auto status = client_reader_writer->Finish();
-  client_reader_is_active = false;
-  check_status(status, "SubscribeRequest failed with error");
-  YLOG_INFO("Subscribe Operation Succeeded");
 
-  // Release allocated memory
-  sl = request.release_subscribe();
-  qosmarking = sl->release_qos();
-  delete qosmarking;
-  sl->clear_subscription();
-  delete sl;
+  read_subscribe_responses(out_func, poll_func != nullptr);
 }
 
 }  // namespace ydk
@@ -27,9 +27,12 @@
 #include <grpc++/create_channel.h>
 #include <grpc++/grpc++.h>
 
+#include <atomic>
+#include <condition_variable>
 #include <fstream>
 #include <iostream>
 #include <map>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -88,10 +91,24 @@ struct GnmiClientSubscription {
   uint64 heartbeat_interval;
 };
 
+// Receives each SubscribeResponse as decoded by gRPC; the response is only
+// valid for the duration of the call.
+typedef std::function<void(const gnmi::SubscribeResponse& response)>
+    GnmiSubscribeCallback;
+// Decides whether to send another poll request, given the last response.
+typedef std::function<bool(const gnmi::SubscribeResponse& last_response)>
+    GnmiPollCallback;
+
+// Renders a SubscribeResponse in protobuf text format.
+std::string format_subscribe_response(const gnmi::SubscribeResponse& response);
+
 class gNMIClient;
+class gNMISubscriptionEngine;
 
 void poll_thread_callback_control(
     gNMIClient* client, std::function<bool(const char* response)> poll_func);
+void poll_thread_callback_control(gNMIClient* client,
+                                  GnmiPollCallback poll_func);
 void poll_thread_cin_control(gNMIClient* client, const std::string& list_mode);
 
 class gNMIClient : public NetconfClient {
@@ -104,21 +121,32 @@ class gNMIClient : public NetconfClient {
   gNMIClient(const std::string& address, int port, const std::string& username,
              const std::string& password,
              const std::string& server_certificate = "",
-             const std::string& private_key = "");
+             const std::string& private_key = "",
+             const TransportOptions& transport_options = {});
   ~gNMIClient();
 
   std::vector<std::string> execute_get_operation(
       const std::vector<GnmiClientRequest>& get_request_list,
       const std::string& operation);
+  // Leaves the reply undecoded, see append_notification_updates
+  void execute_get_operation(
+      const std::vector<GnmiClientRequest>& get_request_list,
+      const std::string& operation, gnmi::GetResponse& response);
 
   bool execute_set_operation(
       const std::vector<GnmiClientRequest>& get_request_list);
+  void execute_set_operation(const gnmi::SetRequest& request,
+                             gnmi::SetResponse& response);
 
   void execute_subscribe_operation(
       const std::vector<GnmiClientSubscription>& subscription_list, uint32 qos,
       const std::string& mode, const std::string& encoding,
       std::function<void(const char* response)> out_func,
       std::function<bool(const char* response)> poll_func);
+  void execute_subscribe_operation_typed(
+      const std::vector<GnmiClientSubscription>& subscription_list, uint32 qos,
+      const std::string& mode, const std::string& encoding,
+      GnmiSubscribeCallback out_func, GnmiPollCallback poll_func = nullptr);
   void send_poll_request(bool last = false);
 
   GnmiClientCapabilityResponse execute_get_capabilities();
@@ -126,11 +154,15 @@ class gNMIClient : public NetconfClient {
   std::shared_ptr<grpc::ClientReaderWriter<gnmi::SubscribeRequest,
                                            ::gnmi::SubscribeResponse>>
       client_reader_writer;
-  bool client_reader_is_active = false;
+  std::atomic<bool> client_reader_is_active{false};
 
-  inline std::string get_last_subscribe_response() {
-    return last_subscribe_response;
-  }
+  std::string get_last_subscribe_response();
+  gnmi::SubscribeResponse get_last_subscribe_message();
+  uint64 get_subscribe_response_count();
+  // Blocks until more than `count` responses were received or the timeout
+  // expires; returns whether a new response arrived.
+  bool wait_for_subscribe_response(uint64 count,
+                                   std::chrono::milliseconds timeout);
 
   // Functions to implement abstract class NetconfClient
   int connect();
@@ -141,13 +173,25 @@ class gNMIClient : public NetconfClient {
   void perform_session_check(const std::string& message);
 
  private:
+  friend class gNMISubscriptionEngine;
+
+  void add_credentials(grpc::ClientContext& context);
+  gnmi::SubscribeRequest build_subscribe_request(
+      const std::vector<GnmiClientSubscription>& subscription_list, uint32 qos,
+      const std::string& list_mode, const std::string& encoding);
   void parse_capabilities_modeldata(::gnmi::CapabilityResponse* response);
   void parse_capabilities(::gnmi::CapabilityResponse* response);
 
-  std::vector<std::string> execute_get_payload(
-      const ::gnmi::GetRequest& request, ::gnmi::GetResponse* response);
+  void execute_get_payload(const ::gnmi::GetRequest& request,
+                           ::gnmi::GetResponse* response);
   bool execute_set_payload(const ::gnmi::SetRequest& request,
                            ::gnmi::SetResponse* response);
+  void start_subscribe(
+      const std::vector<GnmiClientSubscription>& subscription_list, uint32 qos,
+      const std::string& list_mode, const std::string& encoding,
+      grpc::ClientContext& context);
+  void read_subscribe_responses(const GnmiSubscribeCallback& out_func,
+                                bool keep_last_message);
 
   std::vector<std::string> capabilities;
   std::unique_ptr<gNMI::Stub> stub_;
@@ -157,8 +201,13 @@ class gNMIClient : public NetconfClient {
   std::string password;
   std::string server_certificate;
   std::string private_key;
+  TransportOptions transport_options;
 
+  std::mutex last_subscribe_mutex;
+  std::condition_variable subscribe_response_received;
   std::string last_subscribe_response;
+  gnmi::SubscribeResponse last_subscribe_message;
+  uint64 subscribe_response_count = 0;
 };
 }  // namespace ydk
 
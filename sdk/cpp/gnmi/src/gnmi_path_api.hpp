@@ -51,7 +51,8 @@ class gNMISession : public Session {
   gNMISession(Repository& repo, const std::string& address, int port,
               const std::string& username, const std::string& password,
               const std::string& server_certificate = "",
-              const std::string& private_key = "");
+              const std::string& private_key = "",
+              const TransportOptions& transport_options = {});
 
   ~gNMISession();
 
@@ -69,6 +70,8 @@ class gNMISession : public Session {
 
   std::shared_ptr<path::DataNode> handle_get_reply(
       std::vector<std::string> reply_val) const;
+  std::shared_ptr<path::DataNode> handle_get_reply(
+      const gnmi::GetResponse& response) const;
   gNMIClient& get_client() const;
 
  private:
@@ -40,14 +40,14 @@
 using namespace std;
 
 namespace ydk {
-gNMIServiceProvider::gNMIServiceProvider(path::Repository& repo,
-                                         const string& address, int port,
-                                         const string& username,
-                                         const string& password,
-                                         const string& server_certificate,
-                                         const string& private_key)
-    : session{repo,       address, port, username, password, server_certificate,
-              private_key} {
+gNMIServiceProvider::gNMIServiceProvider(
+    path::Repository& repo, const string& address, int port,
+    const string& username, const string& password,
+    const string& server_certificate, const string& private_key,
+    const TransportOptions& transport_options)
+    : session{repo,        address,           port,
+              username,    password,          server_certificate,
+              private_key, transport_options} {
   string secure = (server_certificate.length() > 0) ? "Secure" : "Insecure";
   YLOG_INFO("gNMIServiceProvider Connected to {} via {} Channel", address,
             secure);
@@ -32,7 +32,8 @@ class gNMIServiceProvider : public ServiceProvider {
                       int port, const std::string& username,
                       const std::string& password,
                       const std::string& server_certificate = "",
-                      const std::string& private_key = "");
+                      const std::string& private_key = "",
+                      const TransportOptions& transport_options = {});
 
   ~gNMIServiceProvider();
 
@@ -30,6 +30,7 @@
 #include <ydk/logger.hpp>
 
 #include "gnmi_provider.hpp"
+#include "gnmi_service_internal.hpp"
 #include "gnmi_util.hpp"
 
 using namespace std;
@@ -41,28 +42,14 @@ using grpc::SslCredentialsOptions;
 
 namespace ydk {
 
-static string get_data_payload(gNMIServiceProvider& provider, Entity& entity) {
-  string payload;
-  auto top_entity = get_top_entity(&entity);
-  if (entity.ignore_validation && top_entity->is_top_level_class) {
-    YLOG_DEBUG(
-        "=========== Generating JSON payload with JsonSubtreeCodec "
-        "============");
-    payload = get_json_subtree_filter_payload(*top_entity, provider, false);
-  } else {
-    YLOG_DEBUG(
-        "=========== Generating JSON payload with path::Codec ============");
-    path::Codec codec_service{};
-    path::RootSchemaNode& root_schema =
-        provider.get_session().get_root_schema();
-    auto yfilter = entity.yfilter;
-    entity.yfilter = YFilter::not_set;
-    path::DataNode& datanode = get_data_node_from_entity(entity, root_schema);
-    entity.yfilter = yfilter;
-    payload = codec_service.encode(datanode, EncodingFormat::JSON, false);
-  }
-  YLOG_DEBUG("\n{}", payload);
-  return payload;
+// Validates the entity against the schema; its yfilter is not part of the
+// data
+static void validate_entity(gNMIServiceProvider& provider, Entity& entity) {
+  path::RootSchemaNode& root_schema = provider.get_session().get_root_schema();
+  auto yfilter = entity.yfilter;
+  entity.yfilter = YFilter::not_set;
+  get_data_node_from_entity(entity, root_schema);
+  entity.yfilter = yfilter;
 }
 
 gNMIService::gNMIService() {}
@@ -77,11 +64,8 @@ static shared_ptr<Entity> json_codec_payload_to_entity(
   return json_subtree_codec.decode(payload, filter);
 }
 
-static vector<string> get_json_from_path(gNMIServiceProvider& provider,
-                                         vector<gnmi::Path*> path_list,
-                                         const string& operation) {
-  YLOG_DEBUG("Executing 'get' gRPC on multiple paths");
-
+static vector<GnmiClientRequest> build_get_request_list(
+    const vector<gnmi::Path*>& path_list, const string& operation) {
   vector<GnmiClientRequest> get_request_list{};
   for (auto path : path_list) {
     GnmiClientRequest request;
@@ -90,7 +74,15 @@ static vector<string> get_json_from_path(gNMIServiceProvider& provider,
     request.operation = operation;
     get_request_list.push_back(request);
   }
+  return get_request_list;
+}
 
+static vector<string> get_json_from_path(gNMIServiceProvider& provider,
+                                         vector<gnmi::Path*> path_list,
+                                         const string& operation) {
+  YLOG_DEBUG("Executing 'get' gRPC on multiple paths");
+
+  auto get_request_list = build_get_request_list(path_list, operation);
   auto& gnmi_session =
       dynamic_cast<const path::gNMISession&>(provider.get_session());
   auto& client = gnmi_session.get_client();
@@ -103,10 +95,12 @@ static vector<string> get_json_from_path(gNMIServiceProvider& provider,
 shared_ptr<path::DataNode> gNMIService::get_from_path(
     gNMIServiceProvider& provider, vector<gnmi::Path*> path_list,
     const string& operation) const {
-  vector<string> reply = get_json_from_path(provider, path_list, operation);
-
+  auto get_request_list = build_get_request_list(path_list, operation);
   auto& gnmi_session =
       dynamic_cast<const path::gNMISession&>(provider.get_session());
+  gnmi::GetResponse reply;
+  gnmi_session.get_client().execute_get_operation(get_request_list, operation,
+                                                  reply);
   return gnmi_session.handle_get_reply(reply);
 }
 
@@ -228,8 +222,8 @@ vector<shared_ptr<Entity>> gNMIService::get(gNMIServiceProvider& provider,
 }
 
 // set
-static GnmiClientRequest build_set_request(gNMIServiceProvider& provider,
-                                           Entity& entity) {
+GnmiClientRequest detail::build_set_request(gNMIServiceProvider& provider,
+                                            Entity& entity) {
   string operation = to_string(entity.yfilter);
   if (operation != "replace" && operation != "update" &&
       operation != "delete") {
@@ -245,14 +239,11 @@ static GnmiClientRequest build_set_request(gNMIServiceProvider& provider,
   if (operation == "delete") {
     parse_entity_to_path(entity, path);
   } else {
-    parse_entity_prefix(entity, path);
-    payload = get_data_payload(provider, entity);
-    if (entity.is_top_level_class) {
-      // Remove prefix part from the payload
-      auto pos = payload.find("{", 4);
-      if (pos != string::npos)
-        payload = payload.substr(pos, payload.length() - pos - 1);
-    }
+    if (!entity.ignore_validation) validate_entity(provider, entity);
+    gnmi::TypedValue value;
+    parse_entity_to_path_and_value(entity, path, &value);
+    payload = value.json_ietf_val();
+    YLOG_DEBUG("\n{}", payload);
   }
 
   GnmiClientRequest request;
@@ -269,7 +260,7 @@ bool gNMIService::set(gNMIServiceProvider& provider, Entity& entity) const {
   YLOG_DEBUG("Executing get gRPC for single entity");
   bool result;
   vector<GnmiClientRequest> set_request_list{};
-  GnmiClientRequest request = build_set_request(provider, entity);
+  GnmiClientRequest request = detail::build_set_request(provider, entity);
   set_request_list.push_back(request);
 
   auto& gnmi_session =
@@ -288,7 +279,7 @@ bool gNMIService::set(gNMIServiceProvider& provider,
   vector<GnmiClientRequest> set_request_list{};
   int count = 1;
   for (auto entity : entity_list) {
-    GnmiClientRequest request = build_set_request(provider, *entity);
+    GnmiClientRequest request = detail::build_set_request(provider, *entity);
     request.alias += "-" + count++;
     set_request_list.push_back(request);
   }
@@ -301,6 +292,19 @@ bool gNMIService::set(gNMIServiceProvider& provider,
   return result;
 }
 
+bool gNMIService::set(gNMIServiceProvider& provider,
+                      const gNMISetBatch& batch) const {
+  YLOG_DEBUG("Executing set gRPC for a batch of {} changes", batch.size());
+  auto& gnmi_session =
+      dynamic_cast<const path::gNMISession&>(provider.get_session());
+  auto& client = gnmi_session.get_client();
+  gnmi::SetResponse response;
+  for (auto& request : batch.get_requests()) {
+    client.execute_set_operation(request, response);
+  }
+  return true;
+}
+
 static void check_subscription_params(gNMISubscription& subscription) {
   if (subscription.entity == nullptr) {
     YLOG_ERROR("Entity is not set in the subscription");
@@ -347,80 +351,135 @@ static string check_subscribe_encoding(const string& encoding) {
   return list_encoding;
 }
 
+static vector<GnmiClientSubscription> build_subscription_list(
+    vector<gNMISubscription*>& subscription_list) {
+  vector<GnmiClientSubscription> sub_list{};
+  for (auto subscription : subscription_list) {
+    check_subscription_params(*subscription);
+    GnmiClientSubscription sub;
+    sub.path = new gnmi::Path;
+    parse_entity_to_path(*subscription->entity, sub.path);
+    sub.subscription_mode = subscription->subscription_mode;
+    sub.sample_interval = subscription->sample_interval;
+    sub.suppress_redundant = subscription->suppress_redundant;
+    sub.heartbeat_interval = subscription->heartbeat_interval;
+
+    sub_list.push_back(sub);
+  }
+  return sub_list;
+}
+
+static void release_subscription_list(vector<GnmiClientSubscription>& sub_list) {
+  for (auto& sub : sub_list) {
+    if (sub.path) {
+      delete sub.path;
+      sub.path = nullptr;
+    }
+  }
+}
+
 // subscribe
 void gNMIService::subscribe(
     gNMIServiceProvider& provider, gNMISubscription& subscription, uint32 qos,
     const std::string& mode, const std::string& encoding,
     std::function<void(const char* response)> out_func,
     std::function<bool(const char* response)> poll_func) const {
+  vector<gNMISubscription*> subscription_list{&subscription};
+  subscribe(provider, subscription_list, qos, mode, encoding, out_func,
+            poll_func);
+}
+
+void gNMIService::subscribe(
+    gNMIServiceProvider& provider, vector<gNMISubscription*>& subscription_list,
+    uint32 qos, const std::string& mode, const std::string& encoding,
+    std::function<void(const char* response)> out_func,
+    std::function<bool(const char* response)> poll_func) const {
   YLOG_DEBUG(
-      "gNMIService::subscribe: Executing subscribe RPC in '{}' list mode",
+      "gNMIService::subscribe: Executing subscribe request in '{}' list mode",
       mode);
 
   string list_mode = check_subscribe_mode(mode);
   string list_encoding = check_subscribe_encoding(encoding);
-  check_subscription_params(subscription);
-
-  GnmiClientSubscription sub;
-  sub.path = new gnmi::Path;
-  parse_entity_to_path(*subscription.entity, sub.path);
-  sub.subscription_mode = subscription.subscription_mode;
-  sub.sample_interval = subscription.sample_interval;
-  sub.suppress_redundant = subscription.suppress_redundant;
-  sub.heartbeat_interval = subscription.heartbeat_interval;
-
-  vector<GnmiClientSubscription> sub_list{};
-  sub_list.push_back(sub);
+  auto sub_list = build_subscription_list(subscription_list);
 
   auto& gnmi_session =
       dynamic_cast<const path::gNMISession&>(provider.get_session());
   auto& client = gnmi_session.get_client();
-  client.execute_subscribe_operation(sub_list, qos, list_mode, list_encoding,
-                                     out_func, poll_func);
+  try {
+    client.execute_subscribe_operation(sub_list, qos, list_mode,
+                                       list_encoding, out_func, poll_func);
+  } catch (...) {
+    release_subscription_list(sub_list);
+    throw;
+  }
+  release_subscription_list(sub_list);
+}
 
-  // Release allocated memory
-  delete sub.path;
-  sub.path = nullptr;
+void gNMIService::subscribe_typed(gNMIServiceProvider& provider,
+                                  gNMISubscription& subscription, uint32 qos,
+                                  const std::string& mode,
+                                  const std::string& encoding,
+                                  GnmiSubscribeCallback out_func,
+                                  GnmiPollCallback poll_func) const {
+  vector<gNMISubscription*> subscription_list{&subscription};
+  subscribe_typed(provider, subscription_list, qos, mode, encoding, out_func,
+                  poll_func);
 }
 
-void gNMIService::subscribe(
-    gNMIServiceProvider& provider, vector<gNMISubscription*>& subscription_list,
-    uint32 qos, const std::string& mode, const std::string& encoding,
-    std::function<void(const char* response)> out_func,
-    std::function<bool(const char* response)> poll_func) const {
+void gNMIService::subscribe_typed(gNMIServiceProvider& provider,
+                                  vector<gNMISubscription*>& subscription_list,
+                                  uint32 qos, const std::string& mode,
+                                  const std::string& encoding,
+                                  GnmiSubscribeCallback out_func,
+                                  GnmiPollCallback poll_func) const {
   YLOG_DEBUG(
       "gNMIService::subscribe: Executing subscribe request in '{}' list mode",
       mode);
 
   string list_mode = check_subscribe_mode(mode);
   string list_encoding = check_subscribe_encoding(encoding);
-  vector<GnmiClientSubscription> sub_list{};
-  for (auto subscription : subscription_list) {
-    check_subscription_params(*subscription);
-    GnmiClientSubscription sub;
-    sub.path = new gnmi::Path;
-    parse_entity_to_path(*subscription->entity, sub.path);
-    sub.subscription_mode = subscription->subscription_mode;
-    sub.sample_interval = subscription->sample_interval;
-    sub.suppress_redundant = subscription->suppress_redundant;
-    sub.heartbeat_interval = subscription->heartbeat_interval;
+  auto sub_list = build_subscription_list(subscription_list);
 
-    sub_list.push_back(sub);
+  auto& gnmi_session =
+      dynamic_cast<const path::gNMISession&>(provider.get_session());
+  auto& client = gnmi_session.get_client();
+  try {
+    client.execute_subscribe_operation_typed(sub_list, qos, list_mode,
+                                             list_encoding, out_func,
+                                             poll_func);
+  } catch (...) {
+    release_subscription_list(sub_list);
+    throw;
   }
+  release_subscription_list(sub_list);
+}
+
+shared_ptr<gNMISubscriptionHandle> gNMIService::subscribe_async(
+    gNMISubscriptionEngine& engine, gNMIServiceProvider& provider,
+    vector<gNMISubscription*>& subscription_list, uint32 qos,
+    const std::string& mode, const std::string& encoding,
+    GnmiSubscribeCallback out_func, GnmiSubscribeDoneCallback done_func) const {
+  YLOG_DEBUG(
+      "gNMIService::subscribe_async: Starting subscription in '{}' list mode",
+      mode);
+
+  string list_mode = check_subscribe_mode(mode);
+  string list_encoding = check_subscribe_encoding(encoding);
+  auto sub_list = build_subscription_list(subscription_list);
 
   auto& gnmi_session =
       dynamic_cast<const path::gNMISession&>(provider.get_session());
   auto& client = gnmi_session.get_client();
-  client.execute_subscribe_operation(sub_list, qos, list_mode, list_encoding,
-                                     out_func, poll_func);
-
-  // Release allocated memory
-  for (auto sub : sub_list) {
-    if (sub.path) {
-      delete sub.path;
-      sub.path = nullptr;
-    }
+  shared_ptr<gNMISubscriptionHandle> handle;
+  try {
+    handle = engine.subscribe(client, sub_list, qos, list_mode, list_encoding,
+                              out_func, done_func);
+  } catch (...) {
+    release_subscription_list(sub_list);
+    throw;
   }
+  release_subscription_list(sub_list);
+  return handle;
 }
 
 std::string gNMIService::capabilities(gNMIServiceProvider& provider) {
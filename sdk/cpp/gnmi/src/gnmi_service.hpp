@@ -24,7 +24,10 @@
 #ifndef GNMI_SERVICE_HPP
 #define GNMI_SERVICE_HPP
 
+#include "gnmi_client.hpp"
 #include "gnmi_path_api.hpp"
+#include "gnmi_set_batch.hpp"
+#include "gnmi_subscription_engine.hpp"
 
 namespace ydk {
 class gNMIServiceProvider;
@@ -53,6 +56,8 @@ class gNMIService {
   bool set(gNMIServiceProvider& provider, Entity& entity) const;
   bool set(gNMIServiceProvider& provider,
            std::vector<Entity*>& entity_list) const;
+  // Sends the requests of the batch in order
+  bool set(gNMIServiceProvider& provider, const gNMISetBatch& batch) const;
 
   void subscribe(
       gNMIServiceProvider& provider, gNMISubscription& sub, uint32 qos,
@@ -65,6 +70,27 @@ class gNMIService {
       std::function<void(const char* response)> out_func = nullptr,
       std::function<bool(const char* response)> poll_func = nullptr) const;
 
+  // Deliver each SubscribeResponse as received, without rendering it as text
+  void subscribe_typed(gNMIServiceProvider& provider, gNMISubscription& sub,
+                       uint32 qos, const std::string& mode,
+                       const std::string& encoding,
+                       GnmiSubscribeCallback out_func,
+                       GnmiPollCallback poll_func = nullptr) const;
+  void subscribe_typed(gNMIServiceProvider& provider,
+                       std::vector<gNMISubscription*>& sub_list, uint32 qos,
+                       const std::string& mode, const std::string& encoding,
+                       GnmiSubscribeCallback out_func,
+                       GnmiPollCallback poll_func = nullptr) const;
+
+  // Starts the subscription on the engine and returns without waiting for
+  // responses; many subscriptions to one provider share its channel
+  std::shared_ptr<gNMISubscriptionHandle> subscribe_async(
+      gNMISubscriptionEngine& engine, gNMIServiceProvider& provider,
+      std::vector<gNMISubscription*>& sub_list, uint32 qos,
+      const std::string& mode, const std::string& encoding,
+      GnmiSubscribeCallback out_func,
+      GnmiSubscribeDoneCallback done_func = nullptr) const;
+
   std::string capabilities(gNMIServiceProvider& provider);
 
   std::shared_ptr<path::DataNode> get_from_path(
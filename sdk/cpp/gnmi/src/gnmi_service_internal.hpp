@@ -0,0 +1,42 @@
+/// YANG Development Kit
+// Copyright 2016 Cisco Systems. All rights reserved
+//
+////////////////////////////////////////////////////////////////
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+//////////////////////////////////////////////////////////////////
+
+#ifndef GNMI_SERVICE_INTERNAL_HPP
+#define GNMI_SERVICE_INTERNAL_HPP
+
+#include "gnmi_client.hpp"
+
+// Helpers shared by the gNMI sources; this header is not installed
+
+namespace ydk {
+class gNMIServiceProvider;
+
+namespace detail {
+// Builds the request for the change described by entity.yfilter; the caller
+// owns request.path
+GnmiClientRequest build_set_request(gNMIServiceProvider& provider,
+                                    Entity& entity);
+}  // namespace detail
+
+}  // namespace ydk
+#endif /* GNMI_SERVICE_INTERNAL_HPP */
@@ -26,6 +26,7 @@
 #include <fstream>
 #include <ydk/common_utilities.hpp>
 #include <ydk/ietf_parser.hpp>
+#include <ydk/json.hpp>
 #include <ydk/logger.hpp>
 #include <ydk/netconf_model_provider.hpp>
 
@@ -40,6 +41,7 @@ using grpc::SslCredentialsOptions;
 
 using namespace std;
 using namespace ydk;
+using json = nlohmann::json;
 
 namespace ydk {
 namespace path {
@@ -48,12 +50,14 @@ gNMISession::gNMISession(Repository& repo, const std::string& address, int port,
                          const std::string& username,
                          const std::string& password,
                          const std::string& server_certificate,
-                         const std::string& private_key) {
+                         const std::string& private_key,
+                         const TransportOptions& transport_options) {
   // Correct default settings
   if (port == 0) port = 57400;
 
   client = make_unique<gNMIClient>(address, port, username, password,
-                                   server_certificate, private_key);
+                                   server_certificate, private_key,
+                                   transport_options);
 
   server_capabilities = client->get_capabilities();
 
@@ -149,6 +153,24 @@ static void populate_path_from_payload(gnmi::Path* path, const string& payload,
   parse_datanode_to_path(child, path);
 }
 
+// Splits {"prefix": value} into the prefix and the JSON text of the value
+static string split_set_payload(const string& payload, string& prefix) {
+  json document;
+  try {
+    document = json::parse(payload);
+  } catch (invalid_argument& e) {
+    YLOG_ERROR("Failed to parse JSON payload: {}", e.what());
+    throw(YInvalidArgumentError{"Problems deserializing JSON payload"});
+  }
+  if (!document.is_object() || document.empty()) {
+    YLOG_ERROR("JSON payload of set RPC is not a non-empty object");
+    throw(YInvalidArgumentError{"Problems deserializing JSON payload"});
+  }
+  auto member = document.begin();
+  prefix = member.key();
+  return member.value().dump();
+}
+
 static GnmiClientRequest build_set_request(RootSchemaNode& root_schema,
                                            DataNode* request,
                                            const string& operation) {
@@ -168,13 +190,9 @@ static GnmiClientRequest build_set_request(RootSchemaNode& root_schema,
     populate_path_from_payload(one_request.path, one_request.payload,
                                root_schema);
   } else {
-    auto pos = one_request.payload.find("{", 4);
-    if (pos != string::npos) {
-      string prefix = one_request.payload.substr(2, pos - 4);
-      parse_prefix_to_path(prefix, one_request.path);
-      one_request.payload = one_request.payload.substr(
-          pos, one_request.payload.length() - pos - 1);
-    }
+    string prefix;
+    one_request.payload = split_set_payload(one_request.payload, prefix);
+    parse_prefix_to_path(prefix, one_request.path);
   }
   return one_request;
 }
@@ -257,11 +275,8 @@ shared_ptr<DataNode> gNMISession::handle_get(Rpc& rpc) const {
     getRequest.push_back(one_request);
   }
 
-  vector<string> reply = client->execute_get_operation(getRequest, operation);
-  YLOG_DEBUG("============= Reply payload received from device =============");
-  for (auto response : reply) {
-    YLOG_DEBUG("\n{}", response);
-  }
+  gnmi::GetResponse reply;
+  client->execute_get_operation(getRequest, operation, reply);
   shared_ptr<DataNode> rnd = handle_get_reply(reply);
 
   release_allocated_memory(getRequest);
@@ -281,6 +296,16 @@ shared_ptr<DataNode> gNMISession::handle_get_reply(
   return root_dn;
 }
 
+shared_ptr<DataNode> gNMISession::handle_get_reply(
+    const gnmi::GetResponse& response) const {
+  vector<DataUpdate> updates;
+  for (auto& notification : response.notification()) {
+    append_notification_updates(notification, updates);
+  }
+  Codec codec{};
+  return codec.decode_updates(get_root_schema(), updates);
+}
+
 shared_ptr<DataNode> gNMISession::handle_get_capabilities() const {
   GnmiClientCapabilityResponse reply = client->execute_get_capabilities();
 
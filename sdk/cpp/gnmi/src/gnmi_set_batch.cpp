@@ -0,0 +1,244 @@
+/// YANG Development Kit
+// Copyright 2016 Cisco Systems. All rights reserved
+//
+////////////////////////////////////////////////////////////////
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+//////////////////////////////////////////////////////////////////
+
+#include "gnmi_set_batch.hpp"
+
+#include <google/protobuf/io/coded_stream.h>
+#include <unordered_map>
+#include <ydk/errors.hpp>
+#include <ydk/logger.hpp>
+
+#include "gnmi_service.hpp"
+#include "gnmi_service_internal.hpp"
+#include "gnmi_util.hpp"
+
+using namespace std;
+
+using google::protobuf::io::CodedOutputStream;
+
+namespace ydk {
+
+// Changes of one request at a path
+struct gNMISetBatchNode {
+  gNMISetBatchNode()
+      : updates{0}, replaces{0}, last_update{-1}, last_subtree_update{-1} {}
+
+  unordered_map<string, unique_ptr<gNMISetBatchNode>> children;
+  vector<size_t> changes;
+  size_t updates;
+  size_t replaces;
+  // indexes of the last update at this path and at or below it; they are
+  // not reset when the update is dropped
+  long last_update;
+  long last_subtree_update;
+};
+
+gNMISetBatch::gNMISetBatch(size_t max_message_size)
+    : max_message_size{max_message_size},
+      requests{0},
+      pending{0},
+      dropped{0},
+      root{new gNMISetBatchNode{}} {}
+
+gNMISetBatch::~gNMISetBatch() {}
+
+void gNMISetBatch::add(gNMIServiceProvider& provider, Entity& entity) {
+  auto request = detail::build_set_request(provider, entity);
+  unique_ptr<gnmi::Path> path{request.path};
+  add(request.operation, *path, request.payload);
+}
+
+void gNMISetBatch::add(const string& operation, const gnmi::Path& path,
+                       const string& payload) {
+  Operation op;
+  if (operation == "delete") {
+    op = DELETE;
+  } else if (operation == "replace") {
+    op = REPLACE;
+  } else if (operation == "update") {
+    op = UPDATE;
+  } else {
+    YLOG_ERROR("gNMISetBatch: {} operation not supported", operation);
+    throw(YServiceProviderError{operation + " operation not supported"});
+  }
+
+  vector<string> ids;
+  ids.reserve(path.elem_size());
+  for (auto& elem : path.elem()) ids.push_back(get_path_element_id(elem));
+
+  // existing nodes above the path
+  vector<gNMISetBatchNode*> ancestors;
+  gNMISetBatchNode* node = root.get();
+  for (auto& id : ids) {
+    ancestors.push_back(node);
+    auto child = node->children.find(id);
+    if (child == node->children.end()) break;
+    node = child->second.get();
+  }
+  if (op != UPDATE && has_conflicting_ancestor(ancestors, op)) {
+    start_request();
+  }
+
+  ancestors.clear();
+  node = root.get();
+  for (auto& id : ids) {
+    ancestors.push_back(node);
+    auto& child = node->children[id];
+    if (!child) child.reset(new gNMISetBatchNode{});
+    node = child.get();
+  }
+
+  if (op == UPDATE) {
+    if (is_duplicate_update(ancestors, node, payload)) {
+      dropped++;
+      return;
+    }
+  } else {
+    drop_subtree(*node);
+  }
+
+  auto index = changes.size();
+  changes.push_back(Change{op, path, op == DELETE ? "" : payload, requests,
+                           false});
+  node->changes.push_back(index);
+  pending++;
+  if (op == REPLACE) {
+    node->replaces++;
+  } else if (op == UPDATE) {
+    node->updates++;
+    node->last_update = index;
+    node->last_subtree_update = index;
+    for (auto ancestor : ancestors) ancestor->last_subtree_update = index;
+  }
+}
+
+vector<gnmi::SetRequest> gNMISetBatch::get_requests() const {
+  vector<gnmi::SetRequest> set_requests;
+  size_t begin = 0;
+  while (begin < changes.size()) {
+    auto end = begin;
+    auto request_index = changes[begin].request;
+    while (end < changes.size() && changes[end].request == request_index) {
+      end++;
+    }
+
+    // the changes of a request go out in the order the target applies them
+    size_t request_size = 0;
+    bool first = true;
+    for (auto operation : {DELETE, REPLACE, UPDATE}) {
+      for (auto i = begin; i < end; i++) {
+        auto& change = changes[i];
+        if (change.dropped || change.operation != operation) continue;
+
+        gnmi::Update update;
+        size_t size;
+        if (operation == DELETE) {
+          size = change.path.ByteSizeLong();
+        } else {
+          *update.mutable_path() = change.path;
+          if (!change.payload.empty()) {
+            update.mutable_val()->set_json_ietf_val(change.payload);
+          }
+          size = update.ByteSizeLong();
+        }
+        // field tag and length
+        size += 1 + CodedOutputStream::VarintSize64(size);
+
+        if (first || request_size + size > max_message_size) {
+          set_requests.emplace_back();
+          request_size = 0;
+          first = false;
+        }
+        if (size > max_message_size) {
+          YLOG_WARN("gNMISetBatch: change of {} bytes exceeds {} bytes", size,
+                    max_message_size);
+        }
+        request_size += size;
+
+        auto& request = set_requests.back();
+        if (operation == DELETE) {
+          *request.add_delete_() = change.path;
+        } else if (operation == REPLACE) {
+          request.add_replace()->Swap(&update);
+        } else {
+          request.add_update()->Swap(&update);
+        }
+      }
+    }
+    begin = end;
+  }
+  return set_requests;
+}
+
+size_t gNMISetBatch::size() const { return pending; }
+
+size_t gNMISetBatch::get_dropped_count() const { return dropped; }
+
+void gNMISetBatch::clear() {
+  changes.clear();
+  requests = 0;
+  pending = 0;
+  dropped = 0;
+  root.reset(new gNMISetBatchNode{});
+}
+
+// A delete has to follow earlier writes above it, and a replace earlier
+// updates above it, but the target would apply them first
+bool gNMISetBatch::has_conflicting_ancestor(
+    const vector<gNMISetBatchNode*>& ancestors, Operation operation) const {
+  for (auto ancestor : ancestors) {
+    if (ancestor->updates > 0) return true;
+    if (operation == DELETE && ancestor->replaces > 0) return true;
+  }
+  return false;
+}
+
+bool gNMISetBatch::is_duplicate_update(
+    const vector<gNMISetBatchNode*>& ancestors, gNMISetBatchNode* node,
+    const string& payload) const {
+  auto last = node->last_subtree_update;
+  for (auto ancestor : ancestors) last = max(last, ancestor->last_update);
+  if (last < 0 || last != node->last_update) return false;
+  auto& change = changes[last];
+  return !change.dropped && change.payload == payload;
+}
+
+void gNMISetBatch::drop_subtree(gNMISetBatchNode& node) {
+  for (auto index : node.changes) {
+    changes[index].dropped = true;
+    pending--;
+    dropped++;
+  }
+  node.changes.clear();
+  node.updates = 0;
+  node.replaces = 0;
+  for (auto& child : node.children) drop_subtree(*child.second);
+  node.children.clear();
+}
+
+void gNMISetBatch::start_request() {
+  requests++;
+  root.reset(new gNMISetBatchNode{});
+}
+
+}  // namespace ydk
@@ -0,0 +1,103 @@
+/// YANG Development Kit
+// Copyright 2016 Cisco Systems. All rights reserved
+//
+////////////////////////////////////////////////////////////////
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+//////////////////////////////////////////////////////////////////
+
+#ifndef _YDK_GNMI_SET_BATCH_H_
+#define _YDK_GNMI_SET_BATCH_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gnmi_client.hpp"
+
+namespace ydk {
+
+class gNMIServiceProvider;
+struct gNMISetBatchNode;
+
+///
+/// @brief Changes to the configuration of a target, sent as few SetRequests.
+///
+/// A target applies the deletes of a SetRequest first, then its replaces,
+/// then its updates. Changes are kept in the order they were added as far
+/// as that allows; a change that has to follow an earlier one it would
+/// otherwise precede starts a new request. Changes made redundant by a later
+/// one are dropped:
+///   - a delete or replace drops the earlier changes at or below its path;
+///   - an update identical to the last update overlapping its path is
+///     dropped.
+/// Requests are also split to keep them under the maximum message size, in
+/// which case the changes are no longer applied atomically.
+///
+class gNMISetBatch {
+ public:
+  // 4 MB is the default maximum message size of gRPC servers
+  explicit gNMISetBatch(std::size_t max_message_size = 4 * 1024 * 1024);
+  ~gNMISetBatch();
+
+  // Adds the change described by entity.yfilter, which must be replace,
+  // update or delete
+  void add(gNMIServiceProvider& provider, Entity& entity);
+  // The payload is JSON_IETF and ignored for deletes
+  void add(const std::string& operation, const gnmi::Path& path,
+           const std::string& payload = "");
+
+  std::vector<gnmi::SetRequest> get_requests() const;
+  // Number of changes to be sent
+  std::size_t size() const;
+  // Number of changes dropped as redundant
+  std::size_t get_dropped_count() const;
+  void clear();
+
+ private:
+  enum Operation { DELETE, REPLACE, UPDATE };
+
+  struct Change {
+    Operation operation;
+    gnmi::Path path;
+    std::string payload;
+    std::size_t request;
+    bool dropped;
+  };
+
+  bool has_conflicting_ancestor(
+      const std::vector<gNMISetBatchNode*>& ancestors,
+      Operation operation) const;
+  bool is_duplicate_update(const std::vector<gNMISetBatchNode*>& ancestors,
+                           gNMISetBatchNode* node,
+                           const std::string& payload) const;
+  void drop_subtree(gNMISetBatchNode& node);
+  void start_request();
+
+  std::size_t max_message_size;
+  std::vector<Change> changes;
+  std::size_t requests;
+  std::size_t pending;
+  std::size_t dropped;
+  // changes of the last request, indexed by path element
+  std::unique_ptr<gNMISetBatchNode> root;
+};
+
+}  // namespace ydk
+
+#endif /* _YDK_GNMI_SET_BATCH_H_ */
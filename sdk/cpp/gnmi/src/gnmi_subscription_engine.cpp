@@ -0,0 +1,316 @@
+/// YANG Development Kit
+// Copyright 2016 Cisco Systems. All rights reserved
+//
+////////////////////////////////////////////////////////////////
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+//////////////////////////////////////////////////////////////////
+
+#include "gnmi_subscription_engine.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <ydk/errors.hpp>
+#include <ydk/logger.hpp>
+
+using namespace std;
+
+namespace ydk {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// gNMISubscriptionCall
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// One asynchronous Subscribe stream. Completion queue events for the call are
+// handled by the single engine thread that owns its queue, so reads and
+// callbacks are serialized; poll() and stop() may come from any thread.
+class gNMISubscriptionCall {
+ public:
+  enum Operation { START, READ, WRITE, FINISH };
+
+  struct Tag {
+    gNMISubscriptionCall* call;
+    Operation operation;
+  };
+
+  gNMISubscriptionCall(GnmiSubscribeCallback out_func,
+                       GnmiSubscribeDoneCallback done_func)
+      : out_func{out_func},
+        done_func{done_func},
+        started{false},
+        writing{false},
+        closing{false},
+        finished{false},
+        pending_operations{0} {
+    for (auto operation : {START, READ, WRITE, FINISH}) {
+      tags[operation] = Tag{this, operation};
+    }
+  }
+
+  void start(gNMI::Stub& stub, grpc::CompletionQueue* queue,
+             const gnmi::SubscribeRequest& request,
+             const shared_ptr<gNMISubscriptionCall>& self) {
+    lock_guard<mutex> guard{call_mutex};
+    keep_alive = self;
+    pending_writes.push_back(request);
+    stream = stub.PrepareAsyncSubscribe(&context, queue);
+    pending_operations++;
+    stream->StartCall(&tags[START]);
+  }
+
+  void poll() {
+    gnmi::SubscribeRequest request{};
+    request.mutable_poll();
+    lock_guard<mutex> guard{call_mutex};
+    if (closing) {
+      return;
+    }
+    pending_writes.push_back(request);
+    write_next();
+  }
+
+  void stop() { context.TryCancel(); }
+
+  bool is_active() {
+    lock_guard<mutex> guard{call_mutex};
+    return !finished;
+  }
+
+  grpc::Status wait() {
+    unique_lock<mutex> lock{call_mutex};
+    call_finished.wait(lock, [this]() { return finished; });
+    return status;
+  }
+
+  void handle_event(Operation operation, bool ok) {
+    switch (operation) {
+      case START:
+        on_started(ok);
+        break;
+      case READ:
+        on_read(ok);
+        break;
+      case WRITE:
+        on_written(ok);
+        break;
+      case FINISH:
+        on_finished();
+        break;
+    }
+    release_operation();
+  }
+
+  grpc::ClientContext context;
+
+ private:
+  void on_started(bool ok) {
+    lock_guard<mutex> guard{call_mutex};
+    if (!ok) {
+      finish();
+      return;
+    }
+    started = true;
+    write_next();
+    read_next();
+  }
+
+  void on_read(bool ok) {
+    if (!ok) {
+      lock_guard<mutex> guard{call_mutex};
+      finish();
+      return;
+    }
+    if (out_func) {
+      out_func(response);
+    }
+    lock_guard<mutex> guard{call_mutex};
+    read_next();
+  }
+
+  void on_written(bool ok) {
+    lock_guard<mutex> guard{call_mutex};
+    writing = false;
+    pending_writes.pop_front();
+    if (ok) {
+      write_next();
+    }
+    // a failed write means the stream is broken; the pending read reports it
+  }
+
+  void on_finished() {
+    YLOG_INFO("Subscription finished with status code {}",
+              static_cast<int>(status.error_code()));
+    if (done_func) {
+      done_func(status);
+    }
+    lock_guard<mutex> guard{call_mutex};
+    finished = true;
+    call_finished.notify_all();
+  }
+
+  // The following must be called with call_mutex held
+  void read_next() {
+    pending_operations++;
+    stream->Read(&response, &tags[READ]);
+  }
+
+  void write_next() {
+    if (!started || writing || closing || pending_writes.empty()) {
+      return;
+    }
+    writing = true;
+    pending_operations++;
+    stream->Write(pending_writes.front(), &tags[WRITE]);
+  }
+
+  void finish() {
+    closing = true;
+    pending_operations++;
+    stream->Finish(&status, &tags[FINISH]);
+  }
+
+  // Drops the self reference once no completion queue event can refer to the
+  // call anymore
+  void release_operation() {
+    shared_ptr<gNMISubscriptionCall> self;
+    lock_guard<mutex> guard{call_mutex};
+    if (--pending_operations == 0 && finished) {
+      self = move(keep_alive);
+    }
+  }
+
+  GnmiSubscribeCallback out_func;
+  GnmiSubscribeDoneCallback done_func;
+
+  unique_ptr<grpc::ClientAsyncReaderWriter<gnmi::SubscribeRequest,
+                                           gnmi::SubscribeResponse>>
+      stream;
+  gnmi::SubscribeResponse response;
+  deque<gnmi::SubscribeRequest> pending_writes;
+  grpc::Status status;
+  Tag tags[4];
+
+  mutex call_mutex;
+  condition_variable call_finished;
+  bool started;
+  bool writing;
+  bool closing;
+  bool finished;
+  int pending_operations;
+  shared_ptr<gNMISubscriptionCall> keep_alive;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// gNMISubscriptionHandle
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+gNMISubscriptionHandle::gNMISubscriptionHandle(
+    const shared_ptr<gNMISubscriptionCall>& call)
+    : call{call} {}
+
+gNMISubscriptionHandle::~gNMISubscriptionHandle() {}
+
+void gNMISubscriptionHandle::poll() { call->poll(); }
+
+void gNMISubscriptionHandle::stop() { call->stop(); }
+
+bool gNMISubscriptionHandle::is_active() const { return call->is_active(); }
+
+grpc::Status gNMISubscriptionHandle::wait() const { return call->wait(); }
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// gNMISubscriptionEngine
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+gNMISubscriptionEngine::gNMISubscriptionEngine(size_t num_threads)
+    : next_queue{0} {
+  if (num_threads == 0) {
+    throw YInvalidArgumentError{
+        "gNMISubscriptionEngine needs at least one thread"};
+  }
+  for (size_t i = 0; i < num_threads; i++) {
+    queues.emplace_back(new grpc::CompletionQueue{});
+  }
+  for (auto& queue : queues) {
+    threads.emplace_back(&gNMISubscriptionEngine::process_events, this,
+                         queue.get());
+  }
+}
+
+gNMISubscriptionEngine::~gNMISubscriptionEngine() {
+  vector<shared_ptr<gNMISubscriptionCall>> live_calls;
+  {
+    lock_guard<mutex> guard{calls_mutex};
+    for (auto& call : calls) {
+      auto live_call = call.lock();
+      if (live_call) live_calls.push_back(live_call);
+    }
+  }
+  for (auto& call : live_calls) {
+    call->stop();
+  }
+  for (auto& call : live_calls) {
+    call->wait();
+  }
+  live_calls.clear();
+
+  for (auto& queue : queues) {
+    queue->Shutdown();
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+shared_ptr<gNMISubscriptionHandle> gNMISubscriptionEngine::subscribe(
+    gNMIClient& client, const vector<GnmiClientSubscription>& subscription_list,
+    uint32 qos, const string& mode, const string& encoding,
+    GnmiSubscribeCallback out_func, GnmiSubscribeDoneCallback done_func) {
+  auto request =
+      client.build_subscribe_request(subscription_list, qos, mode, encoding);
+  YLOG_INFO("\n=============== Sending SubscribeRequest ================\n{}\n",
+            request.DebugString());
+
+  auto call = make_shared<gNMISubscriptionCall>(out_func, done_func);
+  client.add_credentials(call->context);
+
+  grpc::CompletionQueue* queue;
+  {
+    lock_guard<mutex> guard{calls_mutex};
+    calls.erase(remove_if(calls.begin(), calls.end(),
+                          [](const weak_ptr<gNMISubscriptionCall>& call) {
+                            return call.expired();
+                          }),
+                calls.end());
+    calls.push_back(call);
+    queue = queues[next_queue++ % queues.size()].get();
+  }
+  call->start(*client.stub_, queue, request, call);
+  return make_shared<gNMISubscriptionHandle>(call);
+}
+
+void gNMISubscriptionEngine::process_events(grpc::CompletionQueue* queue) {
+  void* tag;
+  bool ok;
+  while (queue->Next(&tag, &ok)) {
+    auto event = static_cast<gNMISubscriptionCall::Tag*>(tag);
+    event->call->handle_event(event->operation, ok);
+  }
+}
+
+}  // namespace ydk
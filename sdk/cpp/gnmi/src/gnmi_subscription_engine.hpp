@@ -0,0 +1,99 @@
+/// YANG Development Kit
+// Copyright 2016 Cisco Systems. All rights reserved
+//
+////////////////////////////////////////////////////////////////
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+//////////////////////////////////////////////////////////////////
+
+#ifndef _YDK_GNMI_SUBSCRIPTION_ENGINE_H_
+#define _YDK_GNMI_SUBSCRIPTION_ENGINE_H_
+
+#include <memory>
+#include <thread>
+
+#include "gnmi_client.hpp"
+
+namespace ydk {
+
+// Called once when a subscription ends, with the final status of the stream
+typedef std::function<void(const grpc::Status& status)>
+    GnmiSubscribeDoneCallback;
+
+class gNMISubscriptionCall;
+
+///
+/// @brief Handle to a subscription running in a gNMISubscriptionEngine.
+///
+/// All methods return immediately.
+///
+class gNMISubscriptionHandle {
+ public:
+  explicit gNMISubscriptionHandle(
+      const std::shared_ptr<gNMISubscriptionCall>& call);
+  ~gNMISubscriptionHandle();
+
+  // Sends a poll request; only meaningful for POLL subscriptions
+  void poll();
+  // Cancels the subscription; the done callback reports CANCELLED
+  void stop();
+  bool is_active() const;
+  // Blocks until the subscription ends and returns its final status. Must
+  // not be called from a subscription callback.
+  grpc::Status wait() const;
+
+ private:
+  std::shared_ptr<gNMISubscriptionCall> call;
+};
+
+///
+/// @brief Multiplexes gNMI subscriptions over a fixed set of threads.
+///
+/// Each subscription is an asynchronous Subscribe stream on the channel of
+/// the gNMIClient it is started on, so any number of subscriptions to one
+/// target share one channel. Responses are delivered from the engine
+/// threads; callbacks of one subscription never run concurrently.
+///
+/// A gNMIClient must outlive the subscriptions started on it. Destroying
+/// the engine cancels the subscriptions that are still running.
+///
+class gNMISubscriptionEngine {
+ public:
+  explicit gNMISubscriptionEngine(std::size_t num_threads = 2);
+  ~gNMISubscriptionEngine();
+
+  std::shared_ptr<gNMISubscriptionHandle> subscribe(
+      gNMIClient& client,
+      const std::vector<GnmiClientSubscription>& subscription_list, uint32 qos,
+      const std::string& mode, const std::string& encoding,
+      GnmiSubscribeCallback out_func,
+      GnmiSubscribeDoneCallback done_func = nullptr);
+
+ private:
+  void process_events(grpc::CompletionQueue* queue);
+
+  std::vector<std::unique_ptr<grpc::CompletionQueue>> queues;
+  std::vector<std::thread> threads;
+  std::mutex calls_mutex;
+  std::vector<std::weak_ptr<gNMISubscriptionCall>> calls;
+  std::size_t next_queue;
+};
+
+}  // namespace ydk
+
+#endif /* _YDK_GNMI_SUBSCRIPTION_ENGINE_H_ */
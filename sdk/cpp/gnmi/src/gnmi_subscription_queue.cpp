@@ -0,0 +1,200 @@
+/// YANG Development Kit
+// Copyright 2016 Cisco Systems. All rights reserved
+//
+////////////////////////////////////////////////////////////////
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+//////////////////////////////////////////////////////////////////
+
+#include "gnmi_subscription_queue.hpp"
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+#include <iostream>
+#include <ydk/errors.hpp>
+#include <ydk/logger.hpp>
+
+using namespace std;
+
+namespace ydk {
+
+// Map fields, like the keys of path elements, are serialized in key order
+static void append_key(const gnmi::Path& path, string& key) {
+  key += std::to_string(path.ByteSizeLong()) + ':';
+  google::protobuf::io::StringOutputStream output{&key};
+  google::protobuf::io::CodedOutputStream stream{&output};
+  stream.SetSerializationDeterministic(true);
+  path.SerializeToCodedStream(&stream);
+}
+
+// Notifications reporting on the same paths share a key
+static string get_coalesce_key(const gnmi::Notification& notification) {
+  string key;
+  append_key(notification.prefix(), key);
+  for (auto& path : notification.delete_()) {
+    key += 'd';
+    append_key(path, key);
+  }
+  for (auto& update : notification.update()) {
+    key += 'u';
+    append_key(update.path(), key);
+  }
+  return key;
+}
+
+gNMISubscriptionQueue::gNMISubscriptionQueue(GnmiSubscribeCallback consumer,
+                                             size_t capacity,
+                                             GnmiQueuePolicy policy)
+    : consumer{consumer},
+      capacity{capacity},
+      policy{policy},
+      popped{0},
+      closed{false},
+      counters{},
+      alive{make_shared<atomic<bool>>(true)} {
+  if (capacity == 0) {
+    throw YInvalidArgumentError{"Subscription queue capacity must be positive"};
+  }
+  if (this->consumer == nullptr) {
+    this->consumer = [](const gnmi::SubscribeResponse& response) {
+      cout << format_subscribe_response(response) << endl;
+    };
+  }
+  consumer_thread = thread{&gNMISubscriptionQueue::consume, this};
+}
+
+gNMISubscriptionQueue::~gNMISubscriptionQueue() {
+  if (consumer_thread.joinable() &&
+      consumer_thread.get_id() == this_thread::get_id()) {
+    // the consumer cannot wait for itself: its thread ends once it returns
+    *alive = false;
+    consumer_thread.detach();
+    return;
+  }
+  close();
+}
+
+GnmiSubscribeCallback gNMISubscriptionQueue::get_callback() {
+  return [this](const gnmi::SubscribeResponse& response) { push(response); };
+}
+
+void gNMISubscriptionQueue::push(const gnmi::SubscribeResponse& response) {
+  unique_lock<mutex> lock{queue_mutex};
+  counters.received++;
+
+  string key;
+  if (policy == GnmiQueuePolicy::coalesce_by_path && is_droppable(response)) {
+    key = get_coalesce_key(response.update());
+    auto position = positions.find(key);
+    if (position != positions.end()) {
+      entries[position->second - popped].response = response;
+      counters.coalesced++;
+      return;
+    }
+  }
+
+  while (!closed && entries.size() >= capacity) {
+    if (policy == GnmiQueuePolicy::drop_newest && is_droppable(response)) {
+      counters.dropped++;
+      return;
+    }
+    if ((policy == GnmiQueuePolicy::drop_oldest ||
+         policy == GnmiQueuePolicy::coalesce_by_path) &&
+        is_droppable(entries.front().response)) {
+      pop_front();
+      counters.dropped++;
+      break;
+    }
+    not_full.wait(lock);
+  }
+  if (closed) {
+    counters.dropped++;
+    return;
+  }
+
+  if (!key.empty()) {
+    positions[key] = popped + entries.size();
+  }
+  entries.push_back(Entry{response, move(key)});
+  counters.max_depth = max(counters.max_depth, entries.size());
+  not_empty.notify_one();
+}
+
+void gNMISubscriptionQueue::close() {
+  {
+    lock_guard<mutex> guard{queue_mutex};
+    closed = true;
+    not_empty.notify_all();
+    not_full.notify_all();
+  }
+  if (consumer_thread.joinable() &&
+      consumer_thread.get_id() != this_thread::get_id()) {
+    consumer_thread.join();
+  }
+}
+
+GnmiQueueCounters gNMISubscriptionQueue::get_counters() const {
+  lock_guard<mutex> guard{queue_mutex};
+  auto current = counters;
+  current.depth = entries.size();
+  return current;
+}
+
+void gNMISubscriptionQueue::consume() {
+  // kept by the thread, as the consumer may destroy the queue
+  auto alive = this->alive;
+  auto consumer = this->consumer;
+  unique_lock<mutex> lock{queue_mutex};
+  while (true) {
+    not_empty.wait(lock, [this]() { return closed || !entries.empty(); });
+    if (entries.empty()) {
+      break;
+    }
+    auto response = move(entries.front().response);
+    pop_front();
+
+    lock.unlock();
+    try {
+      consumer(response);
+    } catch (const exception& e) {
+      YLOG_ERROR("Subscription consumer failed: {}", e.what());
+    }
+    if (!*alive) {
+      return;
+    }
+    lock.lock();
+    counters.delivered++;
+  }
+}
+
+void gNMISubscriptionQueue::pop_front() {
+  // coalescing keeps a single entry per key
+  if (!entries.front().key.empty()) {
+    positions.erase(entries.front().key);
+  }
+  entries.pop_front();
+  popped++;
+  not_full.notify_one();
+}
+
+bool gNMISubscriptionQueue::is_droppable(
+    const gnmi::SubscribeResponse& response) const {
+  return response.has_update();
+}
+
+}  // namespace ydk
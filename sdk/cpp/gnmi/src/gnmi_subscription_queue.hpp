@@ -0,0 +1,118 @@
+/// YANG Development Kit
+// Copyright 2016 Cisco Systems. All rights reserved
+//
+////////////////////////////////////////////////////////////////
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+//////////////////////////////////////////////////////////////////
+
+#ifndef _YDK_GNMI_SUBSCRIPTION_QUEUE_H_
+#define _YDK_GNMI_SUBSCRIPTION_QUEUE_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include "gnmi_client.hpp"
+
+namespace ydk {
+
+// What a full gNMISubscriptionQueue does with a new response
+enum class GnmiQueuePolicy {
+  // the stream reader waits for the consumer, which lets gRPC flow control
+  // slow down the target
+  block,
+  drop_oldest,
+  drop_newest,
+  // a queued notification for the same paths is replaced by the new one;
+  // otherwise the oldest response is dropped
+  coalesce_by_path
+};
+
+struct GnmiQueueCounters {
+  uint64 received;
+  uint64 delivered;
+  uint64 dropped;
+  uint64 coalesced;
+  std::size_t depth;
+  std::size_t max_depth;
+};
+
+///
+/// @brief Bounded queue between a subscription stream and its consumer.
+///
+/// The callback returned by get_callback() only queues the responses it is
+/// given, so it may be passed to gNMIClient::execute_subscribe_operation or
+/// gNMISubscriptionEngine::subscribe. The consumer runs on a thread of the
+/// queue and receives the responses in order, one at a time.
+///
+/// Sync responses and errors are never dropped or coalesced, but may wait
+/// for room in the queue.
+///
+class gNMISubscriptionQueue {
+ public:
+  gNMISubscriptionQueue(GnmiSubscribeCallback consumer, std::size_t capacity,
+                        GnmiQueuePolicy policy = GnmiQueuePolicy::block);
+  // Delivers the responses still queued, see close(). When run by the
+  // consumer, the responses still queued are dropped instead.
+  ~gNMISubscriptionQueue();
+
+  GnmiSubscribeCallback get_callback();
+  void push(const gnmi::SubscribeResponse& response);
+
+  // Stops accepting responses and waits until the queued ones are delivered.
+  // Responses pushed afterwards are counted as dropped.
+  void close();
+
+  GnmiQueueCounters get_counters() const;
+
+ private:
+  struct Entry {
+    gnmi::SubscribeResponse response;
+    std::string key;
+  };
+
+  void consume();
+  void pop_front();
+  bool is_droppable(const gnmi::SubscribeResponse& response) const;
+
+  GnmiSubscribeCallback consumer;
+  std::size_t capacity;
+  GnmiQueuePolicy policy;
+
+  mutable std::mutex queue_mutex;
+  std::condition_variable not_empty;
+  std::condition_variable not_full;
+  std::deque<Entry> entries;
+  // position of the coalescable entries, offset by the number popped
+  std::unordered_map<std::string, uint64> positions;
+  uint64 popped;
+  bool closed;
+  GnmiQueueCounters counters;
+  // cleared when the consumer destroys the queue, whose thread then ends
+  // without touching it
+  std::shared_ptr<std::atomic<bool>> alive;
+  std::thread consumer_thread;
+};
+
+}  // namespace ydk
+
+#endif /* _YDK_GNMI_SUBSCRIPTION_QUEUE_H_ */
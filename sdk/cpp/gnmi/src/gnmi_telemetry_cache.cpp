@@ -0,0 +1,477 @@
+/// YANG Development Kit
+// Copyright 2016 Cisco Systems. All rights reserved
+//
+////////////////////////////////////////////////////////////////
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+//////////////////////////////////////////////////////////////////
+
+#include "gnmi_telemetry_cache.hpp"
+
+#include <ydk/common_utilities.hpp>
+#include <ydk/errors.hpp>
+#include <ydk/json.hpp>
+#include <ydk/logger.hpp>
+
+#include "gnmi_util.hpp"
+
+using namespace std;
+using json = nlohmann::json;
+
+namespace ydk {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// gNMITelemetryTree
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct gNMITelemetryNode {
+  gNMITelemetryNode() : has_value{false}, timestamp{0} {}
+
+  string name;
+  vector<pair<string, string>> keys;
+  bool has_value;
+  gnmi::TypedValue value;
+  uint64 timestamp;
+  // indexed by get_path_element_id
+  unordered_map<string, unique_ptr<gNMITelemetryNode>> children;
+};
+
+// Elements of the prefix followed by those of the path
+static vector<const gnmi::PathElem*> join_elements(const gnmi::Path& prefix,
+                                                   const gnmi::Path& path) {
+  vector<const gnmi::PathElem*> elements;
+  elements.reserve(prefix.elem_size() + path.elem_size());
+  for (auto& elem : prefix.elem()) elements.push_back(&elem);
+  for (auto& elem : path.elem()) elements.push_back(&elem);
+  return elements;
+}
+
+// Leaf of a container or list value, with its path from the top-level node
+struct gNMITelemetryLeaf {
+  vector<gnmi::PathElem> elements;
+  gnmi::TypedValue value;
+};
+
+// Leaves of the container and list values of a notification, by the index of
+// the update carrying them
+using gNMITelemetryLeaves = unordered_map<int, vector<gNMITelemetryLeaf>>;
+
+static vector<const gnmi::PathElem*> get_elements(
+    const vector<gnmi::PathElem>& elements) {
+  vector<const gnmi::PathElem*> pointers;
+  pointers.reserve(elements.size());
+  for (auto& elem : elements) pointers.push_back(&elem);
+  return pointers;
+}
+
+static const path::SchemaNode* find_child_schema(
+    const path::SchemaNode& parent, const string& name) {
+  auto colon = name.find(':');
+  auto node_name = colon == string::npos ? name : name.substr(colon + 1);
+  for (auto& child : parent.get_children()) {
+    if (child->get_statement().arg == node_name) return child.get();
+  }
+  return nullptr;
+}
+
+// Schema node of the data node at `elements`, or nullptr when the schema does
+// not have it
+static const path::SchemaNode* find_schema(
+    path::RootSchemaNode& root_schema,
+    const vector<const gnmi::PathElem*>& elements, const string& origin) {
+  if (elements.empty()) return nullptr;
+  auto top = elements[0]->name();
+  if (top.find(':') == string::npos && !origin.empty()) {
+    top.insert(0, origin + ":");
+  }
+
+  const path::SchemaNode* schema = nullptr;
+  if (top.find(':') != string::npos) {
+    // loads the module of the node on demand
+    auto found = root_schema.find(top);
+    if (!found.empty()) schema = found[0];
+  } else {
+    schema = find_child_schema(root_schema, top);
+  }
+  for (size_t i = 1; schema && i < elements.size(); i++) {
+    schema = find_child_schema(*schema, elements[i]->name());
+  }
+  return schema;
+}
+
+static void split_json_value(const path::SchemaNode& schema, const json& value,
+                             bool ietf, vector<gnmi::PathElem>& elements,
+                             vector<gNMITelemetryLeaf>& leaves);
+
+static void split_json_members(const path::SchemaNode& schema,
+                               const json& object, bool ietf,
+                               vector<gnmi::PathElem>& elements,
+                               vector<gNMITelemetryLeaf>& leaves) {
+  if (!object.is_object()) return;
+  for (auto member = object.begin(); member != object.end(); ++member) {
+    // skip RFC 7952 metadata
+    if (member.key()[0] == '@') continue;
+    auto child = find_child_schema(schema, member.key());
+    if (child == nullptr) {
+      YLOG_WARN("Skipping unknown member '{}' of '{}'", member.key(),
+                schema.get_statement().arg);
+      continue;
+    }
+    elements.emplace_back();
+    elements.back().set_name(member.key());
+    split_json_value(*child, member.value(), ietf, elements, leaves);
+    elements.pop_back();
+  }
+}
+
+static string get_key_value(const json& entry,
+                            const path::Statement& key) {
+  auto value = entry.find(key.arg);
+  if (value == entry.end()) value = entry.find(key.module_name + ":" + key.arg);
+  if (value == entry.end()) {
+    YLOG_ERROR("Missing key '{}' of a list entry", key.arg);
+    throw(YServiceProviderError{"Missing key value for list: " + key.arg});
+  }
+  return value->is_string() ? value->get<string>() : value->dump();
+}
+
+// Appends the leaves of `value`, the value of the node at `elements`; leaf
+// and leaf-list values are kept in the encoding they came in
+static void split_json_value(const path::SchemaNode& schema, const json& value,
+                             bool ietf, vector<gnmi::PathElem>& elements,
+                             vector<gNMITelemetryLeaf>& leaves) {
+  auto keyword = schema.get_statement().keyword;
+  if (keyword == "leaf" || keyword == "leaf-list") {
+    leaves.emplace_back();
+    leaves.back().elements = elements;
+    if (ietf) {
+      leaves.back().value.set_json_ietf_val(value.dump());
+    } else {
+      leaves.back().value.set_json_val(value.dump());
+    }
+  } else if (keyword == "list" && elements.back().key_size() == 0) {
+    // the entries of the list, each addressed by its keys
+    auto keys = schema.get_keys();
+    auto list = elements.back();
+    auto split_entry = [&](const json& entry) {
+      auto& keyed = elements.back();
+      for (auto& key : keys) {
+        (*keyed.mutable_key())[key.arg] = get_key_value(entry, key);
+      }
+      split_json_members(schema, entry, ietf, elements, leaves);
+      elements.back() = list;
+    };
+    if (value.is_array()) {
+      for (auto& entry : value) split_entry(entry);
+    } else {
+      split_entry(value);
+    }
+  } else {
+    split_json_members(schema, value, ietf, elements, leaves);
+  }
+}
+
+// Splits the JSON values of containers and list entries into their leaves,
+// so that each leaf is cached, deleted and read on its own
+static gNMITelemetryLeaves split_container_values(
+    path::RootSchemaNode& root_schema, const gnmi::Notification& notification) {
+  gNMITelemetryLeaves split;
+  auto& prefix = notification.prefix();
+  for (int i = 0; i < notification.update_size(); i++) {
+    auto& update = notification.update(i);
+    auto& value = update.val();
+    bool ietf = value.value_case() == gnmi::TypedValue::kJsonIetfVal;
+    if (!ietf && value.value_case() != gnmi::TypedValue::kJsonVal) continue;
+
+    auto& origin =
+        prefix.origin().empty() ? update.path().origin() : prefix.origin();
+    auto path = join_elements(prefix, update.path());
+    try {
+      auto schema = find_schema(root_schema, path, origin);
+      if (schema == nullptr) continue;
+      auto keyword = schema->get_statement().keyword;
+      if (keyword != "container" && keyword != "list") continue;
+
+      vector<gnmi::PathElem> elements;
+      for (auto elem : path) elements.push_back(*elem);
+      vector<gNMITelemetryLeaf> leaves;
+      auto& payload = ietf ? value.json_ietf_val() : value.json_val();
+      split_json_value(*schema, json::parse(payload), ietf, elements, leaves);
+      split[i] = move(leaves);
+    } catch (YError& err) {
+      YLOG_WARN("Caching a container value as is: {}", err.what());
+    } catch (invalid_argument& err) {
+      YLOG_WARN("Caching a container value as is: {}", err.what());
+    }
+  }
+  return split;
+}
+
+static size_t count_values(const gNMITelemetryNode& node) {
+  size_t count = node.has_value ? 1 : 0;
+  for (auto& child : node.children) count += count_values(*child.second);
+  return count;
+}
+
+static void collect_updates(const gNMITelemetryNode& node,
+                            vector<path::PathElement>& elements,
+                            vector<path::DataUpdate>& updates) {
+  if (node.has_value) {
+    updates.emplace_back();
+    updates.back().path = elements;
+    set_update_value(node.value, updates.back());
+  }
+  for (auto& child : node.children) {
+    elements.push_back({child.second->name, child.second->keys});
+    collect_updates(*child.second, elements, updates);
+    elements.pop_back();
+  }
+}
+
+class gNMITelemetryTree {
+ public:
+  gNMITelemetryTree() : synchronized{false}, values{0} {}
+
+  // Deletes come first, as required for notifications carrying both. The
+  // updates found in `split` are cached as their leaves.
+  void apply(const gnmi::Notification& notification,
+             const gNMITelemetryLeaves& split) {
+    auto& prefix = notification.prefix();
+    for (auto& path : notification.delete_()) {
+      remove(join_elements(prefix, path));
+    }
+    for (int i = 0; i < notification.update_size(); i++) {
+      auto& update = notification.update(i);
+      auto& path = update.path();
+      auto& origin = prefix.origin().empty() ? path.origin() : prefix.origin();
+      auto leaves = split.find(i);
+      if (leaves == split.end()) {
+        set_value(insert(join_elements(prefix, path), origin), update.val(),
+                  notification.timestamp());
+        continue;
+      }
+      for (auto& leaf : leaves->second) {
+        set_value(insert(get_elements(leaf.elements), origin), leaf.value,
+                  notification.timestamp());
+      }
+    }
+  }
+
+  // Returns the node at `elements` and appends the path to it, or nullptr
+  gNMITelemetryNode* find(const vector<const gnmi::PathElem*>& elements,
+                          vector<path::PathElement>* path = nullptr) {
+    gNMITelemetryNode* node = &root;
+    for (auto elem : elements) {
+      auto child = node->children.find(get_path_element_id(*elem));
+      if (child == node->children.end()) return nullptr;
+      node = child->second.get();
+      if (path) path->push_back({node->name, node->keys});
+    }
+    return node;
+  }
+
+  void clear() {
+    root.children.clear();
+    root.has_value = false;
+    values = 0;
+  }
+
+  mutex tree_mutex;
+  bool synchronized;
+  size_t values;
+
+ private:
+  void set_value(gNMITelemetryNode* node, const gnmi::TypedValue& value,
+                 uint64 timestamp) {
+    if (!node->has_value) {
+      node->has_value = true;
+      values++;
+    }
+    node->value = value;
+    node->timestamp = timestamp;
+  }
+
+  gNMITelemetryNode* insert(const vector<const gnmi::PathElem*>& elements,
+                            const string& origin) {
+    gNMITelemetryNode* node = &root;
+    for (auto elem : elements) {
+      auto& child = node->children[get_path_element_id(*elem)];
+      if (!child) {
+        child.reset(new gNMITelemetryNode{});
+        child->name = elem->name();
+        // the origin names the module of the top-level node
+        if (node == &root && !origin.empty() &&
+            child->name.find(':') == string::npos) {
+          child->name.insert(0, origin + ":");
+        }
+        child->keys.assign(elem->key().begin(), elem->key().end());
+      }
+      node = child.get();
+    }
+    return node;
+  }
+
+  void remove(const vector<const gnmi::PathElem*>& elements) {
+    if (elements.empty()) {
+      clear();
+      return;
+    }
+    vector<const gnmi::PathElem*> parent_elements(elements.begin(),
+                                                  elements.end() - 1);
+    auto parent = find(parent_elements);
+    if (parent == nullptr) return;
+    auto child = parent->children.find(get_path_element_id(*elements.back()));
+    if (child == parent->children.end()) return;
+    values -= count_values(*child->second);
+    parent->children.erase(child);
+  }
+
+  gNMITelemetryNode root;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// gNMITelemetryCache
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+gNMITelemetryCache::gNMITelemetryCache(path::RootSchemaNode& root_schema)
+    : root_schema(root_schema) {}
+
+gNMITelemetryCache::~gNMITelemetryCache() {}
+
+void gNMITelemetryCache::update(const gnmi::SubscribeResponse& response,
+                                const string& target) {
+  if (response.has_update()) {
+    // the schema lookups run outside of the tree lock
+    auto split = split_container_values(root_schema, response.update());
+    auto tree = add_tree(target);
+    lock_guard<mutex> guard{tree->tree_mutex};
+    tree->apply(response.update(), split);
+  } else if (response.sync_response()) {
+    YLOG_DEBUG("Telemetry cache synchronized for target '{}'", target);
+    auto tree = add_tree(target);
+    lock_guard<mutex> guard{tree->tree_mutex};
+    tree->synchronized = true;
+  }
+}
+
+GnmiSubscribeCallback gNMITelemetryCache::get_callback(const string& target) {
+  return [this, target](const gnmi::SubscribeResponse& response) {
+    update(response, target);
+  };
+}
+
+bool gNMITelemetryCache::is_synchronized(const string& target) const {
+  auto tree = get_tree(target);
+  if (!tree) return false;
+  lock_guard<mutex> guard{tree->tree_mutex};
+  return tree->synchronized;
+}
+
+vector<string> gNMITelemetryCache::get_targets() const {
+  vector<string> targets;
+  lock_guard<mutex> guard{trees_mutex};
+  for (auto& tree : trees) targets.push_back(tree.first);
+  return targets;
+}
+
+size_t gNMITelemetryCache::size(const string& target) const {
+  auto tree = get_tree(target);
+  if (!tree) return 0;
+  lock_guard<mutex> guard{tree->tree_mutex};
+  return tree->values;
+}
+
+void gNMITelemetryCache::clear(const string& target) {
+  auto tree = get_tree(target);
+  if (!tree) return;
+  lock_guard<mutex> guard{tree->tree_mutex};
+  tree->clear();
+  tree->synchronized = false;
+}
+
+bool gNMITelemetryCache::get_value(const gnmi::Path& path,
+                                   gnmi::TypedValue& value,
+                                   const string& target) const {
+  uint64 timestamp;
+  return get_value(path, value, timestamp, target);
+}
+
+bool gNMITelemetryCache::get_value(const gnmi::Path& path,
+                                   gnmi::TypedValue& value, uint64& timestamp,
+                                   const string& target) const {
+  auto tree = get_tree(target);
+  if (!tree) return false;
+  lock_guard<mutex> guard{tree->tree_mutex};
+  auto node = tree->find(join_elements(gnmi::Path::default_instance(), path));
+  if (node == nullptr || !node->has_value) return false;
+  value = node->value;
+  timestamp = node->timestamp;
+  return true;
+}
+
+shared_ptr<path::DataNode> gNMITelemetryCache::get_datanode(
+    const gnmi::Path& path, const string& target) const {
+  auto tree = get_tree(target);
+  if (!tree) return nullptr;
+
+  vector<path::DataUpdate> updates;
+  {
+    lock_guard<mutex> guard{tree->tree_mutex};
+    vector<path::PathElement> elements;
+    auto node = tree->find(
+        join_elements(gnmi::Path::default_instance(), path), &elements);
+    if (node) collect_updates(*node, elements, updates);
+  }
+  if (updates.empty()) return nullptr;
+
+  // the schema lookups run outside of the tree lock
+  path::Codec codec{};
+  return codec.decode_updates(root_schema, updates);
+}
+
+shared_ptr<Entity> gNMITelemetryCache::get_entity(Entity& filter,
+                                                  const string& target) const {
+  YFilter original_yfilter = filter.yfilter;
+  if (!filter.is_top_level_class && original_yfilter == YFilter::not_set) {
+    filter.yfilter = YFilter::read;
+  }
+  gnmi::Path path;
+  parse_entity_to_path(*get_top_entity(&filter), &path);
+  filter.yfilter = original_yfilter;
+
+  auto root_dn = get_datanode(path, target);
+  if (!root_dn) return nullptr;
+  return read_datanode(filter, root_dn->get_children()[0]);
+}
+
+shared_ptr<gNMITelemetryTree> gNMITelemetryCache::get_tree(
+    const string& target) const {
+  lock_guard<mutex> guard{trees_mutex};
+  auto tree = trees.find(target);
+  return tree == trees.end() ? nullptr : tree->second;
+}
+
+shared_ptr<gNMITelemetryTree> gNMITelemetryCache::add_tree(
+    const string& target) {
+  lock_guard<mutex> guard{trees_mutex};
+  auto& tree = trees[target];
+  if (!tree) tree = make_shared<gNMITelemetryTree>();
+  return tree;
+}
+
+}  // namespace ydk
@@ -0,0 +1,96 @@
+/// YANG Development Kit
+// Copyright 2016 Cisco Systems. All rights reserved
+//
+////////////////////////////////////////////////////////////////
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+//////////////////////////////////////////////////////////////////
+
+#ifndef _YDK_GNMI_TELEMETRY_CACHE_H_
+#define _YDK_GNMI_TELEMETRY_CACHE_H_
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <ydk/path_api.hpp>
+
+#include "gnmi_client.hpp"
+
+namespace ydk {
+
+class gNMITelemetryTree;
+
+///
+/// @brief Latest state of the targets a set of subscriptions report on.
+///
+/// Updates and deletes of the SubscribeResponses fed to the cache are kept
+/// in one tree per target, indexed by path element, so applying an update
+/// costs one lookup per element of its path. Targets are named by the caller
+/// feeding the cache; list entries are looked up by their keys. JSON values
+/// of containers and lists are split into their leaves along the schema, so
+/// each leaf can be read or deleted on its own.
+///
+/// All methods may be called concurrently. Queries read the cache as it was
+/// at the time of the call and never contact the target.
+///
+class gNMITelemetryCache {
+ public:
+  explicit gNMITelemetryCache(path::RootSchemaNode& root_schema);
+  ~gNMITelemetryCache();
+
+  // Applies the updates and deletes of a response to the state of `target`,
+  // or marks it as synchronized on sync_response
+  void update(const gnmi::SubscribeResponse& response,
+              const std::string& target = "");
+  // Returns a subscription callback feeding the cache
+  GnmiSubscribeCallback get_callback(const std::string& target = "");
+
+  bool is_synchronized(const std::string& target = "") const;
+  std::vector<std::string> get_targets() const;
+  // Number of values cached for the target
+  std::size_t size(const std::string& target = "") const;
+  void clear(const std::string& target = "");
+
+  // Copies the latest value at `path` and returns true, or returns false when
+  // nothing is cached there. The origin of the path may be omitted.
+  bool get_value(const gnmi::Path& path, gnmi::TypedValue& value,
+                 const std::string& target = "") const;
+  bool get_value(const gnmi::Path& path, gnmi::TypedValue& value,
+                 uint64& timestamp, const std::string& target = "") const;
+
+  // Snapshot of the subtree at `path`, nullptr when nothing is cached there
+  std::shared_ptr<path::DataNode> get_datanode(
+      const gnmi::Path& path, const std::string& target = "") const;
+  // Snapshot of the subtree read by `filter`, as a new Entity
+  std::shared_ptr<Entity> get_entity(Entity& filter,
+                                     const std::string& target = "") const;
+
+ private:
+  std::shared_ptr<gNMITelemetryTree> get_tree(const std::string& target) const;
+  std::shared_ptr<gNMITelemetryTree> add_tree(const std::string& target);
+
+  path::RootSchemaNode& root_schema;
+  mutable std::mutex trees_mutex;
+  std::unordered_map<std::string, std::shared_ptr<gNMITelemetryTree>> trees;
+};
+
+}  // namespace ydk
+
+#endif /* _YDK_GNMI_TELEMETRY_CACHE_H_ */
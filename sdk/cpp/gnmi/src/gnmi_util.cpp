@@ -23,14 +23,19 @@
 
 #include "gnmi_util.hpp"
 
+#include <ctype.h>
+
 #include <algorithm>
+#include <sstream>
 #include <vector>
 #include <ydk/common_utilities.hpp>
 #include <ydk/entity_util.hpp>
 #include <ydk/errors.hpp>
+#include <ydk/json.hpp>
 #include <ydk/logger.hpp>
 
 using namespace std;
+using json = nlohmann::json;
 
 namespace ydk {
 
@@ -265,6 +270,71 @@ void parse_entity_to_path(Entity& entity, gnmi::Path* path) {
     parse_entity(entity, path);
 }
 
+// Leaf values carry no YANG type; they are encoded the way JsonSubtreeCodec
+// encodes them
+static json get_json_leaf_value(const string& value) {
+  if (value.empty() || value == "null") return json{};
+  if (value == "true") return json(true);
+  if (value == "false") return json(false);
+  if (all_of(value.begin(), value.end(), ::isdigit)) return json(stoll(value));
+  return json(value);
+}
+
+static string get_leaf_value(Entity& entity, const string& leaf_name,
+                             const LeafData& leaf_data) {
+  if (leaf_data.name_space.empty() || leaf_data.name_space_prefix.empty())
+    return leaf_data.value;
+
+  // identities are qualified with the name of their module
+  auto lookup = get_top_entity(&entity)->get_namespace_identity_lookup();
+  auto module = lookup.find({leaf_name, leaf_data.name_space});
+  if (module == lookup.end()) return leaf_data.value;
+  return module->second + ":" + leaf_data.value;
+}
+
+static json get_entity_json(Entity& entity) {
+  json object = json::object();
+  for (auto& name_value : entity.get_name_leaf_data()) {
+    if (!name_value.second.is_set) continue;
+    auto name = name_value.first;
+    auto leaf_data = name_value.second;
+    auto pos = name.find("[.=\"");
+    if (pos != string::npos) {
+      // leaf-list entry
+      leaf_data.value = name.substr(pos + 4, name.length() - pos - 6);
+      name = name.substr(0, pos);
+      object[name].push_back(
+          get_json_leaf_value(get_leaf_value(entity, name, leaf_data)));
+    } else {
+      object[name] =
+          get_json_leaf_value(get_leaf_value(entity, name, leaf_data));
+    }
+  }
+  for (auto& child : entity.get_children()) {
+    if (child.second == nullptr) continue;
+    auto& child_entity = *child.second;
+    if (!child_entity.has_data() && !child_entity.is_presence_container)
+      continue;
+    auto name = child_entity.get_segment_path();
+    name = name.substr(0, name.find('['));
+    if (child_entity.ylist != nullptr) {
+      object[name].push_back(get_entity_json(child_entity));
+    } else {
+      object[name] = get_entity_json(child_entity);
+    }
+  }
+  return object;
+}
+
+void parse_entity_to_path_and_value(Entity& entity, gnmi::Path* path,
+                                    gnmi::TypedValue* value) {
+  // the path ends at the entity, the value holds its leaves and children
+  parse_entity_prefix(entity, path);
+  if (!entity.is_top_level_class)
+    add_path_elem(path, entity.get_segment_path());
+  value->set_json_ietf_val(get_entity_json(entity).dump());
+}
+
 void parse_prefix_to_path(const string& prefix, gnmi::Path* path) {
   // Add origin and first container to the path
   string mod = prefix;
@@ -286,6 +356,138 @@ void parse_prefix_to_path(const string& prefix, gnmi::Path* path) {
   }
 }
 
+string get_path_element_id(const gnmi::PathElem& elem) {
+  auto& name = elem.name();
+  auto colon = name.find(':');
+  string id = colon == string::npos ? name : name.substr(colon + 1);
+  if (elem.key_size() == 0) return id;
+
+  vector<pair<string, string>> keys(elem.key().begin(), elem.key().end());
+  sort(keys.begin(), keys.end());
+  for (auto& key : keys) {
+    id += '[' + key.first + '=' + key.second + ']';
+  }
+  return id;
+}
+
+static void append_path_elements(const gnmi::Path& path,
+                                 vector<path::PathElement>& elements) {
+  for (auto& elem : path.elem()) {
+    elements.emplace_back();
+    auto& element = elements.back();
+    element.name = elem.name();
+    element.keys.assign(elem.key().begin(), elem.key().end());
+  }
+}
+
+static string format_decimal(const gnmi::Decimal64& value) {
+  string digits = std::to_string(value.digits());
+  if (value.precision() == 0) return digits;
+  if (digits.size() <= value.precision())
+    digits.insert(0, value.precision() - digits.size() + 1, '0');
+  digits.insert(digits.size() - value.precision(), 1, '.');
+  return digits;
+}
+
+static string encode_base64(const string& bytes) {
+  static const char* alphabet =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  string encoded;
+  encoded.reserve((bytes.size() + 2) / 3 * 4);
+  for (size_t i = 0; i < bytes.size(); i += 3) {
+    uint32_t group = static_cast<unsigned char>(bytes[i]) << 16;
+    if (i + 1 < bytes.size())
+      group |= static_cast<unsigned char>(bytes[i + 1]) << 8;
+    if (i + 2 < bytes.size()) group |= static_cast<unsigned char>(bytes[i + 2]);
+    encoded += alphabet[(group >> 18) & 0x3f];
+    encoded += alphabet[(group >> 12) & 0x3f];
+    encoded += i + 1 < bytes.size() ? alphabet[(group >> 6) & 0x3f] : '=';
+    encoded += i + 2 < bytes.size() ? alphabet[group & 0x3f] : '=';
+  }
+  return encoded;
+}
+
+static void append_scalar_value(const gnmi::TypedValue& value,
+                                vector<string>& values) {
+  switch (value.value_case()) {
+    case gnmi::TypedValue::kStringVal:
+      values.push_back(value.string_val());
+      break;
+    case gnmi::TypedValue::kIntVal:
+      values.push_back(std::to_string(value.int_val()));
+      break;
+    case gnmi::TypedValue::kUintVal:
+      values.push_back(std::to_string(value.uint_val()));
+      break;
+    case gnmi::TypedValue::kBoolVal:
+      values.push_back(value.bool_val() ? "true" : "false");
+      break;
+    case gnmi::TypedValue::kBytesVal:
+      values.push_back(encode_base64(value.bytes_val()));
+      break;
+    case gnmi::TypedValue::kFloatVal: {
+      ostringstream os;
+      os << value.float_val();
+      values.push_back(os.str());
+      break;
+    }
+    case gnmi::TypedValue::kDecimalVal:
+      values.push_back(format_decimal(value.decimal_val()));
+      break;
+    case gnmi::TypedValue::kAsciiVal:
+      values.push_back(value.ascii_val());
+      break;
+    default:
+      YLOG_WARN("Skipping unsupported value '{}'", value.ShortDebugString());
+      break;
+  }
+}
+
+void set_update_value(const gnmi::TypedValue& value,
+                      path::DataUpdate& update) {
+  switch (value.value_case()) {
+    case gnmi::TypedValue::kJsonIetfVal:
+      update.values.push_back(value.json_ietf_val());
+      update.json = true;
+      break;
+    case gnmi::TypedValue::kJsonVal:
+      update.values.push_back(value.json_val());
+      update.json = true;
+      break;
+    case gnmi::TypedValue::kLeaflistVal:
+      for (auto& element : value.leaflist_val().element())
+        append_scalar_value(element, update.values);
+      break;
+    case gnmi::TypedValue::VALUE_NOT_SET:
+      break;
+    default:
+      append_scalar_value(value, update.values);
+      break;
+  }
+}
+
+void append_notification_updates(const gnmi::Notification& notification,
+                                 vector<path::DataUpdate>& updates) {
+  auto& prefix = notification.prefix();
+  for (auto& update : notification.update()) {
+    updates.emplace_back();
+    auto& data_update = updates.back();
+    data_update.path.reserve(prefix.elem_size() + update.path().elem_size());
+    append_path_elements(prefix, data_update.path);
+    append_path_elements(update.path(), data_update.path);
+
+    // the origin names the module of the top-level node
+    auto& origin =
+        prefix.origin().empty() ? update.path().origin() : prefix.origin();
+    if (!origin.empty() && !data_update.path.empty() &&
+        data_update.path[0].name.find(':') == string::npos) {
+      data_update.path[0].name.insert(0, origin + ":");
+    }
+
+    set_update_value(update.val(), data_update);
+  }
+}
+
 namespace path {
 
 static path::DataNode* get_last_datanode(DataNode* dn) {
@@ -49,9 +49,23 @@ void parse_entity_prefix(Entity& entity,
                          std::pair<std::string, std::string>& prefix);
 
 void parse_entity_to_path(Entity& entity, gnmi::Path* path);
+// Builds the path to the entity and the JSON_IETF value of its leaves and
+// children in one walk over the entity
+void parse_entity_to_path_and_value(Entity& entity, gnmi::Path* path,
+                                    gnmi::TypedValue* value);
 void parse_entity_prefix(Entity& entity, gnmi::Path* path);
 
 void parse_prefix_to_path(const std::string& prefix, gnmi::Path* path);
+// Identifies an element among its siblings: the name without module prefix,
+// followed by the keys in key order
+std::string get_path_element_id(const gnmi::PathElem& elem);
+
+// Appends the updates of a notification, each with the notification prefix
+// joined to its path, in the form taken by path::Codec::decode_updates
+void append_notification_updates(const gnmi::Notification& notification,
+                                 std::vector<path::DataUpdate>& updates);
+// Sets the values of `update` from a TypedValue
+void set_update_value(const gnmi::TypedValue& value, path::DataUpdate& update);
 
 namespace path {
 void parse_datanode_to_path(DataNode* dn, gnmi::Path* path);
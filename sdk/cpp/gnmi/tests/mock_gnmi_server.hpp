@@ -0,0 +1,168 @@
+/// YANG Development Kit
+// Copyright 2016 Cisco Systems. All rights reserved
+//
+////////////////////////////////////////////////////////////////
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+//////////////////////////////////////////////////////////////////
+
+#ifndef MOCK_GNMI_SERVER_HPP
+#define MOCK_GNMI_SERVER_HPP
+
+#include <grpc++/grpc++.h>
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <ydk/gnmi.grpc.pb.h>
+
+namespace mock {
+
+// Builds a notification carrying `leaves` integer counters under
+// /interfaces/interface[name=<name>]/state/counters.
+inline gnmi::Notification build_counters_notification(const std::string& name,
+                                                      int leaves,
+                                                      uint64_t value) {
+  gnmi::Notification notification;
+  notification.set_timestamp(value);
+  auto prefix = notification.mutable_prefix();
+  prefix->set_origin("openconfig-interfaces");
+  prefix->add_elem()->set_name("interfaces");
+  auto interface = prefix->add_elem();
+  interface->set_name("interface");
+  (*interface->mutable_key())["name"] = name;
+  prefix->add_elem()->set_name("state");
+  prefix->add_elem()->set_name("counters");
+
+  for (int i = 0; i < leaves; i++) {
+    auto update = notification.add_update();
+    update->mutable_path()->add_elem()->set_name("counter-" +
+                                                 std::to_string(i));
+    update->mutable_val()->set_uint_val(value + i);
+  }
+  return notification;
+}
+
+// In-process stand-in for a gNMI target. Every subscription receives
+// `notifications` updates followed by sync_response, then the stream ends
+// for ONCE subscriptions. POLL subscriptions get the same burst per poll.
+// `latency` delays every burst, standing in for the round trip to a device.
+class MockgNMIServer : public gnmi::gNMI::Service {
+ public:
+  MockgNMIServer(int notifications = 1, int leaves = 4,
+                 std::chrono::milliseconds latency = {})
+      : notifications{notifications},
+        leaves{leaves},
+        latency{latency},
+        port{0} {
+    grpc::ServerBuilder builder;
+    builder.AddListeningPort("127.0.0.1:0", grpc::InsecureServerCredentials(),
+                             &port);
+    builder.RegisterService(this);
+    server = builder.BuildAndStart();
+  }
+
+  ~MockgNMIServer() { server->Shutdown(); }
+
+  grpc::Status Capabilities(grpc::ServerContext*,
+                            const gnmi::CapabilityRequest*,
+                            gnmi::CapabilityResponse* response) override {
+    response->set_gnmi_version("0.4.0");
+    response->add_supported_encodings(gnmi::Encoding::JSON_IETF);
+    return grpc::Status::OK;
+  }
+
+  grpc::Status Subscribe(
+      grpc::ServerContext*,
+      grpc::ServerReaderWriter<gnmi::SubscribeResponse, gnmi::SubscribeRequest>*
+          stream) override {
+    gnmi::SubscribeRequest request;
+    if (!stream->Read(&request) || !request.has_subscribe()) {
+      return grpc::Status(grpc::StatusCode::INVALID_ARGUMENT,
+                          "expected subscription list");
+    }
+    send_updates(stream);
+    if (request.subscribe().mode() == gnmi::SubscriptionList::POLL) {
+      while (stream->Read(&request)) {
+        if (request.has_poll()) send_updates(stream);
+      }
+    }
+    return grpc::Status::OK;
+  }
+
+  // Replies with `get_payload` under the first path requested, compressed
+  // with `reply_compression`
+  grpc::Status Get(grpc::ServerContext* context,
+                   const gnmi::GetRequest* request,
+                   gnmi::GetResponse* response) override {
+    std::this_thread::sleep_for(latency);
+    context->set_compression_algorithm(reply_compression);
+    auto update = response->add_notification()->add_update();
+    if (request->path_size() > 0) *update->mutable_path() = request->path(0);
+    update->mutable_val()->set_json_ietf_val(get_payload);
+    return grpc::Status::OK;
+  }
+
+  // Records the request and reports success
+  grpc::Status Set(grpc::ServerContext*, const gnmi::SetRequest* request,
+                   gnmi::SetResponse*) override {
+    std::this_thread::sleep_for(latency);
+    std::lock_guard<std::mutex> guard{set_mutex};
+    set_requests.push_back(*request);
+    return grpc::Status::OK;
+  }
+
+  std::vector<gnmi::SetRequest> get_set_requests() {
+    std::lock_guard<std::mutex> guard{set_mutex};
+    return set_requests;
+  }
+
+  std::string get_payload = "{}";
+  grpc_compression_algorithm reply_compression = GRPC_COMPRESS_NONE;
+  int notifications;
+  int leaves;
+  std::chrono::milliseconds latency;
+  int port;
+
+ private:
+  void send_updates(
+      grpc::ServerReaderWriter<gnmi::SubscribeResponse, gnmi::SubscribeRequest>*
+          stream) {
+    std::this_thread::sleep_for(latency);
+    gnmi::SubscribeResponse response;
+    for (int i = 0; i < notifications; i++) {
+      *response.mutable_update() =
+          build_counters_notification("Loopback10", leaves, i);
+      stream->Write(response);
+    }
+    response.Clear();
+    response.set_sync_response(true);
+    stream->Write(response);
+  }
+
+  std::mutex set_mutex;
+  std::vector<gnmi::SetRequest> set_requests;
+  std::unique_ptr<grpc::Server> server;
+};
+
+}  // namespace mock
+
+#endif /* MOCK_GNMI_SERVER_HPP */
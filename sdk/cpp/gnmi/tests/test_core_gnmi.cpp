@@ -23,7 +23,9 @@
 
 #include <spdlog/spdlog.h>
 
+#include <chrono>
 #include <iostream>
+#include <sstream>
 #include <ydk/filters.hpp>
 #include <ydk/gnmi_path_api.hpp>
 #include <ydk/gnmi_provider.hpp>
@@ -263,6 +265,156 @@ elem {
   delete path;
 }
 
+TEST_CASE("test_gnmi_entity_to_path_and_value") {
+  auto ifc =
+      std::make_shared<ydktest::openconfig_interfaces::Interfaces::Interface>();
+  ifc->name = "Loopback10";
+  ifc->config->name = "Loopback10";
+  ifc->config->description = "Test";
+  ifc->config->enabled = true;
+  ifc->config->mtu = 1500;
+
+  ydktest::openconfig_interfaces::Interfaces ifcs{};
+  ifcs.interface.append(ifc);
+
+  gnmi::Path path{};
+  gnmi::TypedValue value{};
+  ydk::parse_entity_to_path_and_value(ifcs, &path, &value);
+
+  REQUIRE(path.DebugString() == R"(origin: "openconfig-interfaces"
+elem {
+  name: "interfaces"
+}
+)");
+  REQUIRE(value.json_ietf_val() ==
+          R"({"interface":[{"config":{"description":"Test","enabled":true,)"
+          R"("mtu":1500,"name":"Loopback10"},"name":"Loopback10"}]})");
+
+  path.Clear();
+  value.Clear();
+  ydk::parse_entity_to_path_and_value(*ifc, &path, &value);
+
+  REQUIRE(path.DebugString() == R"(origin: "openconfig-interfaces"
+elem {
+  name: "interfaces"
+}
+elem {
+  name: "interface"
+  key {
+    key: "name"
+    value: "Loopback10"
+  }
+}
+)");
+  REQUIRE(value.json_ietf_val() ==
+          R"({"config":{"description":"Test","enabled":true,"mtu":1500,)"
+          R"("name":"Loopback10"},"name":"Loopback10"})");
+}
+
+static gnmi::Path* add_update_path(gnmi::Notification& notification,
+                                   const std::string& path) {
+  auto update_path = notification.add_update()->mutable_path();
+  for (auto& segment : ydk::path::segmentalize(path)) {
+    update_path->add_elem()->set_name(segment);
+  }
+  return update_path;
+}
+
+TEST_CASE("test_gnmi_decode_get_response") {
+  ydk::path::Repository repo{TEST_HOME};
+  mock::MockSession sp{TEST_HOME, test_openconfig};
+  auto& schema = sp.get_root_schema();
+
+  gnmi::GetResponse response;
+  auto notification = response.add_notification();
+  notification->mutable_prefix()->set_origin("openconfig-bgp");
+  notification->mutable_prefix()->add_elem()->set_name("bgp");
+  add_update_path(*notification, "global/config/as");
+  notification->mutable_update(0)->mutable_val()->set_uint_val(65172);
+  add_update_path(*notification, "global/config/router-id");
+  notification->mutable_update(1)->mutable_val()->set_string_val("1.2.3.4");
+  auto neighbor = add_update_path(*notification, "neighbors/neighbor");
+  (*neighbor->mutable_elem(1)->mutable_key())["neighbor-address"] = "6.7.8.9";
+  notification->mutable_update(2)->mutable_val()->set_json_ietf_val(
+      R"({"config": {"neighbor-address": "6.7.8.9", "peer-as": 65001}})");
+
+  std::vector<ydk::path::DataUpdate> updates;
+  ydk::append_notification_updates(*notification, updates);
+  REQUIRE(updates.size() == 3);
+  REQUIRE(updates[0].path[0].name == "openconfig-bgp:bgp");
+  REQUIRE(updates[0].values == std::vector<std::string>{"65172"});
+  REQUIRE(updates[2].json);
+
+  ydk::path::Codec s{};
+  auto rdn = s.decode_updates(schema, updates);
+  auto expected = s.decode(schema, R"({"openconfig-bgp:bgp": {
+        "global": {"config": {"as": 65172, "router-id": "1.2.3.4"}},
+        "neighbors": {"neighbor": [{"neighbor-address": "6.7.8.9",
+          "config": {"neighbor-address": "6.7.8.9", "peer-as": 65001}}]}}})",
+                           ydk::EncodingFormat::JSON);
+  REQUIRE(s.encode(*rdn, ydk::EncodingFormat::JSON, false) ==
+          s.encode(*expected, ydk::EncodingFormat::JSON, false));
+}
+
+TEST_CASE("gnmi_decode_get_response_benchmark", "[.benchmark]") {
+  ydk::path::Repository repo{TEST_HOME};
+  mock::MockSession sp{TEST_HOME, test_openconfig};
+  auto& schema = sp.get_root_schema();
+  const int interfaces = 25000;
+
+  // 4 leaves per interface, sent as PROTO scalars
+  gnmi::GetResponse response;
+  std::ostringstream json;
+  json << R"({"openconfig-interfaces:interfaces": {"interface": [)";
+  for (int i = 0; i < interfaces; i++) {
+    auto name = "GigabitEthernet0/0/0/" + std::to_string(i);
+    auto notification = response.add_notification();
+    auto prefix = notification->mutable_prefix();
+    prefix->set_origin("openconfig-interfaces");
+    prefix->add_elem()->set_name("interfaces");
+    auto interface = prefix->add_elem();
+    interface->set_name("interface");
+    (*interface->mutable_key())["name"] = name;
+    prefix->add_elem()->set_name("config");
+
+    add_update_path(*notification, "name");
+    notification->mutable_update(0)->mutable_val()->set_string_val(name);
+    add_update_path(*notification, "description");
+    notification->mutable_update(1)->mutable_val()->set_string_val("uplink");
+    add_update_path(*notification, "mtu");
+    notification->mutable_update(2)->mutable_val()->set_uint_val(9000);
+    add_update_path(*notification, "enabled");
+    notification->mutable_update(3)->mutable_val()->set_bool_val(true);
+
+    json << (i ? "," : "") << R"({"name": ")" << name
+         << R"(", "config": {"name": ")" << name
+         << R"(", "description": "uplink", "mtu": 9000, "enabled": true}})";
+  }
+  json << "]}}";
+
+  ydk::path::Codec s{};
+  auto start = std::chrono::steady_clock::now();
+  std::vector<ydk::path::DataUpdate> updates;
+  for (auto& notification : response.notification()) {
+    ydk::append_notification_updates(notification, updates);
+  }
+  auto rdn = s.decode_updates(schema, updates);
+  auto native = std::chrono::duration<double>(
+                    std::chrono::steady_clock::now() - start)
+                    .count();
+
+  start = std::chrono::steady_clock::now();
+  auto text = s.decode_json_output(schema, {json.str()});
+  auto parsed = std::chrono::duration<double>(
+                    std::chrono::steady_clock::now() - start)
+                    .count();
+
+  REQUIRE(s.encode(*rdn, ydk::EncodingFormat::JSON, false) ==
+          s.encode(*text, ydk::EncodingFormat::JSON, false));
+  std::cout << interfaces * 4 << " leaves: native " << native
+            << "s, JSON text " << parsed << "s" << std::endl;
+}
+
 TEST_CASE("gnmi_test_json_payload") {
   ydk::path::Repository repo{TEST_HOME};
 
@@ -311,6 +311,50 @@ TEST_CASE("gnmi_service_delete") {
   REQUIRE(get_after_delete_reply);
 }
 
+TEST_CASE("gnmi_service_set_batch") {
+  path::Repository repo{TEST_HOME};
+  string address = "127.0.0.1";
+  int port = 50051;
+  gNMIServiceProvider provider{repo, address, port, "admin", "admin"};
+  gNMIService gs{};
+
+  openconfig_bgp::Bgp bgp{};
+  bgp.yfilter = YFilter::delete_;
+
+  auto ifc = make_shared<openconfig_interfaces::Interfaces::Interface>();
+  ifc->name = "Loopback10";
+  ifc->config->name = "Loopback10";
+  ifc->config->description = "Batch";
+  openconfig_interfaces::Interfaces ifcs{};
+  ifcs.yfilter = YFilter::replace;
+  ifcs.interface.append(ifc);
+
+  gNMISetBatch batch{};
+  batch.add(provider, bgp);
+  batch.add(provider, ifcs);
+  // replaces the change above
+  batch.add(provider, ifcs);
+  REQUIRE(batch.size() == 2);
+  REQUIRE(batch.get_requests().size() == 1);
+  REQUIRE(gs.set(provider, batch));
+
+  openconfig_interfaces::Interfaces filter{};
+  auto get_reply = gs.get(provider, filter, "CONFIG");
+  REQUIRE(get_reply != nullptr);
+  string expected = R"( <interfaces>
+   <interface>
+     <name>Loopback10</name>
+     <config>
+       <name>Loopback10</name>
+       <description>Batch</description>
+     </config>
+   </interface>
+ </interfaces>
+)";
+  REQUIRE(entity2string(get_reply, provider.get_session().get_root_schema()) ==
+          expected);
+}
+
 TEST_CASE("gnmi_service_get_list_element") {
   path::Repository repo{TEST_HOME};
   string address = "127.0.0.1";
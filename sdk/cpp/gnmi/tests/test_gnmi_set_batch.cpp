@@ -0,0 +1,195 @@
+/// YANG Development Kit
+// Copyright 2016 Cisco Systems. All rights reserved
+//
+////////////////////////////////////////////////////////////////
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+//////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <iostream>
+#include <ydk/errors.hpp>
+#include <ydk/gnmi_set_batch.hpp>
+
+#include "../../core/src/catch.hpp"
+#include "mock_gnmi_server.hpp"
+
+using namespace std;
+using namespace ydk;
+
+static gnmi::Path interfaces_path() {
+  gnmi::Path path;
+  path.add_elem()->set_name("openconfig-interfaces:interfaces");
+  return path;
+}
+
+static gnmi::Path interface_path(const string& name) {
+  auto path = interfaces_path();
+  auto interface = path.add_elem();
+  interface->set_name("interface");
+  (*interface->mutable_key())["name"] = name;
+  return path;
+}
+
+static gnmi::Path config_path(const string& name) {
+  auto path = interface_path(name);
+  path.add_elem()->set_name("config");
+  return path;
+}
+
+static string mtu_payload(int mtu) {
+  return R"({"mtu":)" + to_string(mtu) + "}";
+}
+
+static string get_interface_name(const gnmi::Path& path) {
+  return path.elem(1).key().at("name");
+}
+
+TEST_CASE("gnmi_set_batch_drops_redundant_changes") {
+  gNMISetBatch batch;
+  batch.add("update", config_path("Loopback10"), mtu_payload(1500));
+  batch.add("update", config_path("Loopback10"), mtu_payload(1500));
+  batch.add("update", config_path("Loopback11"), mtu_payload(1500));
+  batch.add("replace", interface_path("Loopback11"),
+            R"({"name":"Loopback11"})");
+  batch.add("delete", interface_path("Loopback12"));
+  batch.add("delete", interface_path("Loopback12"));
+  REQUIRE(batch.size() == 3);
+  REQUIRE(batch.get_dropped_count() == 3);
+
+  auto requests = batch.get_requests();
+  REQUIRE(requests.size() == 1);
+  auto& request = requests[0];
+  REQUIRE(request.delete__size() == 1);
+  REQUIRE(get_interface_name(request.delete_(0)) == "Loopback12");
+  REQUIRE(request.replace_size() == 1);
+  REQUIRE(get_interface_name(request.replace(0).path()) == "Loopback11");
+  REQUIRE(request.update_size() == 1);
+  REQUIRE(get_interface_name(request.update(0).path()) == "Loopback10");
+  REQUIRE(request.update(0).val().json_ietf_val() == mtu_payload(1500));
+
+  REQUIRE_THROWS_AS(batch.add("merge", interfaces_path()),
+                    YServiceProviderError);
+  batch.clear();
+  REQUIRE(batch.size() == 0);
+  REQUIRE(batch.get_requests().empty());
+}
+
+TEST_CASE("gnmi_set_batch_keeps_order") {
+  gNMISetBatch batch;
+  // a target applies deletes before updates, so the delete goes in a second
+  // request
+  batch.add("update", interfaces_path(), R"({"interface":[]})");
+  batch.add("delete", config_path("Loopback10"));
+  batch.add("update", config_path("Loopback11"), mtu_payload(9000));
+  batch.add("update", interface_path("Loopback11"),
+            R"({"config":{"mtu":1500}})");
+  // updates are applied in order and the one above overlaps, so this one is
+  // not a duplicate
+  batch.add("update", config_path("Loopback11"), mtu_payload(9000));
+  batch.add("update", config_path("Loopback10"), mtu_payload(1500));
+  batch.add("update", config_path("Loopback10"), mtu_payload(1500));
+  REQUIRE(batch.size() == 6);
+
+  auto requests = batch.get_requests();
+  REQUIRE(requests.size() == 2);
+  REQUIRE(requests[0].update_size() == 1);
+  REQUIRE(requests[1].delete__size() == 1);
+  REQUIRE(requests[1].update_size() == 4);
+  REQUIRE(requests[1].update(2).val().json_ietf_val() == mtu_payload(9000));
+  REQUIRE(get_interface_name(requests[1].update(3).path()) == "Loopback10");
+}
+
+TEST_CASE("gnmi_set_batch_max_message_size") {
+  gNMISetBatch batch{1024};
+  const int changes = 100;
+  for (int i = 0; i < changes; i++) {
+    batch.add("update", config_path("Loopback" + to_string(i)),
+              mtu_payload(1500 + i));
+  }
+
+  auto requests = batch.get_requests();
+  REQUIRE(requests.size() > 1);
+  int i = 0;
+  for (auto& request : requests) {
+    REQUIRE(request.ByteSizeLong() <= 1024);
+    for (auto& update : request.update()) {
+      REQUIRE(get_interface_name(update.path()) ==
+              "Loopback" + to_string(i++));
+    }
+  }
+  REQUIRE(i == changes);
+}
+
+TEST_CASE("gnmi_set_batch_send") {
+  mock::MockgNMIServer server;
+  gNMIClient client{"127.0.0.1", server.port, "admin", "admin"};
+
+  gNMISetBatch batch;
+  batch.add("delete", interface_path("Loopback12"));
+  batch.add("update", config_path("Loopback10"), mtu_payload(1500));
+  gnmi::SetResponse response;
+  for (auto& request : batch.get_requests()) {
+    client.execute_set_operation(request, response);
+  }
+
+  auto received = server.get_set_requests();
+  REQUIRE(received.size() == 1);
+  REQUIRE(received[0].delete__size() == 1);
+  REQUIRE(received[0].update_size() == 1);
+}
+
+TEST_CASE("gnmi_set_batch_benchmark", "[.benchmark]") {
+  mock::MockgNMIServer server;
+  gNMIClient client{"127.0.0.1", server.port, "admin", "admin"};
+  const int interfaces = 10000;
+  // every tenth change repeats the previous one
+  vector<pair<gnmi::Path, string>> changes;
+  for (int i = 0; i < interfaces; i++) {
+    changes.emplace_back(config_path("Loopback" + to_string(i)),
+                         mtu_payload(1500 + i % 100));
+    if (i % 10 == 9) changes.push_back(changes.back());
+  }
+
+  auto start = chrono::steady_clock::now();
+  for (auto& change : changes) {
+    GnmiClientRequest request{"entity", change.second, &change.first, "set",
+                              "update"};
+    client.execute_set_operation(vector<GnmiClientRequest>{request});
+  }
+  auto one_per_change =
+      chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+  start = chrono::steady_clock::now();
+  gNMISetBatch batch{1024 * 1024};
+  for (auto& change : changes) {
+    batch.add("update", change.first, change.second);
+  }
+  auto requests = batch.get_requests();
+  gnmi::SetResponse response;
+  for (auto& request : requests) {
+    client.execute_set_operation(request, response);
+  }
+  auto batched =
+      chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+  REQUIRE(batch.size() == interfaces);
+  cout << changes.size() << " changes, one request each: " << one_per_change
+       << " s, batched into " << requests.size() << " requests: " << batched
+       << " s" << endl;
+}
@@ -0,0 +1,118 @@
+/// YANG Development Kit
+// Copyright 2016 Cisco Systems. All rights reserved
+//
+////////////////////////////////////////////////////////////////
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+//////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <iostream>
+#include <ydk/gnmi_client.hpp>
+
+#include "../../core/src/catch.hpp"
+#include "mock_gnmi_server.hpp"
+
+using namespace std;
+using namespace ydk;
+
+static vector<GnmiClientSubscription> counters_subscription() {
+  GnmiClientSubscription sub{};
+  sub.path = nullptr;
+  sub.subscription_mode = "SAMPLE";
+  sub.sample_interval = 1000000000;
+  sub.suppress_redundant = false;
+  sub.heartbeat_interval = 10000000000;
+  return {sub};
+}
+
+TEST_CASE("gnmi_subscribe_typed_response") {
+  mock::MockgNMIServer server{3, 4};
+  gNMIClient client{"127.0.0.1", server.port, "admin", "admin"};
+
+  int updates = 0;
+  bool synced = false;
+  client.execute_subscribe_operation_typed(
+      counters_subscription(), 0, "ONCE", "PROTO",
+      [&](const gnmi::SubscribeResponse& response) {
+        if (response.has_update()) {
+          auto& notification = response.update();
+          REQUIRE(notification.prefix().elem(1).key().at("name") ==
+                  "Loopback10");
+          REQUIRE(notification.update_size() == 4);
+          REQUIRE(notification.update(3).val().uint_val() ==
+                  static_cast<uint64_t>(updates + 3));
+          updates++;
+        } else {
+          synced = response.sync_response();
+        }
+      });
+
+  REQUIRE(updates == 3);
+  REQUIRE(synced);
+  REQUIRE(client.get_subscribe_response_count() == 4);
+  // nothing was rendered as text on the way
+  REQUIRE(client.get_last_subscribe_response().empty());
+}
+
+TEST_CASE("gnmi_subscribe_text_response") {
+  mock::MockgNMIServer server{1, 2};
+  gNMIClient client{"127.0.0.1", server.port, "admin", "admin"};
+
+  vector<string> responses;
+  client.execute_subscribe_operation(
+      counters_subscription(), 0, "ONCE", "PROTO",
+      [&](const char* response) { responses.push_back(response); }, nullptr);
+
+  REQUIRE(responses.size() == 2);
+  REQUIRE(responses[0].find("uint_val: 1") != string::npos);
+  REQUIRE(responses[1].find("sync_response: true") != string::npos);
+
+  gnmi::SubscribeResponse sync;
+  sync.set_sync_response(true);
+  REQUIRE(format_subscribe_response(sync) == responses[1]);
+}
+
+TEST_CASE("gnmi_subscribe_throughput", "[.benchmark]") {
+  const int notifications = 50000;
+  mock::MockgNMIServer server{notifications, 8};
+  gNMIClient client{"127.0.0.1", server.port, "admin", "admin"};
+
+  uint64_t sum = 0;
+  auto start = chrono::steady_clock::now();
+  client.execute_subscribe_operation_typed(
+      counters_subscription(), 0, "ONCE", "PROTO",
+      [&](const gnmi::SubscribeResponse& response) {
+        for (auto& update : response.update().update())
+          sum += update.val().uint_val();
+      });
+  auto typed =
+      chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+  size_t length = 0;
+  start = chrono::steady_clock::now();
+  client.execute_subscribe_operation(
+      counters_subscription(), 0, "ONCE", "PROTO",
+      [&](const char* response) { length += strlen(response); }, nullptr);
+  auto text =
+      chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+  REQUIRE(sum > 0);
+  cout << "typed: " << notifications / typed << " updates/s, text: "
+       << notifications / text << " updates/s" << endl;
+}
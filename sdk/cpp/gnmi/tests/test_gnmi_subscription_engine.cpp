@@ -0,0 +1,157 @@
+/// YANG Development Kit
+// Copyright 2016 Cisco Systems. All rights reserved
+//
+////////////////////////////////////////////////////////////////
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+//////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <ydk/gnmi_subscription_engine.hpp>
+
+#include "../../core/src/catch.hpp"
+#include "mock_gnmi_server.hpp"
+
+using namespace std;
+using namespace ydk;
+
+static vector<GnmiClientSubscription> counters_subscription() {
+  GnmiClientSubscription sub{};
+  sub.path = nullptr;
+  sub.subscription_mode = "SAMPLE";
+  sub.sample_interval = 1000000000;
+  sub.suppress_redundant = false;
+  sub.heartbeat_interval = 10000000000;
+  return {sub};
+}
+
+TEST_CASE("gnmi_subscription_engine_shared_channels") {
+  mock::MockgNMIServer server1{5, 2}, server2{3, 2};
+  gNMIClient client1{"127.0.0.1", server1.port, "admin", "admin"};
+  gNMIClient client2{"127.0.0.1", server2.port, "admin", "admin"};
+  gNMISubscriptionEngine engine{2};
+
+  const int subscriptions = 50;
+  atomic<int> responses{0}, done{0};
+  vector<shared_ptr<gNMISubscriptionHandle>> handles;
+  for (int i = 0; i < subscriptions; i++) {
+    handles.push_back(engine.subscribe(
+        i % 2 ? client2 : client1, counters_subscription(), 0, "ONCE", "PROTO",
+        [&](const gnmi::SubscribeResponse&) { responses++; },
+        [&](const grpc::Status& status) {
+          if (status.ok()) done++;
+        }));
+  }
+  for (auto& handle : handles) {
+    REQUIRE(handle->wait().ok());
+    REQUIRE(!handle->is_active());
+  }
+
+  REQUIRE(done == subscriptions);
+  // (5 + 1) responses per subscription to server1, (3 + 1) to server2
+  REQUIRE(responses == subscriptions / 2 * (6 + 4));
+}
+
+TEST_CASE("gnmi_subscription_engine_poll_and_stop") {
+  mock::MockgNMIServer server{2, 2};
+  gNMIClient client{"127.0.0.1", server.port, "admin", "admin"};
+  gNMISubscriptionEngine engine{1};
+
+  mutex sync_mutex;
+  condition_variable synced;
+  int sync_responses = 0;
+  auto handle = engine.subscribe(
+      client, counters_subscription(), 0, "POLL", "PROTO",
+      [&](const gnmi::SubscribeResponse& response) {
+        if (response.sync_response()) {
+          lock_guard<mutex> guard{sync_mutex};
+          sync_responses++;
+          synced.notify_all();
+        }
+      });
+
+  auto wait_for_sync = [&](int count) {
+    unique_lock<mutex> lock{sync_mutex};
+    return synced.wait_for(lock, chrono::seconds(10),
+                           [&]() { return sync_responses >= count; });
+  };
+
+  REQUIRE(wait_for_sync(1));
+  handle->poll();
+  handle->poll();
+  REQUIRE(wait_for_sync(3));
+  REQUIRE(handle->is_active());
+
+  handle->stop();
+  REQUIRE(handle->wait().error_code() == grpc::StatusCode::CANCELLED);
+  REQUIRE(!handle->is_active());
+  // polling a finished subscription is a no-op
+  handle->poll();
+}
+
+TEST_CASE("gnmi_subscription_engine_cancels_on_destruction") {
+  mock::MockgNMIServer server{1, 1};
+  gNMIClient client{"127.0.0.1", server.port, "admin", "admin"};
+
+  grpc::StatusCode code = grpc::StatusCode::OK;
+  shared_ptr<gNMISubscriptionHandle> handle;
+  {
+    gNMISubscriptionEngine engine{1};
+    handle = engine.subscribe(
+        client, counters_subscription(), 0, "POLL", "PROTO", nullptr,
+        [&](const grpc::Status& status) { code = status.error_code(); });
+  }
+  REQUIRE(code == grpc::StatusCode::CANCELLED);
+  REQUIRE(!handle->is_active());
+}
+
+TEST_CASE("gnmi_subscription_engine_throughput", "[.benchmark]") {
+  const int subscriptions = 1000;
+  mock::MockgNMIServer server{10, 8, chrono::milliseconds{5}};
+  gNMIClient client{"127.0.0.1", server.port, "admin", "admin"};
+
+  atomic<uint64_t> responses{0};
+  auto start = chrono::steady_clock::now();
+  for (int i = 0; i < subscriptions / 10; i++) {
+    client.execute_subscribe_operation_typed(
+        counters_subscription(), 0, "ONCE", "PROTO",
+        [&](const gnmi::SubscribeResponse&) { responses++; });
+  }
+  auto blocking =
+      chrono::duration<double>(chrono::steady_clock::now() - start).count() *
+      10;
+
+  gNMISubscriptionEngine engine{4};
+  vector<shared_ptr<gNMISubscriptionHandle>> handles;
+  start = chrono::steady_clock::now();
+  for (int i = 0; i < subscriptions; i++) {
+    handles.push_back(
+        engine.subscribe(client, counters_subscription(), 0, "ONCE", "PROTO",
+                         [&](const gnmi::SubscribeResponse&) { responses++; }));
+  }
+  for (auto& handle : handles) handle->wait();
+  auto async =
+      chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+  cout << subscriptions << " subscriptions, blocking: " << blocking
+       << " s (extrapolated), engine: " << async << " s" << endl;
+}
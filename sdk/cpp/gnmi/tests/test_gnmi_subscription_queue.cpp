@@ -0,0 +1,275 @@
+/// YANG Development Kit
+// Copyright 2016 Cisco Systems. All rights reserved
+//
+////////////////////////////////////////////////////////////////
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+//////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <ydk/gnmi_subscription_queue.hpp>
+
+#include "../../core/src/catch.hpp"
+#include "mock_gnmi_server.hpp"
+
+using namespace std;
+using namespace ydk;
+
+// Records the responses it receives and holds the first one until released,
+// so that the queue fills up behind it
+class HeldConsumer {
+ public:
+  GnmiSubscribeCallback get_callback() {
+    return [this](const gnmi::SubscribeResponse& response) {
+      unique_lock<mutex> lock{consumer_mutex};
+      received.push_back(response);
+      changed.notify_all();
+      changed.wait(lock, [this]() { return released; });
+    };
+  }
+
+  void wait_for_first() {
+    unique_lock<mutex> lock{consumer_mutex};
+    changed.wait(lock, [this]() { return !received.empty(); });
+  }
+
+  void release() {
+    lock_guard<mutex> guard{consumer_mutex};
+    released = true;
+    changed.notify_all();
+  }
+
+  vector<string> get_received() {
+    lock_guard<mutex> guard{consumer_mutex};
+    vector<string> names;
+    for (auto& response : received) {
+      if (response.sync_response()) {
+        names.push_back("sync");
+        continue;
+      }
+      auto& notification = response.update();
+      names.push_back(notification.prefix().elem(1).key().at("name") + "@" +
+                      to_string(notification.timestamp()));
+    }
+    return names;
+  }
+
+ private:
+  mutex consumer_mutex;
+  condition_variable changed;
+  bool released = false;
+  vector<gnmi::SubscribeResponse> received;
+};
+
+static gnmi::SubscribeResponse counters_response(const string& name,
+                                                 uint64_t timestamp) {
+  gnmi::SubscribeResponse response;
+  *response.mutable_update() =
+      mock::build_counters_notification(name, 2, timestamp);
+  return response;
+}
+
+static gnmi::SubscribeResponse sync_response() {
+  gnmi::SubscribeResponse response;
+  response.set_sync_response(true);
+  return response;
+}
+
+TEST_CASE("gnmi_subscription_queue_drop_oldest") {
+  HeldConsumer consumer;
+  gNMISubscriptionQueue queue{consumer.get_callback(), 2,
+                              GnmiQueuePolicy::drop_oldest};
+  queue.push(counters_response("Loopback10", 0));
+  consumer.wait_for_first();
+  for (int i = 1; i <= 4; i++) {
+    queue.push(counters_response("Loopback10", i));
+  }
+
+  auto counters = queue.get_counters();
+  REQUIRE(counters.received == 5);
+  REQUIRE(counters.dropped == 2);
+  REQUIRE(counters.depth == 2);
+  REQUIRE(counters.max_depth == 2);
+
+  consumer.release();
+  queue.close();
+  vector<string> expected{"Loopback10@0", "Loopback10@3", "Loopback10@4"};
+  REQUIRE(consumer.get_received() == expected);
+  REQUIRE(queue.get_counters().delivered == 3);
+  REQUIRE(queue.get_counters().depth == 0);
+}
+
+TEST_CASE("gnmi_subscription_queue_drop_newest") {
+  HeldConsumer consumer;
+  gNMISubscriptionQueue queue{consumer.get_callback(), 2,
+                              GnmiQueuePolicy::drop_newest};
+  queue.push(counters_response("Loopback10", 0));
+  consumer.wait_for_first();
+  for (int i = 1; i <= 4; i++) {
+    queue.push(counters_response("Loopback10", i));
+  }
+  REQUIRE(queue.get_counters().dropped == 2);
+
+  consumer.release();
+  queue.close();
+  vector<string> expected{"Loopback10@0", "Loopback10@1", "Loopback10@2"};
+  REQUIRE(consumer.get_received() == expected);
+}
+
+TEST_CASE("gnmi_subscription_queue_coalesce_by_path") {
+  HeldConsumer consumer;
+  gNMISubscriptionQueue queue{consumer.get_callback(), 3,
+                              GnmiQueuePolicy::coalesce_by_path};
+  queue.push(counters_response("Loopback10", 0));
+  consumer.wait_for_first();
+  queue.push(counters_response("Loopback10", 1));
+  queue.push(counters_response("Loopback11", 2));
+  queue.push(counters_response("Loopback10", 3));
+  queue.push(counters_response("Loopback11", 4));
+  queue.push(sync_response());
+  // the queue is full and sync responses are never coalesced
+  queue.push(counters_response("Loopback12", 5));
+
+  auto counters = queue.get_counters();
+  REQUIRE(counters.received == 7);
+  REQUIRE(counters.coalesced == 2);
+  REQUIRE(counters.dropped == 1);
+
+  consumer.release();
+  queue.close();
+  vector<string> expected{"Loopback10@0", "Loopback11@4", "sync",
+                          "Loopback12@5"};
+  REQUIRE(consumer.get_received() == expected);
+}
+
+TEST_CASE("gnmi_subscription_queue_block") {
+  HeldConsumer consumer;
+  gNMISubscriptionQueue queue{consumer.get_callback(), 1};
+  queue.push(counters_response("Loopback10", 0));
+  consumer.wait_for_first();
+
+  thread reader{[&]() {
+    for (int i = 1; i <= 3; i++) {
+      queue.push(counters_response("Loopback10", i));
+    }
+  }};
+  // the reader waits for room after filling the queue
+  while (queue.get_counters().received < 3) {
+    this_thread::sleep_for(chrono::milliseconds{1});
+  }
+  this_thread::sleep_for(chrono::milliseconds{10});
+  REQUIRE(queue.get_counters().received == 3);
+  REQUIRE(queue.get_counters().depth == 1);
+
+  consumer.release();
+  reader.join();
+  queue.close();
+  REQUIRE(consumer.get_received().size() == 4);
+  REQUIRE(queue.get_counters().dropped == 0);
+}
+
+TEST_CASE("gnmi_subscription_queue_destroyed_by_consumer") {
+  mutex destroyed_mutex;
+  condition_variable changed;
+  bool destroyed = false;
+  int consumed = 0;
+  unique_ptr<gNMISubscriptionQueue> queue;
+  queue.reset(new gNMISubscriptionQueue{
+      [&](const gnmi::SubscribeResponse& response) {
+        consumed++;
+        if (response.sync_response()) {
+          queue.reset();
+          lock_guard<mutex> guard{destroyed_mutex};
+          destroyed = true;
+          changed.notify_all();
+        }
+      },
+      4});
+  queue->push(counters_response("Loopback10", 0));
+  queue->push(sync_response());
+
+  unique_lock<mutex> lock{destroyed_mutex};
+  changed.wait(lock, [&]() { return destroyed; });
+  REQUIRE(consumed == 2);
+}
+
+TEST_CASE("gnmi_subscription_queue_slow_consumer") {
+  mock::MockgNMIServer server{50, 4};
+  gNMIClient client{"127.0.0.1", server.port, "admin", "admin"};
+
+  int consumed = 0;
+  bool synced = false;
+  gNMISubscriptionQueue queue{
+      [&](const gnmi::SubscribeResponse& response) {
+        this_thread::sleep_for(chrono::milliseconds{1});
+        consumed++;
+        synced = response.sync_response();
+      },
+      4, GnmiQueuePolicy::coalesce_by_path};
+
+  GnmiClientSubscription sub{};
+  sub.path = nullptr;
+  sub.subscription_mode = "SAMPLE";
+  client.execute_subscribe_operation_typed({sub}, 0, "ONCE", "PROTO",
+                                           queue.get_callback());
+  queue.close();
+
+  auto counters = queue.get_counters();
+  REQUIRE(counters.received == 51);
+  REQUIRE(counters.delivered == consumed);
+  REQUIRE(counters.delivered + counters.dropped + counters.coalesced == 51);
+  REQUIRE(counters.max_depth <= 4);
+  REQUIRE(synced);
+}
+
+TEST_CASE("gnmi_subscription_queue_burst", "[.benchmark]") {
+  const int interfaces = 100;
+  const int rounds = 1000;
+  vector<gnmi::SubscribeResponse> responses;
+  for (int i = 0; i < interfaces; i++) {
+    responses.push_back(
+        counters_response("GigabitEthernet0/0/0/" + to_string(i), i));
+  }
+
+  for (auto policy :
+       {GnmiQueuePolicy::block, GnmiQueuePolicy::drop_oldest,
+        GnmiQueuePolicy::drop_newest, GnmiQueuePolicy::coalesce_by_path}) {
+    gNMISubscriptionQueue queue{[](const gnmi::SubscribeResponse&) {
+                                  this_thread::sleep_for(
+                                      chrono::microseconds{10});
+                                },
+                                1000, policy};
+    auto start = chrono::steady_clock::now();
+    for (int round = 0; round < rounds; round++) {
+      for (auto& response : responses) queue.push(response);
+    }
+    auto seconds =
+        chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    queue.close();
+
+    auto counters = queue.get_counters();
+    cout << "policy " << static_cast<int>(policy) << ": "
+         << interfaces * rounds / seconds << " responses/s received, "
+         << counters.delivered << " delivered, " << counters.dropped
+         << " dropped, " << counters.coalesced << " coalesced" << endl;
+  }
+}
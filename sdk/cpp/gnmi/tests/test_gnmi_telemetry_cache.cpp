@@ -0,0 +1,293 @@
+/// YANG Development Kit
+// Copyright 2016 Cisco Systems. All rights reserved
+//
+////////////////////////////////////////////////////////////////
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+//////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <ydk/gnmi_telemetry_cache.hpp>
+#include <ydk_ydktest/openconfig_interfaces.hpp>
+
+#include "../../core/src/catch.hpp"
+#include "../../core/tests/config.hpp"
+#include "../../core/tests/mock_data.hpp"
+#include "mock_gnmi_server.hpp"
+
+using namespace std;
+using namespace ydk;
+using namespace ydktest;
+
+static gnmi::Path counter_path(const string& name, int counter) {
+  gnmi::Path path;
+  path.add_elem()->set_name("interfaces");
+  auto interface = path.add_elem();
+  interface->set_name("interface");
+  (*interface->mutable_key())["name"] = name;
+  path.add_elem()->set_name("state");
+  path.add_elem()->set_name("counters");
+  path.add_elem()->set_name("counter-" + to_string(counter));
+  return path;
+}
+
+static gnmi::SubscribeResponse counters_response(const string& name,
+                                                 uint64_t value) {
+  gnmi::SubscribeResponse response;
+  *response.mutable_update() =
+      mock::build_counters_notification(name, 4, value);
+  return response;
+}
+
+// Updates /interfaces/interface[name=<name>]/config/{name,mtu}
+static gnmi::SubscribeResponse config_response(const string& name,
+                                               uint64_t mtu) {
+  gnmi::SubscribeResponse response;
+  auto notification = response.mutable_update();
+  auto prefix = notification->mutable_prefix();
+  prefix->set_origin("openconfig-interfaces");
+  prefix->add_elem()->set_name("interfaces");
+  auto interface = prefix->add_elem();
+  interface->set_name("interface");
+  (*interface->mutable_key())["name"] = name;
+  prefix->add_elem()->set_name("config");
+
+  auto update = notification->add_update();
+  update->mutable_path()->add_elem()->set_name("name");
+  update->mutable_val()->set_string_val(name);
+  update = notification->add_update();
+  update->mutable_path()->add_elem()->set_name("mtu");
+  update->mutable_val()->set_uint_val(mtu);
+  return response;
+}
+
+TEST_CASE("gnmi_telemetry_cache_updates_and_deletes") {
+  mock::MockSession sp{TEST_HOME, test_openconfig};
+  gNMITelemetryCache cache{sp.get_root_schema()};
+
+  cache.update(counters_response("Loopback10", 100));
+  cache.update(counters_response("Loopback11", 100));
+  REQUIRE(cache.size() == 8);
+  REQUIRE_FALSE(cache.is_synchronized());
+
+  gnmi::TypedValue value;
+  uint64 timestamp;
+  REQUIRE(cache.get_value(counter_path("Loopback10", 2), value, timestamp));
+  REQUIRE(value.uint_val() == 102);
+  REQUIRE(timestamp == 100);
+
+  // newer values replace the cached ones
+  cache.update(counters_response("Loopback10", 200));
+  REQUIRE(cache.size() == 8);
+  REQUIRE(cache.get_value(counter_path("Loopback10", 2), value));
+  REQUIRE(value.uint_val() == 202);
+
+  // deletes drop the whole subtree
+  gnmi::SubscribeResponse response;
+  auto deleted = response.mutable_update()->add_delete_();
+  *deleted = counter_path("Loopback10", 0);
+  deleted->mutable_elem()->RemoveLast();
+  cache.update(response);
+  REQUIRE(cache.size() == 4);
+  REQUIRE_FALSE(cache.get_value(counter_path("Loopback10", 2), value));
+  REQUIRE(cache.get_value(counter_path("Loopback11", 2), value));
+
+  response.Clear();
+  response.set_sync_response(true);
+  cache.update(response);
+  REQUIRE(cache.is_synchronized());
+  REQUIRE(cache.get_targets() == vector<string>{""});
+  REQUIRE(cache.size("router1") == 0);
+  REQUIRE_FALSE(cache.is_synchronized("router1"));
+
+  cache.clear();
+  REQUIRE(cache.size() == 0);
+  REQUIRE_FALSE(cache.is_synchronized());
+}
+
+TEST_CASE("gnmi_telemetry_cache_entity_snapshot") {
+  mock::MockSession sp{TEST_HOME, test_openconfig};
+  gNMITelemetryCache cache{sp.get_root_schema()};
+
+  cache.update(config_response("Loopback10", 1500), "router1");
+  cache.update(config_response("Loopback11", 9000), "router1");
+  cache.update(config_response("Loopback10", 1514), "router1");
+
+  auto expected = make_shared<openconfig_interfaces::Interfaces::Interface>();
+  expected->name = "Loopback10";
+  expected->config->name = "Loopback10";
+  expected->config->mtu = 1514;
+
+  openconfig_interfaces::Interfaces filter{};
+  auto ifc_filter = make_shared<openconfig_interfaces::Interfaces::Interface>();
+  ifc_filter->name = "Loopback10";
+  filter.interface.append(ifc_filter);
+
+  auto ifc = cache.get_entity(*ifc_filter, "router1");
+  REQUIRE(ifc != nullptr);
+  REQUIRE(*ifc == *expected);
+
+  auto ifcs = cache.get_entity(filter, "router1");
+  REQUIRE(ifcs != nullptr);
+  REQUIRE(dynamic_cast<openconfig_interfaces::Interfaces&>(*ifcs)
+              .interface.len() == 2);
+
+  REQUIRE(cache.get_entity(*ifc_filter) == nullptr);
+}
+
+// /interfaces/interface[name=<name>]/config/mtu
+static gnmi::Path mtu_path(const string& name) {
+  gnmi::Path path;
+  path.add_elem()->set_name("interfaces");
+  auto interface = path.add_elem();
+  interface->set_name("interface");
+  (*interface->mutable_key())["name"] = name;
+  path.add_elem()->set_name("config");
+  path.add_elem()->set_name("mtu");
+  return path;
+}
+
+TEST_CASE("gnmi_telemetry_cache_container_value") {
+  mock::MockSession sp{TEST_HOME, test_openconfig};
+  gNMITelemetryCache cache{sp.get_root_schema()};
+
+  gnmi::SubscribeResponse response;
+  auto update = response.mutable_update()->add_update();
+  update->mutable_path()->set_origin("openconfig-interfaces");
+  update->mutable_path()->add_elem()->set_name("interfaces");
+  update->mutable_val()->set_json_ietf_val(R"({"interface": [
+      {"name": "Loopback10", "config": {"name": "Loopback10", "mtu": 1500}},
+      {"name": "Loopback11", "config": {"name": "Loopback11", "mtu": 9000}}
+  ]})");
+  cache.update(response);
+
+  // the container value is cached as its leaves
+  REQUIRE(cache.size() == 6);
+  gnmi::TypedValue value;
+  REQUIRE(cache.get_value(mtu_path("Loopback10"), value));
+  REQUIRE(value.json_ietf_val() == "1500");
+
+  response.Clear();
+  *response.mutable_update()->add_delete_() = mtu_path("Loopback11");
+  cache.update(response);
+  REQUIRE(cache.size() == 5);
+  REQUIRE_FALSE(cache.get_value(mtu_path("Loopback11"), value));
+
+  auto expected = make_shared<openconfig_interfaces::Interfaces::Interface>();
+  expected->name = "Loopback10";
+  expected->config->name = "Loopback10";
+  expected->config->mtu = 1500;
+
+  openconfig_interfaces::Interfaces filter{};
+  auto ifc_filter = make_shared<openconfig_interfaces::Interfaces::Interface>();
+  ifc_filter->name = "Loopback10";
+  filter.interface.append(ifc_filter);
+  auto ifc = cache.get_entity(*ifc_filter);
+  REQUIRE(ifc != nullptr);
+  REQUIRE(*ifc == *expected);
+}
+
+TEST_CASE("gnmi_telemetry_cache_subscription") {
+  mock::MockgNMIServer server{3, 4};
+  gNMIClient client{"127.0.0.1", server.port, "admin", "admin"};
+  mock::MockSession sp{TEST_HOME, test_openconfig};
+  gNMITelemetryCache cache{sp.get_root_schema()};
+
+  GnmiClientSubscription sub{};
+  sub.path = nullptr;
+  sub.subscription_mode = "SAMPLE";
+  client.execute_subscribe_operation_typed({sub}, 0, "ONCE", "PROTO",
+                                           cache.get_callback("router1"));
+
+  REQUIRE(cache.is_synchronized("router1"));
+  REQUIRE(cache.size("router1") == 4);
+  gnmi::TypedValue value;
+  REQUIRE(cache.get_value(counter_path("Loopback10", 3), value, "router1"));
+  REQUIRE(value.uint_val() == 5);
+}
+
+TEST_CASE("gnmi_telemetry_cache_concurrent_readers") {
+  mock::MockSession sp{TEST_HOME, test_openconfig};
+  gNMITelemetryCache cache{sp.get_root_schema()};
+  const int rounds = 2000;
+  cache.update(config_response("Loopback3", 0));
+
+  atomic<bool> done{false};
+  atomic<int> snapshots{0};
+  atomic<int> stale{0};
+  vector<thread> readers;
+  for (int r = 0; r < 4; r++) {
+    readers.emplace_back([&, r]() {
+      openconfig_interfaces::Interfaces filter{};
+      auto ifc_filter =
+          make_shared<openconfig_interfaces::Interfaces::Interface>();
+      ifc_filter->name = "Loopback3";
+      filter.interface.append(ifc_filter);
+      gnmi::TypedValue value;
+      uint64_t last = 0;
+      while (!done) {
+        if (r % 2) {
+          if (cache.get_entity(*ifc_filter)) snapshots++;
+        } else if (cache.get_value(counter_path("Ethernet0", 0), value)) {
+          // values only ever grow
+          if (value.uint_val() < last) stale++;
+          last = value.uint_val();
+        }
+      }
+    });
+  }
+
+  for (int i = 1; i <= rounds; i++) {
+    cache.update(counters_response("Ethernet0", i));
+    cache.update(config_response("Loopback" + to_string(i % 16), i));
+  }
+  done = true;
+  for (auto& reader : readers) reader.join();
+
+  REQUIRE(stale == 0);
+  REQUIRE(snapshots > 0);
+  REQUIRE(cache.size() == 4 + 16 * 2);
+}
+
+TEST_CASE("gnmi_telemetry_cache_update_rate", "[.benchmark]") {
+  mock::MockSession sp{TEST_HOME, test_openconfig};
+  gNMITelemetryCache cache{sp.get_root_schema()};
+  const int interfaces = 1000;
+  const int rounds = 100;
+
+  vector<gnmi::SubscribeResponse> responses;
+  for (int i = 0; i < interfaces; i++) {
+    gnmi::SubscribeResponse response;
+    *response.mutable_update() = mock::build_counters_notification(
+        "GigabitEthernet0/0/0/" + to_string(i), 16, i);
+    responses.push_back(response);
+  }
+
+  auto start = chrono::steady_clock::now();
+  for (int round = 0; round < rounds; round++) {
+    for (auto& response : responses) cache.update(response);
+  }
+  auto seconds =
+      chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+  REQUIRE(cache.size() == interfaces * 16);
+  cout << interfaces * rounds * 16 / seconds << " updates/s" << endl;
+}
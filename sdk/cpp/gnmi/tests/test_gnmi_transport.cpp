@@ -0,0 +1,130 @@
+/// YANG Development Kit
+// Copyright 2016 Cisco Systems. All rights reserved
+//
+////////////////////////////////////////////////////////////////
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+//////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <iostream>
+#include <ydk/errors.hpp>
+#include <ydk/gnmi_client.hpp>
+
+#include "../../core/src/catch.hpp"
+#include "mock_gnmi_server.hpp"
+#include "throttled_proxy.hpp"
+
+using namespace std;
+using namespace ydk;
+
+// JSON_IETF config of `count` interfaces
+static string interfaces_payload(int count) {
+  string payload = R"({"openconfig-interfaces:interface":[)";
+  for (int i = 0; i < count; i++) {
+    if (i > 0) payload += ',';
+    payload += R"({"name":"GigabitEthernet0/0/0/)" + to_string(i) +
+               R"(","config":{"name":"GigabitEthernet0/0/0/)" + to_string(i) +
+               R"(","description":"uplink","mtu":9000,"enabled":true}})";
+  }
+  return payload + "]}";
+}
+
+static string get_payload(gNMIClient& client) {
+  gnmi::Path path;
+  path.add_elem()->set_name("openconfig-interfaces:interfaces");
+  GnmiClientRequest request{"interfaces", "", &path, "get", "CONFIG"};
+  gnmi::GetResponse response;
+  client.execute_get_operation({request}, "CONFIG", response);
+  return response.notification(0).update(0).val().json_ietf_val();
+}
+
+TEST_CASE("gnmi_transport_options") {
+  mock::MockgNMIServer server;
+  server.get_payload = interfaces_payload(1000);
+  server.reply_compression = GRPC_COMPRESS_GZIP;
+
+  TransportOptions options{};
+  options.compression = Compression::gzip;
+  options.max_receive_message_size = 16 * 1024 * 1024;
+  options.keepalive_time_ms = 10000;
+  gNMIClient client{"127.0.0.1", server.port, "admin", "admin", "", "",
+                    options};
+  REQUIRE(get_payload(client) == server.get_payload);
+
+  gnmi::SetRequest request;
+  auto update = request.add_update();
+  update->mutable_path()->add_elem()->set_name(
+      "openconfig-interfaces:interfaces");
+  update->mutable_val()->set_json_ietf_val(server.get_payload);
+  gnmi::SetResponse response;
+  client.execute_set_operation(request, response);
+  REQUIRE(server.get_set_requests().size() == 1);
+
+  // the limit applies to the decompressed reply
+  options.max_receive_message_size = 1024;
+  gNMIClient limited{"127.0.0.1", server.port, "admin", "admin", "", "",
+                     options};
+  REQUIRE_THROWS_AS(get_payload(limited), YServiceProviderError);
+}
+
+TEST_CASE("gnmi_transport_compression_benchmark", "[.benchmark]") {
+  const int rounds = 5;
+  // 1 MB/s, about a T1 line
+  const size_t bytes_per_second = 1024 * 1024;
+  mock::MockgNMIServer server;
+  server.get_payload = interfaces_payload(20000);
+  cout << "payload: " << server.get_payload.size() << " bytes" << endl;
+
+  gnmi::SetRequest request;
+  auto update = request.add_update();
+  update->mutable_path()->add_elem()->set_name(
+      "openconfig-interfaces:interfaces");
+  update->mutable_val()->set_json_ietf_val(server.get_payload);
+
+  for (auto compression : {Compression::none, Compression::gzip}) {
+    mock::ThrottledProxy proxy{server.port, bytes_per_second};
+    server.reply_compression = compression == Compression::gzip
+                                   ? GRPC_COMPRESS_GZIP
+                                   : GRPC_COMPRESS_NONE;
+    TransportOptions options{};
+    options.compression = compression;
+    options.max_receive_message_size = -1;
+    gNMIClient client{"127.0.0.1", proxy.port, "admin", "admin", "", "",
+                      options};
+
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < rounds; i++) {
+      REQUIRE(get_payload(client).size() == server.get_payload.size());
+    }
+    auto get_seconds =
+        chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    start = chrono::steady_clock::now();
+    gnmi::SetResponse response;
+    for (int i = 0; i < rounds; i++) {
+      client.execute_set_operation(request, response);
+    }
+    auto set_seconds =
+        chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    cout << (compression == Compression::gzip ? "gzip" : "none") << ": "
+         << proxy.sent << " bytes sent, " << proxy.received
+         << " bytes received, get " << get_seconds / rounds << " s, set "
+         << set_seconds / rounds << " s" << endl;
+  }
+}
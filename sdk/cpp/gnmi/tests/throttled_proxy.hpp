@@ -0,0 +1,130 @@
+/// YANG Development Kit
+// Copyright 2016 Cisco Systems. All rights reserved
+//
+////////////////////////////////////////////////////////////////
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+//////////////////////////////////////////////////////////////////
+
+#ifndef THROTTLED_PROXY_HPP
+#define THROTTLED_PROXY_HPP
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mock {
+
+// Forwards the TCP connections made to `port` to a server on the loopback
+// interface, at most `bytes_per_second` in each direction, and counts the
+// bytes forwarded. Stands in for a slow management link.
+class ThrottledProxy {
+ public:
+  ThrottledProxy(int target_port, std::size_t bytes_per_second)
+      : target_port{target_port},
+        bytes_per_second{bytes_per_second},
+        sent{0},
+        received{0},
+        port{0} {
+    listener = socket(AF_INET, SOCK_STREAM, 0);
+    auto address = get_address(0);
+    bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+    listen(listener, 16);
+    socklen_t length = sizeof(address);
+    getsockname(listener, reinterpret_cast<sockaddr*>(&address), &length);
+    port = ntohs(address.sin_port);
+    acceptor = std::thread{&ThrottledProxy::accept_connections, this};
+  }
+
+  ~ThrottledProxy() {
+    shutdown(listener, SHUT_RDWR);
+    close(listener);
+    acceptor.join();
+    {
+      std::lock_guard<std::mutex> guard{sockets_mutex};
+      for (auto fd : sockets) shutdown(fd, SHUT_RDWR);
+    }
+    for (auto& pump : pumps) pump.join();
+    for (auto fd : sockets) close(fd);
+  }
+
+  int target_port;
+  std::size_t bytes_per_second;
+  // bytes forwarded to and from the server
+  std::atomic<std::size_t> sent;
+  std::atomic<std::size_t> received;
+  int port;
+
+ private:
+  static sockaddr_in get_address(int port) {
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    return address;
+  }
+
+  void accept_connections() {
+    int client;
+    while ((client = accept(listener, nullptr, nullptr)) >= 0) {
+      int server = socket(AF_INET, SOCK_STREAM, 0);
+      auto address = get_address(target_port);
+      connect(server, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+      std::lock_guard<std::mutex> guard{sockets_mutex};
+      sockets.push_back(client);
+      sockets.push_back(server);
+      pumps.emplace_back(&ThrottledProxy::pump, this, client, server,
+                         std::ref(sent));
+      pumps.emplace_back(&ThrottledProxy::pump, this, server, client,
+                         std::ref(received));
+    }
+  }
+
+  void pump(int from, int to, std::atomic<std::size_t>& bytes) {
+    char buffer[16384];
+    ssize_t length;
+    while ((length = read(from, buffer, sizeof(buffer))) > 0) {
+      std::this_thread::sleep_for(
+          std::chrono::microseconds{length * 1000000 / bytes_per_second});
+      for (ssize_t offset = 0; offset < length;) {
+        auto written = write(to, buffer + offset, length - offset);
+        if (written <= 0) return;
+        offset += written;
+      }
+      bytes += length;
+    }
+    shutdown(to, SHUT_WR);
+  }
+
+  int listener;
+  std::thread acceptor;
+  std::mutex sockets_mutex;
+  std::vector<int> sockets;
+  std::vector<std::thread> pumps;
+};
+
+}  // namespace mock
+
+#endif /* THROTTLED_PROXY_HPP */
@@ -15,7 +15,12 @@
  ------------------------------------------------------------------*/
 
 #include <string.h>
+#include <sys/resource.h>
 
+#include <unistd.h>
+
+#include <chrono>
+#include <fstream>
 #include <iostream>
 #include <ydk/codec_provider.hpp>
 #include <ydk/codec_service.hpp>
@@ -615,3 +620,200 @@ TEST_CASE("test_codec_action_node") {
       xml_reply ==
       R"(<data xmlns="http://cisco.com/ns/yang/ydktest-action"><action-node><t>ok</t></action-node></data>)");
 }
+
+// Peak resident memory in kilobytes
+static long get_max_rss() {
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+  return usage.ru_maxrss / 1024;
+#else
+  return usage.ru_maxrss;
+#endif
+}
+
+// Resident memory in kilobytes
+static long get_rss() {
+#ifdef __APPLE__
+  return get_max_rss();
+#else
+  long pages = 0, resident = 0;
+  ifstream statm{"/proc/self/statm"};
+  statm >> pages >> resident;
+  return resident * (sysconf(_SC_PAGESIZE) / 1024);
+#endif
+}
+
+static string ldata_payload(size_t entries) {
+  string json = R"({"ydktest-sanity:runner":{"two-list":{"ldata":[)";
+  for (size_t i = 0; i < entries; i++) {
+    if (i > 0) json += ',';
+    json += R"({"number":)" + to_string(i) + R"(,"name":"ldata)" +
+            to_string(i) + R"("})";
+  }
+  return json + "]}}}";
+}
+
+TEST_CASE("deep_clone") {
+  CodecServiceProvider codec_provider{EncodingFormat::JSON};
+  CodecService codec_service{};
+  auto entity = codec_service.decode(codec_provider, ldata_payload(3),
+                                     make_shared<ydktest_sanity::Runner>());
+  auto runner = dynamic_cast<ydktest_sanity::Runner*>(entity.get());
+  runner->ytypes->built_in_t->enum_value = ydktest_sanity::YdkEnumTest::none;
+  runner->ytypes->built_in_t->bits_value["auto-sense-speed"] = true;
+  runner->ytypes->built_in_t->identity_ref_value =
+      ydktest_sanity_types::YdktestType();
+  runner->ytypes->built_in_t->llstring.append("abc");
+  runner->two_list->ldata["1"]->name.yfilter = YFilter::replace;
+
+  auto clone = entity->deep_clone();
+  REQUIRE(clone != nullptr);
+  REQUIRE(*clone == *entity);
+  REQUIRE(codec_service.encode(codec_provider, *clone, false) ==
+          codec_service.encode(codec_provider, *entity, false));
+  auto cloned = dynamic_cast<ydktest_sanity::Runner*>(clone.get());
+  auto ldata = cloned->two_list->ldata["1"];
+  REQUIRE(ldata.get() != runner->two_list->ldata["1"].get());
+  REQUIRE(ldata->get_parent() == cloned->two_list.get());
+  REQUIRE(ldata->name.yfilter == YFilter::replace);
+  REQUIRE(ldata->get_absolute_path() ==
+          "ydktest-sanity:runner/two-list/ldata[number='1']");
+
+  // changes to the original leave the clone as it was
+  runner->two_list->ldata["1"]->name = "changed";
+  runner->ytypes->built_in_t->llstring.append("def");
+  REQUIRE(ldata->name.get() == "ldata1");
+  REQUIRE(cloned->ytypes->built_in_t->llstring.getYLeafs().size() == 1);
+}
+
+TEST_CASE("decoded_list_memory_benchmark", "[.benchmark]") {
+  const size_t entries = 200000;
+  auto json = ldata_payload(entries);
+  CodecServiceProvider codec_provider{EncodingFormat::JSON};
+  CodecService codec_service{};
+  // load the schema before measuring
+  codec_service.decode(codec_provider, ldata_payload(1),
+                       make_shared<ydktest_sanity::Runner>());
+
+  auto before = get_max_rss();
+  auto entity = codec_service.decode(codec_provider, json,
+                                     make_shared<ydktest_sanity::Runner>());
+  auto after = get_max_rss();
+  auto runner = dynamic_cast<ydktest_sanity::Runner*>(entity.get());
+  REQUIRE(runner->two_list->ldata.len() == entries);
+
+  cout << entries << " list entries of "
+       << sizeof(ydktest_sanity::Runner::TwoList::Ldata) << " bytes, YLeaf "
+       << sizeof(YLeaf) << " bytes, peak memory grew by " << after - before
+       << " kB" << endl;
+}
+
+TEST_CASE("counters_populate_encode_benchmark", "[.benchmark]") {
+  const int interfaces = 10000;
+  auto start = chrono::steady_clock::now();
+  openconfig_interfaces::Interfaces ifcs{};
+  for (int i = 0; i < interfaces; i++) {
+    auto ifc = make_shared<openconfig_interfaces::Interfaces::Interface>();
+    ifc->name = "GigabitEthernet0/0/0/" + to_string(i);
+    ifc->config->name = "GigabitEthernet0/0/0/" + to_string(i);
+    auto& counters = *ifc->state->counters;
+    uint64 base = 1000000007ULL * i;
+    counters.in_octets = base;
+    counters.in_unicast_pkts = base + 1;
+    counters.in_broadcast_pkts = base + 2;
+    counters.in_multicast_pkts = base + 3;
+    counters.in_discards = base + 4;
+    counters.in_errors = base + 5;
+    counters.out_octets = base + 6;
+    counters.out_unicast_pkts = base + 7;
+    counters.out_broadcast_pkts = base + 8;
+    counters.out_multicast_pkts = base + 9;
+    counters.out_discards = base + 10;
+    counters.out_errors = base + 11;
+    ifcs.interface.append(ifc);
+  }
+  auto populate =
+      chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+  CodecServiceProvider codec_provider{EncodingFormat::JSON};
+  CodecService codec_service{};
+  start = chrono::steady_clock::now();
+  auto json = codec_service.encode(codec_provider, ifcs, false);
+  auto encode =
+      chrono::duration<double>(chrono::steady_clock::now() - start).count();
+  REQUIRE(json.find(to_string(1000000007ULL * (interfaces - 1) + 11)) !=
+          string::npos);
+
+  // every counter goes through the generated set_value of its container
+  start = chrono::steady_clock::now();
+  auto decoded = codec_service.decode(
+      codec_provider, json, make_shared<openconfig_interfaces::Interfaces>());
+  auto decode =
+      chrono::duration<double>(chrono::steady_clock::now() - start).count();
+  REQUIRE(*decoded == ifcs);
+
+  cout << interfaces << " interfaces with 12 counters each, populate "
+       << populate << " s, encode " << encode << " s, decode " << decode
+       << " s" << endl;
+}
+
+TEST_CASE("decode_arena_benchmark", "[.benchmark]") {
+  const size_t entries = 200000;
+  const int cycles = 10;
+  auto json = ldata_payload(entries);
+  CodecServiceProvider codec_provider{EncodingFormat::JSON};
+  CodecService codec_service{};
+  codec_service.decode(codec_provider, ldata_payload(1),
+                       make_shared<ydktest_sanity::Runner>());
+
+  for (bool use_arena : {false, true}) {
+    double decode_seconds = 0, teardown_seconds = 0;
+    auto before = get_rss();
+    for (int i = 0; i < cycles; i++) {
+      auto arena = use_arena ? make_shared<EntityArena>() : nullptr;
+      auto runner = make_entity<ydktest_sanity::Runner>(arena.get());
+      arena.reset();
+      auto start = chrono::steady_clock::now();
+      codec_service.decode(codec_provider, json, runner);
+      decode_seconds +=
+          chrono::duration<double>(chrono::steady_clock::now() - start)
+              .count();
+      REQUIRE(runner->two_list->ldata.len() == entries);
+
+      start = chrono::steady_clock::now();
+      runner.reset();
+      teardown_seconds +=
+          chrono::duration<double>(chrono::steady_clock::now() - start)
+              .count();
+    }
+    cout << (use_arena ? "arena" : "heap") << ": " << entries
+         << " list entries, decode " << decode_seconds / cycles
+         << " s, teardown " << teardown_seconds / cycles << " s, "
+         << "resident memory after " << cycles << " cycles grew by "
+         << get_rss() - before << " kB" << endl;
+  }
+}
+
+TEST_CASE("deep_clone_benchmark", "[.benchmark]") {
+  const size_t entries = 200000;
+  auto json = ldata_payload(entries);
+  CodecServiceProvider codec_provider{EncodingFormat::JSON};
+  CodecService codec_service{};
+  auto start = chrono::steady_clock::now();
+  auto entity = codec_service.decode(codec_provider, json,
+                                     make_shared<ydktest_sanity::Runner>());
+  auto decode =
+      chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+  // the copy made before a change, to compare with the changed tree later
+  start = chrono::steady_clock::now();
+  auto clone = entity->deep_clone();
+  auto deep_clone =
+      chrono::duration<double>(chrono::steady_clock::now() - start).count();
+  auto runner = dynamic_cast<ydktest_sanity::Runner*>(clone.get());
+  REQUIRE(runner->two_list->ldata.len() == entries);
+
+  cout << entries << " list entries, decode " << decode << " s, deep_clone "
+       << deep_clone << " s" << endl;
+}
@@ -0,0 +1,107 @@
+package test
+
+import (
+	"fmt"
+	ysanity "github.com/CiscoDevNet/ydk-go/ydk/models/ydktest/sanity"
+	"github.com/CiscoDevNet/ydk-go/ydk/path"
+	"github.com/CiscoDevNet/ydk-go/ydk/providers"
+	"github.com/CiscoDevNet/ydk-go/ydk/services"
+	"github.com/CiscoDevNet/ydk-go/ydk/types"
+	encoding "github.com/CiscoDevNet/ydk-go/ydk/types/encoding_format"
+	"runtime"
+	"testing"
+)
+
+// Number of list entries; each adds three data nodes to the tree
+const batchEntries = 50000
+
+func batchRunner() *ysanity.Runner {
+	runner := ysanity.Runner{}
+	for i := 0; i < batchEntries; i++ {
+		ldata := ysanity.Runner_TwoList_Ldata{}
+		ldata.Number = i
+		ldata.Name = fmt.Sprintf("runner:twolist:ldata:%d", i)
+		runner.TwoList.Ldata = append(runner.TwoList.Ldata, &ldata)
+	}
+	return &runner
+}
+
+func batchRootSchema(runner types.Entity) types.RootSchemaNode {
+	provider := providers.CodecServiceProvider{}
+	provider.Initialize(runner)
+	return provider.GetRootSchemaNode(runner)
+}
+
+func batchPaths() ([]string, []string) {
+	paths := make([]string, batchEntries)
+	values := make([]string, batchEntries)
+	for i := range paths {
+		paths[i] = fmt.Sprintf("two-list/ldata[number='%d']/name", i)
+		values[i] = fmt.Sprintf("runner:twolist:ldata:%d", i)
+	}
+	return paths, values
+}
+
+// reportCgoCalls reports the C calls per iteration since start
+func reportCgoCalls(b *testing.B, start int64) {
+	b.ReportMetric(float64(runtime.NumCgoCall()-start)/float64(b.N), "cgo-calls/op")
+}
+
+func BenchmarkDataNodeCreate(b *testing.B) {
+	rootSchema := batchRootSchema(&ysanity.Runner{})
+	paths, values := batchPaths()
+	b.ResetTimer()
+	start := runtime.NumCgoCall()
+	for n := 0; n < b.N; n++ {
+		runner := path.CreateRootDataNode(rootSchema, "ydktest-sanity:runner")
+		for i := range paths {
+			path.CreateDataNode(runner, paths[i], values[i])
+		}
+	}
+	reportCgoCalls(b, start)
+}
+
+func BenchmarkDataNodeCreateMany(b *testing.B) {
+	rootSchema := batchRootSchema(&ysanity.Runner{})
+	paths, values := batchPaths()
+	b.ResetTimer()
+	start := runtime.NumCgoCall()
+	for n := 0; n < b.N; n++ {
+		runner := path.CreateRootDataNode(rootSchema, "ydktest-sanity:runner")
+		path.CreateDataNodes(runner, paths, values)
+	}
+	reportCgoCalls(b, start)
+}
+
+func BenchmarkDataNodeFlatten(b *testing.B) {
+	rootSchema := batchRootSchema(&ysanity.Runner{})
+	paths, values := batchPaths()
+	runner := path.CreateRootDataNode(rootSchema, "ydktest-sanity:runner")
+	path.CreateDataNodes(runner, paths, values)
+	b.ResetTimer()
+	start := runtime.NumCgoCall()
+	for n := 0; n < b.N; n++ {
+		nodes := path.FlattenDataNode(runner)
+		if len(nodes) != 3*batchEntries+2 {
+			b.Fatalf("Flattened %d data nodes", len(nodes))
+		}
+	}
+	reportCgoCalls(b, start)
+}
+
+func BenchmarkCodecEncodeDecode(b *testing.B) {
+	runner := batchRunner()
+	codec := services.CodecService{}
+	provider := providers.CodecServiceProvider{Encoding: encoding.JSON}
+	provider.Initialize(runner)
+	b.ResetTimer()
+	start := runtime.NumCgoCall()
+	for n := 0; n < b.N; n++ {
+		payload := codec.Encode(&provider, runner)
+		decoded := codec.Decode(&provider, payload).(*ysanity.Runner)
+		if len(decoded.TwoList.Ldata) != batchEntries {
+			b.Fatalf("Decoded %d list entries", len(decoded.TwoList.Ldata))
+		}
+	}
+	reportCgoCalls(b, start)
+}
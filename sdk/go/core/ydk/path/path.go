@@ -889,18 +889,40 @@ func getDataNodeFromEntity(
 
 	cdn := C.RootSchemaNodeCreate(*GetCState(state), rootSchema, path)
 	PanicOnCStateError(GetCState(state))
-	dnPath := C.GoString(C.DataNodeGetPath(cdn))[1:]
-	ydk.YLogDebug(fmt.Sprintf("path.getDataNodeFromEntity: Created datanode with path '%s'", dnPath))
+	ydk.YLogDebug(fmt.Sprintf("path.getDataNodeFromEntity: Created datanode with path '%s'", entAbsPath))
 
 	addDataNodeFilterAnnotation(&cdn, entity.GetEntityData().YFilter)
 
-	populateNameValues(state, cdn, entPath)
-	walkChildren(state, entity, cdn)
+	// the rest of the tree is created in one call
+	var batch dataNodeBatch
+	batch.addNameValues(-1, entPath)
+	batch.addChildren(entity, -1)
+	batch.create(state, cdn)
 	return cdn
 }
 
-func walkChildren(
-	state *errors.State, entity types.Entity, dataNode C.DataNode) {
+// dataNodeBatch collects the data nodes of an entity tree, each with a path
+// relative to an earlier one, to be created by a single DataNodeCreateMany
+type dataNodeBatch struct {
+	paths      []string
+	values     []string
+	operations []string
+	parents    []C.int
+}
+
+func (batch *dataNodeBatch) add(path, value string, yf yfilter.YFilter, parent int) int {
+	operation := ""
+	if types.IsSet(yf) && yf != yfilter.Read {
+		operation = fmt.Sprintf("%s", yf)
+	}
+	batch.paths = append(batch.paths, path)
+	batch.values = append(batch.values, value)
+	batch.operations = append(batch.operations, operation)
+	batch.parents = append(batch.parents, C.int(parent))
+	return len(batch.paths) - 1
+}
+
+func (batch *dataNodeBatch) addChildren(entity types.Entity, parent int) {
 	children := types.GetYChildren(entity.GetEntityData())
 
 	ydk.YLogDebug(fmt.Sprintf("Got %d entity children", len(children)))
@@ -912,58 +934,67 @@ func walkChildren(
 				"Looking at entity child '%s'", segmentPath))
 
 			if types.HasDataOrFilter(child.Value) {
-				populateDataNode(state, child.Value, dataNode)
+				path := types.GetEntityPath(child.Value)
+				index := batch.add(path.Path, "", child.Value.GetEntityData().YFilter, parent)
+				ydk.YLogDebug(fmt.Sprintf("path.addChildren: Populating leafs in datanode with path '%s'", path.Path))
+				batch.addNameValues(index, path)
+				batch.addChildren(child.Value, index)
 			}
 		}
 	}
-	ydk.YLogDebug("")
 }
 
-func populateDataNode(
-	state *errors.State, entity types.Entity, parentDataNode C.DataNode) {
-
-	path := types.GetEntityPath(entity)
-	p := C.CString(path.Path)
-	defer C.free(unsafe.Pointer(p))
-	ep := C.CString("")
-	defer C.free(unsafe.Pointer(ep))
-
-	dataNode := C.DataNodeCreate(*GetCState(state), parentDataNode, p, ep)
-	PanicOnCStateError(GetCState(state))
-
-	if dataNode == nil {
-        ydk.YLogError(fmt.Sprintf("Datanode could not be created for: %v", path.Path))
-		panic("Datanode could not be created for: " + path.Path)
-	}
-
-	addDataNodeFilterAnnotation(&dataNode, entity.GetEntityData().YFilter)
-
-	dnPath := C.GoString(C.DataNodeGetPath(dataNode))[1:]
-	ydk.YLogDebug(fmt.Sprintf("path.populateDataNode: Populating leafs in datanode with path '%s'", dnPath))
-	populateNameValues(state, dataNode, path)
-	walkChildren(state, entity, dataNode)
-}
-
-func populateNameValues(
-	state *errors.State, dataNode C.DataNode, path types.EntityPath) {
-
+func (batch *dataNodeBatch) addNameValues(parent int, path types.EntityPath) {
 	for _, nameValue := range path.ValuePaths {
-		var result C.DataNode
 		leafData := nameValue.Data
-		p := C.CString(nameValue.Name)
 		ydk.YLogDebug(fmt.Sprintf(
-			"path.populateNameValues: Got leaf {%s: %s}", nameValue.Name, nameValue.Data.Value))
+			"path.addNameValues: Got leaf {%s: %s}", nameValue.Name, nameValue.Data.Value))
 
 		if leafData.IsSet {
-			p1 := C.CString(leafData.Value)
-			result = C.DataNodeCreate(*GetCState(state), dataNode, p, p1)
-			PanicOnCStateError(GetCState(state))
-			C.free(unsafe.Pointer(p1))
+			batch.add(nameValue.Name, leafData.Value, leafData.Filter, parent)
 		}
+	}
+}
 
-		addDataNodeFilterAnnotation(&result, leafData.Filter)
-		C.free(unsafe.Pointer(p))
+func (batch *dataNodeBatch) create(state *errors.State, dataNode C.DataNode) {
+	count := len(batch.paths)
+	if count == 0 {
+		return
+	}
+	paths := newCStringArray(batch.paths)
+	defer C.free(unsafe.Pointer(paths))
+	values := newCStringArray(batch.values)
+	defer C.free(unsafe.Pointer(values))
+	operations := newCStringArray(batch.operations)
+	defer C.free(unsafe.Pointer(operations))
+
+	created := C.DataNodeCreateMany(*GetCState(state), dataNode,
+		paths, values, operations, &batch.parents[0], C.int(count))
+	if int(created) < count {
+		ydk.YLogError(fmt.Sprintf("Datanode could not be created for: %v", batch.paths[created]))
 	}
+	PanicOnCStateError(GetCState(state))
+}
+
+// newCStringArray copies strs to a single C allocation, an array of
+// pointers followed by the strings, to be released by C.free.
+func newCStringArray(strs []string) **C.char {
+	pointers := len(strs) * int(unsafe.Sizeof((*C.char)(nil)))
+	size := pointers
+	for _, s := range strs {
+		size += len(s) + 1
+	}
+	buffer := C.malloc(C.size_t(size))
+	array := (*[1 << 28]*C.char)(buffer)[:len(strs):len(strs)]
+	bytes := (*[1 << 30]byte)(buffer)[:size:size]
+	offset := pointers
+	for i, s := range strs {
+		copy(bytes[offset:], s)
+		bytes[offset+len(s)] = 0
+		array[i] = (*C.char)(unsafe.Pointer(&bytes[offset]))
+		offset += len(s) + 1
+	}
+	return (**C.char)(buffer)
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -974,32 +1005,42 @@ func getEntityFromDataNode(node C.DataNode, entity types.Entity) {
 		return
 	}
 
-	cchildren := C.DataNodeGetChildren(node)
-	children := (*[1 << 30]C.DataNode)(
-		unsafe.Pointer(cchildren.datanodes))[:cchildren.count:cchildren.count]
-	nodeName := C.GoString(C.DataNodeGetArgument(node))
-	ydk.YLogDebug(fmt.Sprintf("path.getEntityFromDataNode: Got %d children in datanode '%s'", cchildren.count, nodeName))
-	moduleName := C.GoString(C.DataNodeGetModuleName(node))
+	// the subtree is read in one call
+	nodes := flattenDataNode(node)
+	children := make([][]int, len(nodes))
+	for i, node := range nodes {
+		if node.Parent >= 0 {
+			children[node.Parent] = append(children[node.Parent], i)
+		}
+	}
+	getEntityFromDataNodes(nodes, children, 0, entity)
+}
+
+func getEntityFromDataNodes(
+	nodes []DataNodeEntry, children [][]int, index int, entity types.Entity) {
+
+	node := nodes[index]
+	ydk.YLogDebug(fmt.Sprintf("path.getEntityFromDataNode: Got %d children in datanode '%s'", len(children[index]), node.Argument))
 
-	for _, childDataNode := range children {
-		childName := C.GoString(C.DataNodeGetArgument(childDataNode))
-	        childModuleName := C.GoString(C.DataNodeGetModuleName(childDataNode))
+	for _, childIndex := range children[index] {
+		childDataNode := nodes[childIndex]
+		childName := childDataNode.Argument
 		ydk.YLogDebug(fmt.Sprintf("Looking at child datanode: '%s'", childName))
-	        if(moduleName != childModuleName) {
-	            childName = childModuleName + ":" + childName
-	        }
+		if node.ModuleName != childDataNode.ModuleName {
+			childName = childDataNode.ModuleName + ":" + childName
+		}
 
-		if dataNodeIsLeaf(childDataNode) {
+		if childDataNode.Keyword == "leaf" || childDataNode.Keyword == "leaf-list" {
 
-			value := C.GoString(C.DataNodeGetValue(childDataNode))
+			value := childDataNode.Value
 			ydk.YLogDebug(fmt.Sprintf(
 				"Creating leaf '%s' with value '%s'", childName, value))
 			types.SetValue(entity, childName, value)
 		} else {
 
 			var childEntity types.Entity
-			if dataNodeIsList(childDataNode) {
-				segmentPath := C.GoString(C.DataNodeGetSegmentPath(childDataNode))
+			if childDataNode.Keyword == "list" {
+				segmentPath := childDataNode.SegmentPath
 				ydk.YLogDebug(fmt.Sprintf("Creating child list instance '%s' with path '%s'", childName, segmentPath))
 				childEntity = types.GetChildByName(entity, childName, segmentPath)
 			} else {
@@ -1012,18 +1053,55 @@ func getEntityFromDataNode(node C.DataNode, entity types.Entity) {
 			}
 			types.SetPresenceFlag(childEntity)
 			types.SetParent(childEntity, entity)
-			getEntityFromDataNode(childDataNode, childEntity)
+			getEntityFromDataNodes(nodes, children, childIndex, childEntity)
 		}
 	}
 }
 
-func dataNodeIsLeaf(dataNode C.DataNode) bool {
-	return C.GoString(C.DataNodeGetKeyword(dataNode)) == "leaf" ||
-		C.GoString(C.DataNodeGetKeyword(dataNode)) == "leaf-list"
+// DataNodeEntry describes a data node of a flattened subtree.
+type DataNodeEntry struct {
+	Path        string
+	SegmentPath string
+	Value       string
+	Keyword     string
+	Argument    string
+	ModuleName  string
+	// Index of the parent entry, -1 for the root of the subtree
+	Parent int
 }
 
-func dataNodeIsList(dataNode C.DataNode) bool {
-	return C.GoString(C.DataNodeGetKeyword(dataNode)) == "list"
+func flattenDataNode(dataNode C.DataNode) []DataNodeEntry {
+	var state errors.State
+	AddCState(&state)
+	cstate := GetCState(&state)
+	defer C.YDKStateFree(*cstate)
+
+	arena := C.DataNodeFlatten(*cstate, dataNode)
+	PanicOnCStateError(cstate)
+	defer C.DataNodeArenaFree(arena)
+
+	count := int(arena.count)
+	paths := (*[1 << 28]*C.char)(unsafe.Pointer(arena.paths))[:count:count]
+	segmentPaths := (*[1 << 28]*C.char)(unsafe.Pointer(arena.segment_paths))[:count:count]
+	values := (*[1 << 28]*C.char)(unsafe.Pointer(arena.values))[:count:count]
+	keywords := (*[1 << 28]*C.char)(unsafe.Pointer(arena.keywords))[:count:count]
+	arguments := (*[1 << 28]*C.char)(unsafe.Pointer(arena.arguments))[:count:count]
+	moduleNames := (*[1 << 28]*C.char)(unsafe.Pointer(arena.module_names))[:count:count]
+	parents := (*[1 << 28]C.int)(unsafe.Pointer(arena.parents))[:count:count]
+
+	nodes := make([]DataNodeEntry, count)
+	for i := range nodes {
+		nodes[i] = DataNodeEntry{
+			Path:        C.GoString(paths[i]),
+			SegmentPath: C.GoString(segmentPaths[i]),
+			Value:       C.GoString(values[i]),
+			Keyword:     C.GoString(keywords[i]),
+			Argument:    C.GoString(arguments[i]),
+			ModuleName:  C.GoString(moduleNames[i]),
+			Parent:      int(parents[i]),
+		}
+	}
+	return nodes
 }
 
 func addDataNodeFilterAnnotation(dataNode *C.DataNode, yf yfilter.YFilter) {
@@ -1139,6 +1217,30 @@ func CreateDataNode(dn types.DataNode, path string, value interface{}) types.Dat
 	return datanode
 }
 
+// CreateDataNodes creates data nodes at the given paths relative to dn, with
+// the given values, in a single call to the C API.
+func CreateDataNodes(dn types.DataNode, paths []string, values []string) {
+	if len(paths) != len(values) {
+		panic("path.CreateDataNodes: paths and values differ in length")
+	}
+	var state errors.State
+	AddCState(&state)
+	cstate := GetCState(&state)
+	defer C.YDKStateFree(*cstate)
+
+	var batch dataNodeBatch
+	for i, path := range paths {
+		batch.add(path, values[i], yfilter.NotSet, -1)
+	}
+	batch.create(&state, dn.Private.(C.DataNode))
+}
+
+// FlattenDataNode reads the subtree at dn in a single call to the C API.
+// Returns the data nodes of the subtree, each following its parent.
+func FlattenDataNode(dn types.DataNode) []DataNodeEntry {
+	return flattenDataNode(dn.Private.(C.DataNode))
+}
+
 func CreateRootDataNode(rsn types.RootSchemaNode, path string) types.DataNode {
 	var state errors.State
 	AddCState(&state)
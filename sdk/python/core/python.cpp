@@ -49,6 +49,11 @@ PYBIND11_MAKE_OPAQUE(LeafDataList)
 typedef std::map<std::string, std::shared_ptr<ydk::Entity>> ChildrenMap;
 PYBIND11_MAKE_OPAQUE(ChildrenMap)
 
+// Releases the GIL for calls that block on a device or walk large trees, so
+// that other Python threads can run meanwhile. Calls back into Python, i.e.
+// the PyEntity overloads and the logging callbacks, reacquire it.
+typedef call_guard<gil_scoped_release> release_gil;
+
 
 static object log_debug;
 static object log_info;
@@ -78,11 +83,11 @@ void add_null_handler(object logger)
     }
 }
 
-void debug(const char* msg) { log_debug(msg); }
-void info(const char* msg) { log_info(msg); }
-void warning(const char* msg) { log_warning(msg); }
-void error(const char* msg) { log_error(msg); }
-void critical(const char* msg) { log_critical(msg); }
+void debug(const char* msg) { gil_scoped_acquire acquire; log_debug(msg); }
+void info(const char* msg) { gil_scoped_acquire acquire; log_info(msg); }
+void warning(const char* msg) { gil_scoped_acquire acquire; log_warning(msg); }
+void error(const char* msg) { gil_scoped_acquire acquire; log_error(msg); }
+void critical(const char* msg) { gil_scoped_acquire acquire; log_critical(msg); }
 
 void setup_logging()
 {
@@ -294,8 +299,8 @@ PYBIND11_MODULE(ydk_, ydk)
 
     class_<ydk::path::Session>(path, "Session", module_local())
         .def("get_root_schema", &ydk::path::Session::get_root_schema, return_value_policy::reference)
-        .def("invoke", (std::shared_ptr<ydk::path::DataNode> (ydk::path::Session::*)(ydk::path::Rpc& rpc) const) &ydk::path::Session::invoke, return_value_policy::reference)
-        .def("invoke", (std::shared_ptr<ydk::path::DataNode> (ydk::path::Session::*)(ydk::path::DataNode& rpc) const) &ydk::path::Session::invoke, return_value_policy::reference);
+        .def("invoke", (std::shared_ptr<ydk::path::DataNode> (ydk::path::Session::*)(ydk::path::Rpc& rpc) const) &ydk::path::Session::invoke, return_value_policy::reference, release_gil())
+        .def("invoke", (std::shared_ptr<ydk::path::DataNode> (ydk::path::Session::*)(ydk::path::DataNode& rpc) const) &ydk::path::Session::invoke, return_value_policy::reference, release_gil());
 
     class_<ydk::path::NetconfSession, ydk::path::Session>(path, "NetconfSession")
         .def(init([](ydk::path::Repository & repo,
@@ -317,7 +322,7 @@ PYBIND11_MODULE(ydk_, ydk)
             arg("port")=830,
             arg("protocol")=string("ssh"),
             arg("on_demand")=true,
-            arg("timeout")=-1)
+            arg("timeout")=-1, release_gil())
 
         .def(init([](const string& address,
                      const string& username,
@@ -338,7 +343,7 @@ PYBIND11_MODULE(ydk_, ydk)
                 arg("protocol")=string("ssh"),
                 arg("on_demand")=true,
                 arg("common_cache")=false,
-                arg("timeout")=-1)
+                arg("timeout")=-1, release_gil())
 
         .def(init([](ydk::path::Repository& repo,
                      const string& address,
@@ -359,7 +364,7 @@ PYBIND11_MODULE(ydk_, ydk)
             arg("public_key_path"),
             arg("port")=830,
             arg("on_demand")=true,
-            arg("timeout")=-1)
+            arg("timeout")=-1, release_gil())
 
         .def(init([](const string& address,
                      const string& username,
@@ -380,12 +385,12 @@ PYBIND11_MODULE(ydk_, ydk)
             arg("port")=830,
             arg("on_demand")=true,
             arg("common_cache")=false,
-            arg("timeout")=-1)
+            arg("timeout")=-1, release_gil())
 
         .def("get_root_schema", &ydk::path::NetconfSession::get_root_schema, return_value_policy::reference)
-        .def("invoke", (std::shared_ptr<ydk::path::DataNode> (ydk::path::NetconfSession::*)(ydk::path::Rpc& rpc) const) &ydk::path::NetconfSession::invoke, return_value_policy::reference)
-        .def("invoke", (std::shared_ptr<ydk::path::DataNode> (ydk::path::NetconfSession::*)(ydk::path::DataNode& rpc) const) &ydk::path::NetconfSession::invoke, return_value_policy::reference)
-        .def("execute_netconf_operation", (std::string (ydk::path::NetconfSession::*)(ydk::path::Rpc& rpc) const) &ydk::path::NetconfSession::execute_netconf_operation)
+        .def("invoke", (std::shared_ptr<ydk::path::DataNode> (ydk::path::NetconfSession::*)(ydk::path::Rpc& rpc) const) &ydk::path::NetconfSession::invoke, return_value_policy::reference, release_gil())
+        .def("invoke", (std::shared_ptr<ydk::path::DataNode> (ydk::path::NetconfSession::*)(ydk::path::DataNode& rpc) const) &ydk::path::NetconfSession::invoke, return_value_policy::reference, release_gil())
+        .def("execute_netconf_operation", (std::string (ydk::path::NetconfSession::*)(ydk::path::Rpc& rpc) const) &ydk::path::NetconfSession::execute_netconf_operation, release_gil())
         .def("get_capabilities", &ydk::path::NetconfSession::get_capabilities, return_value_policy::reference);
 
     class_<ydk::path::RestconfSession, ydk::path::Session>(path, "RestconfSession")
@@ -408,10 +413,10 @@ PYBIND11_MODULE(ydk_, ydk)
              arg("port"),
              arg("encoding"),
              arg("config_url_root"),
-             arg("state_url_root"))
+             arg("state_url_root"), release_gil())
         .def("get_root_schema", &ydk::path::RestconfSession::get_root_schema, return_value_policy::reference)
-        .def("invoke", (std::shared_ptr<ydk::path::DataNode> (ydk::path::RestconfSession::*)(ydk::path::Rpc& rpc) const) &ydk::path::RestconfSession::invoke, return_value_policy::reference)
-        .def("invoke", (std::shared_ptr<ydk::path::DataNode> (ydk::path::RestconfSession::*)(ydk::path::DataNode& rpc) const) &ydk::path::RestconfSession::invoke, return_value_policy::reference);
+        .def("invoke", (std::shared_ptr<ydk::path::DataNode> (ydk::path::RestconfSession::*)(ydk::path::Rpc& rpc) const) &ydk::path::RestconfSession::invoke, return_value_policy::reference, release_gil())
+        .def("invoke", (std::shared_ptr<ydk::path::DataNode> (ydk::path::RestconfSession::*)(ydk::path::DataNode& rpc) const) &ydk::path::RestconfSession::invoke, return_value_policy::reference, release_gil());
 
     class_<ydk::path::Statement>(path, "Statement")
         .def(init<const string &, const string &>(), arg("keyword"), arg("arg"))
@@ -444,7 +449,7 @@ PYBIND11_MODULE(ydk_, ydk)
         .def("add_annotation", &ydk::path::DataNode::add_annotation, return_value_policy::reference, arg("annotation"))
         .def("remove_annotation", &ydk::path::DataNode::remove_annotation, return_value_policy::reference, arg("annotation"))
         .def("annotations", &ydk::path::DataNode::annotations, return_value_policy::reference)
-        .def("__call__", &ydk::path::DataNode::operator(), arg("service_provider"));
+        .def("__call__", &ydk::path::DataNode::operator(), arg("service_provider"), release_gil());
 
     class_<ydk::path::RootSchemaNode, shared_ptr<ydk::path::RootSchemaNode>>(path, "RootSchemaNode")
         .def("get_path", &ydk::path::RootSchemaNode::get_path, return_value_policy::reference)
@@ -464,7 +469,7 @@ PYBIND11_MODULE(ydk_, ydk)
         .def("get_schema_node", &ydk::path::Rpc::get_schema_node, return_value_policy::reference)
         .def("get_input_node", &ydk::path::Rpc::get_input_node, return_value_policy::reference)
         .def("has_output_node", &ydk::path::Rpc::has_output_node)
-        .def("__call__", &ydk::path::Rpc::operator(), arg("service_provider"));
+        .def("__call__", &ydk::path::Rpc::operator(), arg("service_provider"), release_gil());
 
     class_<ydk::path::Repository>(path, "Repository")
         .def(init<>())
@@ -485,13 +490,13 @@ PYBIND11_MODULE(ydk_, ydk)
     codec
         .def(init<>())
         .def("encode", (std::string (ydk::path::Codec::*)(const ydk::path::DataNode&, ydk::EncodingFormat, bool))
-                &ydk::path::Codec::encode, arg("data_node"), arg("encoding"), arg("pretty"))
+                &ydk::path::Codec::encode, arg("data_node"), arg("encoding"), arg("pretty"), release_gil())
         .def("encode", (std::string (ydk::path::Codec::*)(std::vector<ydk::path::DataNode*>&, ydk::EncodingFormat, bool))
-                &ydk::path::Codec::encode, arg("data_node"), arg("encoding"), arg("pretty"))
-        .def("decode", &ydk::path::Codec::decode, arg("root_schema_node"), arg("payload"), arg("encoding"))
-        .def("decode_rpc_output", &ydk::path::Codec::decode_rpc_output, arg("root_schema_node"), arg("payload"), arg("rpc_path"), arg("encoding"))
+                &ydk::path::Codec::encode, arg("data_node"), arg("encoding"), arg("pretty"), release_gil())
+        .def("decode", &ydk::path::Codec::decode, arg("root_schema_node"), arg("payload"), arg("encoding"), release_gil())
+        .def("decode_rpc_output", &ydk::path::Codec::decode_rpc_output, arg("root_schema_node"), arg("payload"), arg("rpc_path"), arg("encoding"), release_gil())
         .def("decode_json_output", (std::shared_ptr<ydk::path::DataNode> (ydk::path::Codec::*)(ydk::path::RootSchemaNode&, const std::vector<std::string>&))
-        		&ydk::path::Codec::decode_json_output, arg("root_schema_node"), arg("buffer_list"));
+        		&ydk::path::Codec::decode_json_output, arg("root_schema_node"), arg("buffer_list"), release_gil());
 
     enum_<ydk::DataStore>(services, "Datastore")
         .value("candidate", ydk::DataStore::candidate)
@@ -533,7 +538,8 @@ PYBIND11_MODULE(ydk_, ydk)
 
     enum_<ydk::path::ModelCachingOption>(types, "ModelCachingOption")
         .value("common", ydk::path::ModelCachingOption::COMMON)
-        .value("per_device", ydk::path::ModelCachingOption::PER_DEVICE);
+        .value("per_device", ydk::path::ModelCachingOption::PER_DEVICE)
+        .value("shared", ydk::path::ModelCachingOption::SHARED);
 
     class_<ydk::Empty>(types, "Empty")
         .def(init<>())
@@ -578,9 +584,15 @@ PYBIND11_MODULE(ydk_, ydk)
                             return left.operator!=(right);
                          })
         .def_readwrite("yfilter", &ydk::Entity::yfilter)
-        .def_readwrite("yang_name", &ydk::Entity::yang_name, return_value_policy::reference)
-        .def_readwrite("ylist_key_names", &ydk::Entity::ylist_key_names, return_value_policy::reference)
-        .def_readwrite("yang_parent_name", &ydk::Entity::yang_parent_name, return_value_policy::reference)
+        .def_property("yang_name",
+                      [](const ydk::Entity& entity) { return entity.yang_name.str(); },
+                      [](ydk::Entity& entity, const string& name) { entity.yang_name = name; })
+        .def_property("ylist_key_names",
+                      [](const ydk::Entity& entity) { return entity.ylist_key_names.get(); },
+                      [](ydk::Entity& entity, const vector<string>& names) { entity.ylist_key_names = names; })
+        .def_property("yang_parent_name",
+                      [](const ydk::Entity& entity) { return entity.yang_parent_name.str(); },
+                      [](ydk::Entity& entity, const string& name) { entity.yang_parent_name = name; })
         .def_readwrite("is_presence_container", &ydk::Entity::is_presence_container, return_value_policy::reference)
         .def_readwrite("is_top_level_class", &ydk::Entity::is_top_level_class)
         .def_readwrite("has_list_ancestor", &ydk::Entity::has_list_ancestor)
@@ -596,19 +608,22 @@ PYBIND11_MODULE(ydk_, ydk)
 
     class_<ydk::Bits>(types, "Bits")
         .def(init<>())
-        .def("__getitem__", &ydk::Bits::operator[], return_value_policy::reference)
+        .def("__getitem__", []( ydk::Bits &b, std::string key)
+                              {
+                                  return static_cast<bool>(b[key]);
+                              })
         .def("__setitem__", []( ydk::Bits &b, std::string key, bool value)
                               {
                                   b[key] = value;
                               })
-        .def("get_bitmap", &ydk::Bits::get_bitmap, return_value_policy::reference)
+        .def("get_bitmap", &ydk::Bits::get_bitmap)
         .def("__eq__", [](ydk::Bits& left, ydk::Bits& right)
                          {
-                            return left.get_bitmap()==right.get_bitmap();
+                            return left==right;
                          })
         .def("__ne__", [](ydk::Bits& left, ydk::Bits& right)
                          {
-                            return left.get_bitmap()!=right.get_bitmap();
+                            return left!=right;
                          });
 
     class_<ydk::Decimal64>(types, "Decimal64")
@@ -625,7 +640,7 @@ PYBIND11_MODULE(ydk_, ydk)
 
     class_<ydk::Identity>(types, "Identity")
         .def(init<const std::string &, const std::string &, const std::string &>())
-        .def("to_string", &ydk::Identity::to_string, return_value_policy::reference)
+        .def("to_string", &ydk::Identity::to_string)
         .def("__str__", [](ydk::Identity &id)
                           {
                                return id.to_string();
@@ -647,10 +662,12 @@ PYBIND11_MODULE(ydk_, ydk)
         .def(init<int, string>())
         .def("__str__", [](const ydk::Enum::YLeaf &eyl)
                         {
-                            return eyl.name;
+                            return eyl.name.str();
                         })
         .def_readwrite("value", &ydk::Enum::YLeaf::value)
-        .def_readwrite("name", &ydk::Enum::YLeaf::name);
+        .def_property("name",
+                      [](const ydk::Enum::YLeaf& eyl) { return eyl.name.str(); },
+                      [](ydk::Enum::YLeaf& eyl, const string& name) { eyl.name = name; });
 
     class_<ydk::YLeaf>(types, "YLeaf")
         .def(init<ydk::YType, string>(), arg("leaf_type"), arg("name"))
@@ -662,7 +679,10 @@ PYBIND11_MODULE(ydk_, ydk)
                           {
                                return yl.get();
                           })
-        .def("__getitem__", &ydk::YLeaf::operator[], return_value_policy::reference)
+        .def("__getitem__", []( ydk::YLeaf &yl, std::string key)
+                              {
+                                  return static_cast<bool>(yl[key]);
+                              })
         .def("__setitem__", []( ydk::YLeaf &yl, std::string key, bool value)
                               {
                                   yl[key] = value;
@@ -681,11 +701,26 @@ PYBIND11_MODULE(ydk_, ydk)
         .def("set", (void (ydk::YLeaf::*)(ydk::Enum::YLeaf)) &ydk::YLeaf::set, arg("value"))
         .def("set", (void (ydk::YLeaf::*)(ydk::Decimal64)) &ydk::YLeaf::set, arg("value"))
         .def_readonly("is_set", &ydk::YLeaf::is_set, return_value_policy::reference)
-        .def_readonly("name", &ydk::YLeaf::name, return_value_policy::reference)
+        .def_property_readonly("name", [](const ydk::YLeaf& leaf) { return leaf.name.str(); })
         .def_readonly("type", &ydk::YLeaf::type, return_value_policy::reference)
-        .def_readwrite("yfilter", &ydk::YLeaf::yfilter)
-        .def_readwrite("value_namespace", &ydk::YLeaf::value_namespace)
-        .def_readwrite("value_namespace_prefix", &ydk::YLeaf::value_namespace_prefix);
+        .def_property("yfilter",
+                      [](const ydk::YLeaf& leaf) { return leaf.yfilter; },
+                      [](ydk::YLeaf& leaf, ydk::YFilter yfilter) {
+                          leaf.yfilter = yfilter;
+                          if (leaf.owner) leaf.owner->invalidate_cached_hashes();
+                      })
+        .def_property("value_namespace",
+                      [](const ydk::YLeaf& leaf) { return leaf.value_namespace.str(); },
+                      [](ydk::YLeaf& leaf, const string& name_space) {
+                          leaf.value_namespace = name_space;
+                          if (leaf.owner) leaf.owner->invalidate_cached_hashes();
+                      })
+        .def_property("value_namespace_prefix",
+                      [](const ydk::YLeaf& leaf) { return leaf.value_namespace_prefix.str(); },
+                      [](ydk::YLeaf& leaf, const string& prefix) {
+                          leaf.value_namespace_prefix = prefix;
+                          if (leaf.owner) leaf.owner->invalidate_cached_hashes();
+                      });
 
     class_<ydk::YLeafList, PyYLeafList>(types, "YLeafList")
         .def(init<ydk::YType, string>(), arg("leaflist_type"), arg("name"))
@@ -715,9 +750,14 @@ PYBIND11_MODULE(ydk_, ydk)
                         {
                             l.clear();
                         })
-        .def_readonly("name", &ydk::YLeafList::name, return_value_policy::reference)
+        .def_property_readonly("name", [](const ydk::YLeafList& leaf_list) { return leaf_list.name.str(); })
         .def_readonly("type", &ydk::YLeafList::type, return_value_policy::reference)
-        .def_readwrite("yfilter", &ydk::YLeafList::yfilter);
+        .def_property("yfilter",
+                      [](const ydk::YLeafList& leaf) { return leaf.yfilter; },
+                      [](ydk::YLeafList& leaf, ydk::YFilter yfilter) {
+                          leaf.yfilter = yfilter;
+                          if (leaf.owner) leaf.owner->invalidate_cached_hashes();
+                      });
 
     class_<ydk::NetconfServiceProvider, ydk::ServiceProvider>(providers, "NetconfServiceProvider")
         .def(init(
@@ -732,7 +772,7 @@ PYBIND11_MODULE(ydk_, ydk)
             arg("port")=830,
             arg("protocol")=string("ssh"),
             arg("on_demand")=true,
-            arg("timeout")=-1)
+            arg("timeout")=-1, release_gil())
 
         .def(init(
             [](const string& address, const string& username, const string& password, int port, const string& protocol, bool on_demand, bool common_cache, int timeout)
@@ -746,7 +786,7 @@ PYBIND11_MODULE(ydk_, ydk)
             arg("protocol")=string("ssh"),
             arg("on_demand")=true,
             arg("common_cache")=false,
-            arg("timeout")=-1)
+            arg("timeout")=-1, release_gil())
 
         .def(init(
             [](ydk::path::Repository& repo,
@@ -767,7 +807,7 @@ PYBIND11_MODULE(ydk_, ydk)
             arg("public_key_path"),
             arg("port")=830,
             arg("on_demand")=true,
-            arg("timeout")=-1)
+            arg("timeout")=-1, release_gil())
 
         .def(init(
             [](const string& address,
@@ -789,7 +829,7 @@ PYBIND11_MODULE(ydk_, ydk)
             arg("port")=830,
             arg("on_demand")=true,
             arg("common_cache")=false,
-            arg("timeout")=-1)
+            arg("timeout")=-1, release_gil())
 
         .def("get_encoding", &ydk::NetconfServiceProvider::get_encoding, return_value_policy::reference)
         .def("get_session", &ydk::NetconfServiceProvider::get_session, return_value_policy::reference)
@@ -797,13 +837,13 @@ PYBIND11_MODULE(ydk_, ydk)
 
     class_<ydk::RestconfServiceProvider, ydk::ServiceProvider>(providers, "RestconfServiceProvider")
         .def(init<ydk::path::Repository&, string, string, string, int, ydk::EncodingFormat>(),
-            arg("repo"), arg("address"), arg("username"), arg("password"), arg("port"), arg("encoding"))
+            arg("repo"), arg("address"), arg("username"), arg("password"), arg("port"), arg("encoding"), release_gil())
         .def("get_encoding", &ydk::RestconfServiceProvider::get_encoding, return_value_policy::reference)
         .def("get_session", &ydk::RestconfServiceProvider::get_session, return_value_policy::reference);
 
     class_<ydk::OpenDaylightServiceProvider>(providers, "OpenDaylightServiceProvider")
         .def(init<ydk::path::Repository&, string, string, string, int, ydk::EncodingFormat>(),
-            arg("repo"), arg("address"), arg("username"), arg("password"), arg("port"), arg("encoding"))
+            arg("repo"), arg("address"), arg("username"), arg("password"), arg("port"), arg("encoding"), release_gil())
         .def("get_node_provider", &ydk::OpenDaylightServiceProvider::get_node_provider, return_value_policy::reference)
         .def("get_node_ids", &ydk::OpenDaylightServiceProvider::get_node_ids, return_value_policy::reference);
 
@@ -812,56 +852,56 @@ PYBIND11_MODULE(ydk_, ydk)
         .def("create",
             (bool (ydk::CrudService::*)
                 (ydk::ServiceProvider& provider, ydk::Entity& entity)) &ydk::CrudService::create,
-            return_value_policy::reference)
+            return_value_policy::reference, release_gil())
         .def("create",
             (bool (ydk::CrudService::*)
                 (ydk::ServiceProvider& provider, vector<ydk::Entity*>& entity_list)) &ydk::CrudService::create,
-            return_value_policy::reference)
+            return_value_policy::reference, release_gil())
         .def("read",
             (shared_ptr<ydk::Entity> (ydk::CrudService::*)
-                (ydk::ServiceProvider& provider, ydk::Entity& entity)) &ydk::CrudService::read)
+                (ydk::ServiceProvider& provider, ydk::Entity& entity)) &ydk::CrudService::read, release_gil())
         .def("read",
             (vector<shared_ptr<ydk::Entity>> (ydk::CrudService::*)
-                (ydk::ServiceProvider& provider, vector<ydk::Entity*>& entity_list)) &ydk::CrudService::read)
+                (ydk::ServiceProvider& provider, vector<ydk::Entity*>& entity_list)) &ydk::CrudService::read, release_gil())
         .def("read_config",
             (shared_ptr<ydk::Entity> (ydk::CrudService::*)
-                (ydk::ServiceProvider& provider, ydk::Entity& entity)) &ydk::CrudService::read_config)
+                (ydk::ServiceProvider& provider, ydk::Entity& entity)) &ydk::CrudService::read_config, release_gil())
         .def("read_config",
             (vector<shared_ptr<ydk::Entity>> (ydk::CrudService::*)
-                (ydk::ServiceProvider& provider, vector<ydk::Entity*>& entity_list)) &ydk::CrudService::read_config)
+                (ydk::ServiceProvider& provider, vector<ydk::Entity*>& entity_list)) &ydk::CrudService::read_config, release_gil())
         .def("update",
             (bool (ydk::CrudService::*)
                 (ydk::ServiceProvider& provider, ydk::Entity& entity)) &ydk::CrudService::update,
-            return_value_policy::reference)
+            return_value_policy::reference, release_gil())
         .def("update",
             (bool (ydk::CrudService::*)
                 (ydk::ServiceProvider& provider, vector<ydk::Entity*>& entity_list)) &ydk::CrudService::update,
-            return_value_policy::reference)
+            return_value_policy::reference, release_gil())
         .def("delete",
             (bool (ydk::CrudService::*)
                 (ydk::ServiceProvider& provider, ydk::Entity& entity)) &ydk::CrudService::delete_,
-            return_value_policy::reference)
+            return_value_policy::reference, release_gil())
         .def("delete",
             (bool (ydk::CrudService::*)
                 (ydk::ServiceProvider& provider, vector<ydk::Entity*>& entity_list)) &ydk::CrudService::delete_,
-            return_value_policy::reference);
+            return_value_policy::reference, release_gil());
 
     class_<ydk::ExecutorService>(services, "ExecutorService")
         .def(init<>())
         .def("execute_rpc", &ydk::ExecutorService::execute_rpc, arg("provider"), arg("entity"),
-            arg("top_entity") = nullptr);
+            arg("top_entity") = nullptr, release_gil());
 
     class_<ydk::NetconfService>(services, "NetconfService")
         .def(init<>())
         .def("cancel_commit", &ydk::NetconfService::cancel_commit,
             arg("provider"), arg("persist-id") = -1,
-            return_value_policy::reference)
+            return_value_policy::reference, release_gil())
         .def("close_session", &ydk::NetconfService::close_session,
-            arg("provider"))
+            arg("provider"), release_gil())
         .def("commit", &ydk::NetconfService::commit,
             arg("provider"), arg("confirmed") = false,
             arg("confirm_timeout") = -1, arg("persist") = -1,
-            arg("persist-id") = -1, return_value_policy::reference)
+            arg("persist-id") = -1, return_value_policy::reference, release_gil())
         .def("copy_config",
             (bool (ydk::NetconfService::*)(ydk::NetconfServiceProvider&, ydk::DataStore, ydk::DataStore, std::string))
                 &ydk::NetconfService::copy_config,
@@ -869,60 +909,60 @@ PYBIND11_MODULE(ydk_, ydk)
             arg("target"),
             arg("source"),
             arg("url") = std::string{""},
-            return_value_policy::reference)
+            return_value_policy::reference, release_gil())
         .def("copy_config",
             (bool (ydk::NetconfService::*)(ydk::NetconfServiceProvider&, ydk::DataStore, ydk::Entity&))
                 &ydk::NetconfService::copy_config,
             arg("provider"),
             arg("target"),
             arg("source_config"),
-            return_value_policy::reference)
+            return_value_policy::reference, release_gil())
         .def("copy_config",
             (bool (ydk::NetconfService::*)(ydk::NetconfServiceProvider&, ydk::DataStore, vector<ydk::Entity*>&))
                 &ydk::NetconfService::copy_config,
             arg("provider"),
             arg("target"),
             arg("source_config"),
-            return_value_policy::reference)
+            return_value_policy::reference, release_gil())
         .def("delete_config", &ydk::NetconfService::delete_config,
             arg("provider"), arg("target"), arg("url") = std::string{""},
-            return_value_policy::reference)
+            return_value_policy::reference, release_gil())
         .def("discard_changes", &ydk::NetconfService::discard_changes,
-            arg("provider"), return_value_policy::reference)
+            arg("provider"), return_value_policy::reference, release_gil())
         .def("edit_config",
             (bool (ydk::NetconfService::*)(ydk::NetconfServiceProvider&, ydk::DataStore, ydk::Entity&, string, string, string))
                 &ydk::NetconfService::edit_config,
             arg("provider"), arg("target"), arg("config"),
             arg("default_operation") = std::string{""}, arg("test_option") = std::string{""},
-            arg("error_option") = std::string{""}, return_value_policy::reference)
+            arg("error_option") = std::string{""}, return_value_policy::reference, release_gil())
         .def("edit_config",
             (bool (ydk::NetconfService::*)(ydk::NetconfServiceProvider&, ydk::DataStore, vector<ydk::Entity*>&, string, string, string))
                 &ydk::NetconfService::edit_config,
             arg("provider"), arg("target"), arg("config"),
             arg("default_operation") = std::string{""}, arg("test_option") = std::string{""},
-            arg("error_option") = std::string{""}, return_value_policy::reference)
+            arg("error_option") = std::string{""}, return_value_policy::reference, release_gil())
         .def("get_config",
             (shared_ptr<ydk::Entity> (ydk::NetconfService::*)(ydk::NetconfServiceProvider&, ydk::DataStore, ydk::Entity&))
                 &ydk::NetconfService::get_config,
-            arg("provider"), arg("source"), arg("filter"))
+            arg("provider"), arg("source"), arg("filter"), release_gil())
         .def("get_config",
             (vector<shared_ptr<ydk::Entity>> (ydk::NetconfService::*)(ydk::NetconfServiceProvider&, ydk::DataStore, vector<ydk::Entity*>&))
                 &ydk::NetconfService::get_config,
-            arg("provider"), arg("source"), arg("filter"))
+            arg("provider"), arg("source"), arg("filter"), release_gil())
         .def("get",
             (shared_ptr<ydk::Entity> (ydk::NetconfService::*)(ydk::NetconfServiceProvider&, ydk::Entity&))
                 &ydk::NetconfService::get,
-            arg("provider"), arg("filter"), return_value_policy::reference)
+            arg("provider"), arg("filter"), return_value_policy::reference, release_gil())
         .def("get",
             (vector<shared_ptr<ydk::Entity>> (ydk::NetconfService::*)(ydk::NetconfServiceProvider&, vector<ydk::Entity*>&))
                 &ydk::NetconfService::get,
-            arg("provider"), arg("filter"), return_value_policy::reference)
+            arg("provider"), arg("filter"), return_value_policy::reference, release_gil())
         .def("kill_session", &ydk::NetconfService::kill_session,
-            arg("provider"), arg("session_id"), return_value_policy::reference)
+            arg("provider"), arg("session_id"), return_value_policy::reference, release_gil())
         .def("lock", &ydk::NetconfService::lock,
-            arg("provider"), arg("target"), return_value_policy::reference)
+            arg("provider"), arg("target"), return_value_policy::reference, release_gil())
         .def("unlock", &ydk::NetconfService::unlock,
-            arg("provider"), arg("target"), return_value_policy::reference)
+            arg("provider"), arg("target"), return_value_policy::reference, release_gil())
         .def("validate",
             (bool (ydk::NetconfService::*)(ydk::NetconfServiceProvider&,
             ydk::DataStore,
@@ -931,23 +971,23 @@ PYBIND11_MODULE(ydk_, ydk)
             arg("provider"),
             arg("source"),
             arg("url") = std::string{""},
-            return_value_policy::reference)
+            return_value_policy::reference, release_gil())
         .def("validate",
             (bool (ydk::NetconfService::*)(ydk::NetconfServiceProvider&,
             ydk::Entity&)) &ydk::NetconfService::validate,
             arg("provider"),
             arg("source_config"),
-            return_value_policy::reference);
+            return_value_policy::reference, release_gil());
 
     class_<ydk::XmlSubtreeCodec>(entity_utils, "XmlSubtreeCodec")
         .def(init<>())
-        .def("encode", &ydk::XmlSubtreeCodec::encode, return_value_policy::reference)
-        .def("decode", &ydk::XmlSubtreeCodec::decode);
+        .def("encode", &ydk::XmlSubtreeCodec::encode, return_value_policy::reference, release_gil())
+        .def("decode", &ydk::XmlSubtreeCodec::decode, release_gil());
 
     class_<ydk::JsonSubtreeCodec>(entity_utils, "JsonSubtreeCodec")
         .def(init<>())
-        .def("encode", &ydk::JsonSubtreeCodec::encode, return_value_policy::reference)
-        .def("decode", &ydk::JsonSubtreeCodec::decode);
+        .def("encode", &ydk::JsonSubtreeCodec::encode, return_value_policy::reference, release_gil())
+        .def("decode", &ydk::JsonSubtreeCodec::decode, release_gil());
 
     entity_utils.def("get_entity_from_data_node", &ydk::get_entity_from_data_node);
     #if defined(PYBIND11_OVERLOAD_CAST)
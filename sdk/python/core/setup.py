@@ -32,7 +32,7 @@ NAME = 'ydk'
 
 VERSION = '0.8.4'
 
-INSTALL_REQUIREMENTS = ['pybind11>=2.1.1']
+INSTALL_REQUIREMENTS = ['pybind11>=2.2']
 
 LONG_DESCRIPTION = '''
                    The YANG Development Kit (YDK) is a Software Development Kit
@@ -72,7 +72,7 @@ class YdkBuildExtension(build_ext):
             import pybind11
         except ImportError:
             import pip
-            pip.main(['install', 'pybind11>=2.1.1'])
+            pip.main(['install', 'pybind11>=2.2'])
             import pybind11
 
         extdir = os.path.abspath(os.path.dirname(self.get_ext_fullpath(ext.name)))
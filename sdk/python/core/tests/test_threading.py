@@ -0,0 +1,146 @@
+#  ----------------------------------------------------------------
+# Copyright 2016 Cisco Systems
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ------------------------------------------------------------------
+
+"""test_threading.py
+Benchmark of concurrent requests from Python threads.
+
+Every thread talks to its own RESTCONF device, stood in for by a local
+server that answers after a fixed delay. The bindings release the GIL
+while a request blocks, so the throughput should grow about linearly with
+the number of threads.
+"""
+from __future__ import absolute_import, print_function
+
+import os
+import sys
+import threading
+import time
+import unittest
+from multiprocessing import Process, Queue
+
+if sys.version_info > (3,):
+    from http.server import BaseHTTPRequestHandler, HTTPServer
+    from socketserver import ThreadingMixIn
+else:
+    from BaseHTTPServer import BaseHTTPRequestHandler, HTTPServer
+    from SocketServer import ThreadingMixIn
+
+from ydk.path import Codec, Repository
+from ydk.path.sessions import RestconfSession
+from ydk.types import EncodingFormat
+
+DELAY = 0.05
+REQUESTS = 20
+THREADS = [1, 2, 4, 8, 16]
+
+CAPABILITIES = '''<capabilities>
+  <capability>http://cisco.com/ns/yang/ydktest-sanity?module=ydktest-sanity&amp;revision=2015-11-17</capability>
+</capabilities>'''
+
+RUNNER = '{"ydktest-sanity:runner":{"ytypes":{"built-in-t":{"number8":3}}}}'
+
+
+class StandInHandler(BaseHTTPRequestHandler):
+
+    def do_GET(self):
+        time.sleep(DELAY)
+        if 'capabilities' in self.path:
+            self._reply(CAPABILITIES)
+        else:
+            self._reply(RUNNER)
+
+    def _reply(self, body):
+        body = body.encode('utf-8')
+        self.send_response(200)
+        self.send_header('Content-Length', str(len(body)))
+        self.end_headers()
+        self.wfile.write(body)
+
+    def log_message(self, format, *args):
+        pass
+
+
+class StandInServer(ThreadingMixIn, HTTPServer):
+    daemon_threads = True
+    request_queue_size = 64
+
+
+def serve(ports):
+    server = StandInServer(('127.0.0.1', 0), StandInHandler)
+    ports.put(server.server_address[1])
+    server.serve_forever()
+
+
+class ThreadingBenchmark(unittest.TestCase):
+
+    @classmethod
+    def setUpClass(cls):
+        # the server runs in its own process so that it does not compete for
+        # the GIL with the threads being measured
+        ports = Queue()
+        cls.server = Process(target=serve, args=(ports,))
+        cls.server.daemon = True
+        cls.server.start()
+        cls.port = ports.get()
+
+        repo_path = os.path.dirname(__file__)
+        repo_path = os.path.join(repo_path, '..', '..', '..', 'cpp', 'core', 'tests', 'models')
+        cls.repo = Repository(repo_path)
+        cls.sessions = [RestconfSession(cls.repo, '127.0.0.1', 'admin', 'admin', cls.port,
+                                        EncodingFormat.JSON, '/data', '/data')
+                        for _ in range(max(THREADS))]
+
+    @classmethod
+    def tearDownClass(cls):
+        cls.server.terminate()
+        cls.server.join()
+
+    def _read(self, session):
+        codec = Codec()
+        root_schema = session.get_root_schema()
+        for _ in range(REQUESTS):
+            runner = root_schema.create_datanode('ydktest-sanity:runner', '')
+            read_rpc = root_schema.create_rpc('ydk:read')
+            read_rpc.get_input_node().create_datanode(
+                'filter', codec.encode(runner, EncodingFormat.JSON, False))
+            reply = read_rpc(session)
+            self.assertEqual(reply.find('ydktest-sanity:runner/ytypes/built-in-t/number8')[0].get_value(), '3')
+
+    def _run(self, threads):
+        workers = [threading.Thread(target=self._read, args=(session,))
+                   for session in self.sessions[:threads]]
+        start = time.time()
+        for worker in workers:
+            worker.start()
+        for worker in workers:
+            worker.join()
+        return time.time() - start
+
+    def test_scaling(self):
+        single = self._run(1)
+        print('\n%d requests of %.0f ms each per thread' % (REQUESTS, DELAY * 1000))
+        for threads in THREADS:
+            seconds = self._run(threads)
+            speedup = threads * single / seconds
+            print('%2d threads: %.2f s, %.1fx the throughput of one thread' % (threads, seconds, speedup))
+            # near-linear; without releasing the GIL the requests are serialized
+            self.assertGreater(speedup, threads * 0.6)
+
+
+if __name__ == '__main__':
+    suite = unittest.TestLoader().loadTestsFromTestCase(ThreadingBenchmark)
+    ret = not unittest.TextTestRunner(verbosity=2).run(suite).wasSuccessful()
+    sys.exit(ret)
@@ -41,6 +41,29 @@ template<> struct type_caster<std::vector<ydk::path::SchemaNode *>> : ListCaster
 };
 }}
 
+// Releases the GIL for calls that block on the target; see python.cpp
+typedef call_guard<gil_scoped_release> release_gil;
+
+// Wraps a Python callback to be called with the GIL released, possibly from
+// another thread. The wrapper holds the GIL whenever it touches the callback,
+// including when the last copy of it is destroyed.
+template <typename Result>
+static std::function<Result(const char *)> with_gil(const std::function<Result(const char *)> & func)
+{
+    typedef std::function<Result(const char *)> Callback;
+    if (!func) { return nullptr; }
+    std::shared_ptr<Callback> callback{new Callback{func}, [](Callback * c)
+    {
+        gil_scoped_acquire acquire;
+        delete c;
+    }};
+    return [callback](const char * response)
+    {
+        gil_scoped_acquire acquire;
+        return (*callback)(response);
+    };
+}
+
 static object log_debug;
 static object log_info;
 static object log_warning;
@@ -68,11 +91,11 @@ static void add_null_handler(object logger)
     }
 }
 
-void gnmi_debug(const char* msg) { log_debug(msg); }
-void gnmi_info(const char* msg) { log_info(msg); }
-void gnmi_warning(const char* msg) { log_warning(msg); }
-void gnmi_error(const char* msg) { log_error(msg); }
-void gnmi_critical(const char* msg) { log_critical(msg); }
+void gnmi_debug(const char* msg) { gil_scoped_acquire acquire; log_debug(msg); }
+void gnmi_info(const char* msg) { gil_scoped_acquire acquire; log_info(msg); }
+void gnmi_warning(const char* msg) { gil_scoped_acquire acquire; log_warning(msg); }
+void gnmi_error(const char* msg) { gil_scoped_acquire acquire; log_error(msg); }
+void gnmi_critical(const char* msg) { gil_scoped_acquire acquire; log_critical(msg); }
 
 static void setup_gnmi_logging()
 {
@@ -107,8 +130,8 @@ PYBIND11_MODULE(ydk_gnmi_, ydk_gnmi)
 
     class_<ydk::path::Session>(path, "Session", module_local())
         .def("get_root_schema", &ydk::path::Session::get_root_schema, return_value_policy::reference)
-        .def("invoke", (std::shared_ptr<ydk::path::DataNode> (ydk::path::Session::*)(ydk::path::Rpc& rpc) const) &ydk::path::Session::invoke, return_value_policy::reference)
-        .def("invoke", (std::shared_ptr<ydk::path::DataNode> (ydk::path::Session::*)(ydk::path::DataNode& rpc) const) &ydk::path::Session::invoke, return_value_policy::reference);
+        .def("invoke", (std::shared_ptr<ydk::path::DataNode> (ydk::path::Session::*)(ydk::path::Rpc& rpc) const) &ydk::path::Session::invoke, return_value_policy::reference, release_gil())
+        .def("invoke", (std::shared_ptr<ydk::path::DataNode> (ydk::path::Session::*)(ydk::path::DataNode& rpc) const) &ydk::path::Session::invoke, return_value_policy::reference, release_gil());
 
     class_<ydk::path::gNMISession, ydk::path::Session>(path, "gNMISession")
         .def(init<ydk::path::Repository&, const std::string&, int, const std::string&, const std::string&, const std::string&, const std::string&>(),
@@ -118,15 +141,22 @@ PYBIND11_MODULE(ydk_gnmi_, ydk_gnmi)
              arg("username"),
              arg("password"),
              arg("server_certificate")="",
-             arg("private_key")="")
+             arg("private_key")="",
+             release_gil())
         .def("get_root_schema", &ydk::path::gNMISession::get_root_schema, return_value_policy::reference)
         .def("invoke", (std::shared_ptr<ydk::path::DataNode> (ydk::path::gNMISession::*)(ydk::path::Rpc&) const)
-             &ydk::path::gNMISession::invoke, arg("rpc"), return_value_policy::reference)
-        .def("subscribe", (void (ydk::path::gNMISession::*)
-                                 (ydk::path::Rpc& rpc,
-                                  std::function<void(const char * response)> out_func,
-                                  std::function<bool(const char * response)> poll_func) const)
-             &ydk::path::gNMISession::invoke_subscribe,
+             &ydk::path::gNMISession::invoke, arg("rpc"), return_value_policy::reference, release_gil())
+        .def("subscribe",
+                [](ydk::path::gNMISession& session,
+                   ydk::path::Rpc& rpc,
+                   std::function<void(const char * response)> out_func,
+                   std::function<bool(const char * response)> poll_func)
+                {
+                    auto out = with_gil(out_func);
+                    auto poll = with_gil(poll_func);
+                    gil_scoped_release release;
+                    session.invoke_subscribe(rpc, out, poll);
+                },
                                   arg("rpc"),
                                   arg("output_callback_function")=nullptr,
                                   arg("poll_callback_function")=nullptr);
@@ -139,7 +169,7 @@ PYBIND11_MODULE(ydk_gnmi_, ydk_gnmi)
         .def(init<ydk::path::Repository&, const string&, int, const string&, const string&, const string&, const string&>(),
             arg("repo"), arg("address"), arg("port"),
             arg("username"), arg("password"),
-            arg("server_certificate")="", arg("private_key")="")
+            arg("server_certificate")="", arg("private_key")="", release_gil())
         .def("get_encoding", &ydk::gNMIServiceProvider::get_encoding, return_value_policy::reference)
         .def("get_session", &ydk::gNMIServiceProvider::get_session, return_value_policy::reference)
         .def("get_capabilities", &ydk::gNMIServiceProvider::get_capabilities, return_value_policy::reference);
@@ -154,17 +184,17 @@ PYBIND11_MODULE(ydk_gnmi_, ydk_gnmi)
 
     class_<ydk::gNMIService>(services, "gNMIService")
 	    .def(init<>())
-        .def("capabilities", &ydk::gNMIService::capabilities, arg("provider"), return_value_policy::reference)
+        .def("capabilities", &ydk::gNMIService::capabilities, arg("provider"), return_value_policy::reference, release_gil())
         .def("get", (shared_ptr<ydk::Entity> (ydk::gNMIService::*)
                 (ydk::gNMIServiceProvider & provider, ydk::Entity& filter, const string & operation) const)
-                &ydk::gNMIService::get, arg("provider"), arg("filter"), arg ("operation"), return_value_policy::reference)
+                &ydk::gNMIService::get, arg("provider"), arg("filter"), arg ("operation"), return_value_policy::reference, release_gil())
         .def("get", (vector<shared_ptr<ydk::Entity>> (ydk::gNMIService::*)
                 (ydk::gNMIServiceProvider & provider, vector<ydk::Entity*> & filter, const string & operation) const)
-                &ydk::gNMIService::get, arg("provider"), arg("filter"), arg ("operation"), return_value_policy::reference)
+                &ydk::gNMIService::get, arg("provider"), arg("filter"), arg ("operation"), return_value_policy::reference, release_gil())
         .def("set", (bool (ydk::gNMIService::*)(ydk::gNMIServiceProvider & provider, ydk::Entity& entity) const)
-                &ydk::gNMIService::set, arg("provider"), arg("entity"), return_value_policy::reference)
+                &ydk::gNMIService::set, arg("provider"), arg("entity"), return_value_policy::reference, release_gil())
         .def("set", (bool (ydk::gNMIService::*)(ydk::gNMIServiceProvider & provider, vector<ydk::Entity*> & entity_list) const)
-                &ydk::gNMIService::set, arg("provider"), arg("entity"), return_value_policy::reference)
+                &ydk::gNMIService::set, arg("provider"), arg("entity"), return_value_policy::reference, release_gil())
 
         .def("subscribe",
                 [](ydk::gNMIService& ns,
@@ -175,7 +205,9 @@ PYBIND11_MODULE(ydk_gnmi_, ydk_gnmi)
                    const string & encoding = "PROTO",
                    std::function<void(const char * response)> out_func = nullptr)
                 {
-                    ns.subscribe(provider, subscription, qos, mode, encoding, out_func);
+                    auto out = with_gil(out_func);
+                    gil_scoped_release release;
+                    ns.subscribe(provider, subscription, qos, mode, encoding, out);
                 })
 
         .def("subscribe",
@@ -187,7 +219,9 @@ PYBIND11_MODULE(ydk_gnmi_, ydk_gnmi)
                    const string & encoding = "PROTO",
                    std::function<void(const char * response)> out_func = nullptr)
                 {
-                    ns.subscribe(provider, subscription_list, qos, mode, encoding, out_func);
+                    auto out = with_gil(out_func);
+                    gil_scoped_release release;
+                    ns.subscribe(provider, subscription_list, qos, mode, encoding, out);
                 });
 
     setup_gnmi_logging();
@@ -0,0 +1,95 @@
+#  ----------------------------------------------------------------
+# Copyright 2016 Cisco Systems
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ------------------------------------------------------------------
+
+"""
+class_clone_printer.py
+
+ prints deep_clone and copy_to
+
+"""
+
+
+class ClassClonePrinter(object):
+    def __init__(self, ctx):
+        self.ctx = ctx
+
+    def print_class_clone(self, clazz, leafs, children):
+        self._print_deep_clone(clazz)
+        self._print_copy_to(clazz, leafs, children)
+
+    def _print_deep_clone(self, clazz):
+        self.ctx.writeln('std::shared_ptr<ydk::Entity> %s::deep_clone() const' % clazz.qualified_cpp_name())
+        self.ctx.writeln('{')
+        self.ctx.lvl_inc()
+        self.ctx.writeln('auto clone_ = ydk::make_entity<%s>();' % clazz.qualified_cpp_name())
+        self.ctx.writeln('copy_to(*clone_);')
+        self.ctx.writeln('return clone_;')
+        self.ctx.lvl_dec()
+        self.ctx.writeln('}')
+        self.ctx.bline()
+
+    def _print_copy_to(self, clazz, leafs, children):
+        self.ctx.writeln('void %s::copy_to(%s & clone_) const' % (clazz.qualified_cpp_name(), clazz.qualified_cpp_name()))
+        self.ctx.writeln('{')
+        self.ctx.lvl_inc()
+        self.ctx.writeln('clone_.yfilter = yfilter;')
+        self.ctx.writeln('clone_.ignore_validation = ignore_validation;')
+        for leaf in leafs:
+            if leaf.is_many:
+                self.ctx.writeln('clone_.%s = %s;' % (leaf.name, leaf.name))
+            else:
+                self.ctx.writeln('clone_.%s.assign(%s);' % (leaf.name, leaf.name))
+        for child in children:
+            if child.is_many:
+                self._print_copy_many(child)
+            else:
+                self._print_copy_unique(child)
+        self.ctx.lvl_dec()
+        self.ctx.writeln('}')
+        self.ctx.bline()
+
+    def _print_copy_many(self, child):
+        child_type = child.property_type.qualified_cpp_name()
+        self.ctx.writeln('for (auto ent_ : %s.entities())' % child.name)
+        self.ctx.writeln('{')
+        self.ctx.lvl_inc()
+        self.ctx.writeln('auto item_ = ydk::make_entity<%s>(clone_.arena);' % child_type)
+        # the keys are copied before the entry is placed in the list
+        self.ctx.writeln('std::static_pointer_cast<%s>(ent_)->copy_to(*item_);' % child_type)
+        self.ctx.writeln('clone_.%s.append(item_);' % child.name)
+        self.ctx.lvl_dec()
+        self.ctx.writeln('}')
+
+    def _print_copy_unique(self, child):
+        self.ctx.writeln('if(%s == nullptr)' % child.name)
+        self.ctx.writeln('{')
+        self.ctx.lvl_inc()
+        self.ctx.writeln('clone_.%s = nullptr;' % child.name)
+        self.ctx.lvl_dec()
+        self.ctx.writeln('}')
+        self.ctx.writeln('else')
+        self.ctx.writeln('{')
+        self.ctx.lvl_inc()
+        self.ctx.writeln('if(clone_.%s == nullptr)' % child.name)
+        self.ctx.writeln('{')
+        self.ctx.lvl_inc()
+        self.ctx.writeln('clone_.%s = ydk::make_entity<%s>(clone_.arena);' % (child.name, child.property_type.qualified_cpp_name()))
+        self.ctx.writeln('clone_.%s->parent = &clone_;' % child.name)
+        self.ctx.lvl_dec()
+        self.ctx.writeln('}')
+        self.ctx.writeln('%s->copy_to(*clone_.%s);' % (child.name, child.name))
+        self.ctx.lvl_dec()
+        self.ctx.writeln('}')
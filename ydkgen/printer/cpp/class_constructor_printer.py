@@ -30,7 +30,7 @@ def get_type_name(prop_type):
     elif prop_type.name == 'leafref':
         return 'str'
     elif prop_type.name == 'decimal64':
-        return 'str'
+        return 'decimal64'
     elif prop_type.name == 'union':
         return 'str'
     elif prop_type.name == 'binary':
@@ -58,23 +58,64 @@ def get_yang_name_for_leaf(clazz, prop):
     return name
 
 
+def _get_leaf_name(clazz, prop):
+    if prop.stmt.i_module.arg != clazz.stmt.i_module.arg:
+        return prop.stmt.i_module.arg + ':' + prop.stmt.arg
+    return prop.stmt.arg
+
+
+def _get_bits_leafs(leafs):
+    return [prop for prop in leafs if not prop.is_many and isinstance(prop.property_type, Bits)]
+
+
 class ClassConstructorPrinter(object):
     def __init__(self, ctx, module_namespace_lookup):
         self.ctx = ctx
         self.module_namespace_lookup = module_namespace_lookup
 
     def print_constructor(self, clazz, leafs, children):
+        if clazz.is_identity():
+            self._print_class_identity_handle(clazz)
+        else:
+            self._print_class_entity_metadata(clazz, leafs)
         self._print_class_constructor_header(clazz, leafs, children)
         self._print_class_constructor_body(clazz, leafs, children)
         self._print_class_constructor_trailer()
 
+    def _print_class_entity_metadata(self, clazz, leafs):
+        leaf_names = ', '.join('"%s"' % _get_leaf_name(clazz, prop) for prop in leafs)
+        bits_leafs = _get_bits_leafs(leafs)
+        bit_names = ''
+        if len(bits_leafs) > 0:
+            # sorted, so that a bit is found by its position in the table
+            bit_names = ', {%s}' % ', '.join('{%s}' % ', '.join('"%s"' % name for name in sorted(prop.property_type._dictionary))
+                                             for prop in bits_leafs)
+        self.ctx.writeln('const ydk::EntityMetadata& %s::get_entity_metadata()' % clazz.qualified_cpp_name())
+        self.ctx.writeln('{')
+        self.ctx.lvl_inc()
+        self.ctx.writeln('static const ydk::EntityMetadata metadata{"%s", "%s", {%s}%s};' % (clazz.stmt.arg, clazz.owner.stmt.arg, leaf_names, bit_names))
+        self.ctx.writeln('return metadata;')
+        self.ctx.lvl_dec()
+        self.ctx.writeln('}')
+        self.ctx.bline()
+
+    def _print_class_identity_handle(self, clazz):
+        module_name = get_module_name(clazz.stmt)
+        namespace = self.module_namespace_lookup[module_name]
+        self.ctx.writeln('const ydk::IdentityHandle& %s::get_identity_handle()' % clazz.qualified_cpp_name())
+        self.ctx.writeln('{')
+        self.ctx.lvl_inc()
+        self.ctx.writeln('static const ydk::IdentityHandle handle{"%s", "%s", "%s:%s"};' % (namespace, module_name, module_name, clazz.stmt.arg))
+        self.ctx.writeln('return handle;')
+        self.ctx.lvl_dec()
+        self.ctx.writeln('}')
+        self.ctx.bline()
+
     def _print_class_constructor_header(self, clazz, leafs, children):
         self.ctx.writeln(clazz.qualified_cpp_name() + '::' + clazz.name + '()')
         self.ctx.lvl_inc()
         if clazz.is_identity():
-            module_name = get_module_name(clazz.stmt)
-            namespace = self.module_namespace_lookup[module_name]
-            self.ctx.writeln(' : Identity("%s", "%s", "%s:%s")' % (namespace, module_name, module_name, clazz.stmt.arg))
+            self.ctx.writeln(' : Identity(get_identity_handle())')
         else:
             self._print_class_inits(clazz, leafs, children)
         self.ctx.lvl_dec()
@@ -84,10 +125,19 @@ class ClassConstructorPrinter(object):
     def _print_class_constructor_body(self, clazz, leafs, children):
         self._print_init_children(children)
         if not clazz.is_identity():
-            self.ctx.writeln('yang_name = "%s"; yang_parent_name = "%s"; is_top_level_class = %s; has_list_ancestor = %s; %s' \
-                             % (clazz.stmt.arg, clazz.owner.stmt.arg, ('true' if is_top_level_class(clazz) else 'false'),
+            self.ctx.writeln('yang_name = get_entity_metadata().yang_name; yang_parent_name = get_entity_metadata().yang_parent_name; is_top_level_class = %s; has_list_ancestor = %s; %s' \
+                             % (('true' if is_top_level_class(clazz) else 'false'),
                                 ('true' if has_list_ancestor(clazz) else 'false'),
                                 ('is_presence_container = true;' if clazz.stmt.search_one('presence') is not None else '')))
+            self._print_init_leafs(clazz, leafs)
+
+    def _print_init_leafs(self, clazz, leafs):
+        # setting a leaf drops the cached hashes of its entity, and setting a
+        # key leaf its cached paths as well
+        key_inits = ''.join(' %s.is_key = true;' % key.name for key in clazz.get_key_props())
+        self.ctx.writeln('cache_paths = true;%s' % key_inits)
+        if len(leafs) > 0:
+            self.ctx.writeln(' '.join('%s.owner = this;' % prop.name for prop in leafs))
 
     def _print_init_children(self, children):
         for child in children:
@@ -104,16 +154,15 @@ class ClassConstructorPrinter(object):
     def _print_class_inits(self, clazz, leafs, children):
         if len(leafs) > 0:
             self.ctx.writeln(':')
+            bits_leafs = _get_bits_leafs(leafs)
             index = 0
             while index < len(leafs):
                 prop = leafs[index]
-                leaf_name = ''
-                if prop.stmt.i_module.arg != clazz.stmt.i_module.arg:
-                    leaf_name = prop.stmt.i_module.arg + ':' + prop.stmt.arg
-                else:
-                    leaf_name = prop.stmt.arg
-                self.ctx.writeln('%s{YType::%s, "%s"}%s' % (prop.name,
-                            get_type_name(prop.property_type), leaf_name, (',' if index != len(leafs) - 1 else '')))
+                bit_names = ''
+                if prop in bits_leafs:
+                    bit_names = ', get_entity_metadata().bit_names[%d]' % bits_leafs.index(prop)
+                self.ctx.writeln('%s{YType::%s, get_entity_metadata().leaf_names[%d]%s}%s' % (prop.name,
+                            get_type_name(prop.property_type), index, bit_names, (',' if index != len(leafs) - 1 else '')))
                 index += 1
 
         init_stmts = []
@@ -129,9 +178,9 @@ class ClassConstructorPrinter(object):
                     init_stmts.append('%s(this, {%s})' % (child.name,  key_str))
             else:
                 if (child.stmt.search_one('presence') is None):
-                    init_stmts.append('%s(std::make_shared<%s>())' % (child.name, child.property_type.qualified_cpp_name()))
+                    init_stmts.append('%s(this, ydk::make_entity<%s>())' % (child.name, child.property_type.qualified_cpp_name()))
                 else:
-                    init_stmts.append('%s(nullptr) // presence node' % (child.name))
+                    init_stmts.append('%s(this) // presence node' % (child.name))
         if len(init_stmts) > 0:
             if len(leafs) == 0:
                 self.ctx.writeln(':')
@@ -23,6 +23,8 @@ source_printer.py
 
 from ydkgen.common import get_qualified_yang_name
 
+from .class_name_switch_printer import ClassNameSwitchPrinter
+
 
 class ClassGetChildPrinter(object):
     def __init__(self, ctx):
@@ -39,23 +41,18 @@ class ClassGetChildPrinter(object):
         self.ctx.lvl_inc()
 
     def _print_class_get_child_body(self, children):
-        for child in children:
-            self._print_class_get_child(child)
-            self.ctx.bline()
+        cases = [(get_qualified_yang_name(child), child) for child in children]
+        ClassNameSwitchPrinter(self.ctx).print_output('child_yang_name', cases, self._print_class_get_child,
+                                                      separate_cases=True)
 
     def _print_class_get_child(self, child):
-        self.ctx.writeln('if(child_yang_name == "%s")' % get_qualified_yang_name(child))
-        self.ctx.writeln('{')
-        self.ctx.lvl_inc()
         if child.is_many:
             self._print_class_get_child_many(child)
         else:
             self._print_class_get_child_unique(child)
-        self.ctx.lvl_dec()
-        self.ctx.writeln('}')
 
     def _print_class_get_child_many(self, child):
-        self.ctx.writeln('auto ent_ = std::make_shared<%s>();' % (child.property_type.qualified_cpp_name()))
+        self.ctx.writeln('auto ent_ = ydk::make_entity<%s>(arena);' % (child.property_type.qualified_cpp_name()))
         self.ctx.writeln('ent_->parent = this;')
         self.ctx.writeln('%s.append(ent_);' % child.name)
         self.ctx.writeln('return ent_;')
@@ -64,7 +61,7 @@ class ClassGetChildPrinter(object):
         self.ctx.writeln('if(%s == nullptr)' % child.name)
         self.ctx.writeln('{')
         self.ctx.lvl_inc()
-        self.ctx.writeln('%s = std::make_shared<%s>();' % (child.name, child.property_type.qualified_cpp_name()))
+        self.ctx.writeln('%s = ydk::make_entity<%s>(arena);' % (child.name, child.property_type.qualified_cpp_name()))
         self.ctx.lvl_dec()
         self.ctx.writeln('}')
         self.ctx.writeln('return %s;' % child.name)
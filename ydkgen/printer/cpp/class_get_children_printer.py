@@ -30,7 +30,8 @@ class ClassGetChildrenPrinter(object):
         self.ctx.writeln('{')
         self.ctx.lvl_inc()
         self.ctx.writeln('std::map<std::string, std::shared_ptr<ydk::Entity>> _children{};')
-        self.ctx.writeln('char count_=0;')
+        if any(child.is_many for child in children):
+            self.ctx.writeln('char count_=0;')
         for child in children:
             self._print_class_get_child(child)
         self.ctx.writeln('return _children;')
@@ -50,13 +51,14 @@ class ClassGetChildrenPrinter(object):
         self.ctx.writeln('for (auto ent_ : %s.entities())' % child.name)
         self.ctx.writeln('{')
         self.ctx.lvl_inc()
-        self.ctx.writeln('if(_children.find(ent_->get_segment_path()) == _children.end())')
+        self.ctx.writeln('auto segment_path_ = ent_->get_cached_segment_path();')
+        self.ctx.writeln('if(_children.find(segment_path_) == _children.end())')
         self.ctx.lvl_inc()
-        self.ctx.writeln('_children[ent_->get_segment_path()] = ent_;')
+        self.ctx.writeln('_children[segment_path_] = ent_;')
         self.ctx.lvl_dec()
         self.ctx.writeln('else')
         self.ctx.lvl_inc()
-        self.ctx.writeln('_children[ent_->get_segment_path()+count_++] = ent_;')
+        self.ctx.writeln('_children[segment_path_+count_++] = ent_;')
         self.ctx.lvl_dec()
         self.ctx.lvl_dec()
         self.ctx.writeln('}')
@@ -43,6 +43,7 @@ class ClassMembersPrinter(object):
 
     def _print_class_method_declarations(self, clazz):
         if clazz.is_identity():
+            self.ctx.writeln('static const ydk::IdentityHandle& get_identity_handle();')
             return
         self._print_common_method_declarations(clazz)
         self._print_top_level_entity_functions(clazz)
@@ -55,6 +56,7 @@ class ClassMembersPrinter(object):
         self.ctx.bline()
 
     def _print_common_method_declarations(self, clazz):
+        self.ctx.writeln('static const ydk::EntityMetadata& get_entity_metadata();')
         self.ctx.writeln('bool has_data() const override;')
         self.ctx.writeln('bool has_operation() const override;')
         self.ctx.writeln('std::vector<std::pair<std::string, ydk::LeafData> > get_name_leaf_data() const override;')
@@ -66,6 +68,8 @@ class ClassMembersPrinter(object):
         self.ctx.writeln('std::map<std::string, std::shared_ptr<ydk::Entity>> get_children() const override;')
         self.ctx.writeln('bool has_leaf_or_child_of_name(const std::string & name) const override;')
         self.ctx.writeln('const std::string get_namespace() const override;')
+        self.ctx.writeln('std::shared_ptr<ydk::Entity> deep_clone() const override;')
+        self.ctx.writeln('void copy_to(%s & clone_) const;' % clazz.name)
         if not is_top_level_class(clazz) and not has_list_ancestor(clazz):
             self.ctx.writeln('std::string get_absolute_path() const override;')
 
@@ -168,7 +172,7 @@ def _get_class_inits_unique(prop):
         presence_stmt = ''
         if prop.property_type.stmt.search_one('presence') is not None:
             presence_stmt = ' // presence node'
-        return 'std::shared_ptr<%s> %s;%s' % (prop.property_type.fully_qualified_cpp_name(), prop.name, presence_stmt)
+        return 'ydk::YChild<%s> %s;%s' % (prop.property_type.fully_qualified_cpp_name(), prop.name, presence_stmt)
 
 
 def _get_class_inits_many(prop):
@@ -0,0 +1,77 @@
+#  ----------------------------------------------------------------
+# Copyright 2016 Cisco Systems
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ------------------------------------------------------------------
+
+"""
+class_name_switch_printer.py
+
+ prints the dispatch on a leaf or child name
+
+"""
+from collections import OrderedDict
+
+
+# below this many names a chain of compares is as fast as hashing the name
+SWITCH_MIN_NAMES = 8
+
+
+def name_hash(name):
+    """ FNV-1a, the same as ydk::name_hash in entity_util.hpp """
+    hash = 14695981039346656037
+    for byte in bytearray(name.encode('utf-8')):
+        hash = ((hash ^ byte) * 1099511628211) & 0xffffffffffffffff
+    return hash
+
+
+class ClassNameSwitchPrinter(object):
+    def __init__(self, ctx):
+        self.ctx = ctx
+
+    def print_output(self, variable, cases, print_case_body, separate_cases=False):
+        """ Prints if(variable == name) { print_case_body(item) } for every
+            (name, item) in cases. Above SWITCH_MIN_NAMES the ifs are placed
+            in a switch on ydk::name_hash(variable), so that only the names
+            with the same hash are compared.
+        """
+        if len(cases) < SWITCH_MIN_NAMES:
+            for name, item in cases:
+                self._print_case(variable, name, item, print_case_body)
+                if separate_cases:
+                    self.ctx.bline()
+            return
+
+        buckets = OrderedDict()
+        for name, item in cases:
+            buckets.setdefault(name_hash(name), []).append((name, item))
+        self.ctx.writeln('switch(ydk::name_hash(%s))' % variable)
+        self.ctx.writeln('{')
+        self.ctx.lvl_inc()
+        for hash, bucket in buckets.items():
+            self.ctx.writeln('case 0x%016xULL:' % hash)
+            self.ctx.lvl_inc()
+            for name, item in bucket:
+                self._print_case(variable, name, item, print_case_body)
+            self.ctx.writeln('break;')
+            self.ctx.lvl_dec()
+        self.ctx.lvl_dec()
+        self.ctx.writeln('}')
+
+    def _print_case(self, variable, name, item, print_case_body):
+        self.ctx.writeln('if(%s == "%s")' % (variable, name))
+        self.ctx.writeln('{')
+        self.ctx.lvl_inc()
+        print_case_body(item)
+        self.ctx.lvl_dec()
+        self.ctx.writeln('}')
@@ -23,6 +23,8 @@ source_printer.py
 
 from ydkgen.common import get_qualified_yang_name
 
+from .class_name_switch_printer import ClassNameSwitchPrinter
+
 
 class ClassSetChildPrinter(object):
     def __init__(self, ctx):
@@ -39,20 +41,15 @@ class ClassSetChildPrinter(object):
         self.ctx.lvl_inc()
 
     def _print_class_set_child_body(self, children):
-        for child in children:
-            self._print_class_set_child(child)
-            self.ctx.bline()
+        cases = [(get_qualified_yang_name(child), child) for child in children]
+        ClassNameSwitchPrinter(self.ctx).print_output('child_yang_name', cases, self._print_class_set_child,
+                                                      separate_cases=True)
 
     def _print_class_set_child(self, child):
-        self.ctx.writeln('if(child_yang_name == "%s")' % get_qualified_yang_name(child))
-        self.ctx.writeln('{')
-        self.ctx.lvl_inc()
         if child.is_many:
             self._print_class_set_child_many(child)
         else:
             self._print_class_set_child_unique(child)
-        self.ctx.lvl_dec()
-        self.ctx.writeln('}')
 
     def _print_class_set_child_many(self, child):
         self.ctx.writeln('_ent->parent = this;')
@@ -23,6 +23,8 @@ source_printer.py
 from ydkgen.api_model import Bits, Class
 from ydkgen.common import get_qualified_yang_name
 
+from .class_name_switch_printer import ClassNameSwitchPrinter
+
 
 class ClassSetYLeafPrinter(object):
     def __init__(self, ctx):
@@ -43,13 +45,10 @@ class ClassSetYLeafPrinter(object):
         self.ctx.lvl_inc()
 
     def _print_class_set_value_body(self, leafs):
-        for leaf in leafs:
-            self._print_class_set_values(leaf)
+        cases = [(get_qualified_yang_name(leaf), leaf) for leaf in leafs]
+        ClassNameSwitchPrinter(self.ctx).print_output('value_path', cases, self._print_class_set_values)
 
     def _print_class_set_values(self, leaf):
-        self.ctx.writeln('if(value_path == "%s")' % (get_qualified_yang_name(leaf)))
-        self.ctx.writeln('{')
-        self.ctx.lvl_inc()
         if isinstance(leaf.property_type, Bits):
             if leaf.is_many:
                 self.ctx.writeln('Bits bits_value{};')
@@ -67,8 +66,6 @@ class ClassSetYLeafPrinter(object):
             self.ctx.writeln('%s = value;' % leaf.name)
             self.ctx.writeln('%s.value_namespace = name_space;' % leaf.name)
             self.ctx.writeln('%s.value_namespace_prefix = name_space_prefix;' % leaf.name)
-        self.ctx.lvl_dec()
-        self.ctx.writeln('}')
 
     def _print_class_set_filter_header(self, clazz):
         self.ctx.writeln('void %s::set_filter(const std::string & value_path, YFilter yfilter)' % clazz.qualified_cpp_name())
@@ -76,16 +73,13 @@ class ClassSetYLeafPrinter(object):
         self.ctx.lvl_inc()
 
     def _print_class_set_filter_body(self, leafs):
-        for leaf in leafs:
-            self._print_class_set_filters(leaf)
+        cases = [(leaf.stmt.arg, leaf) for leaf in leafs]
+        ClassNameSwitchPrinter(self.ctx).print_output('value_path', cases, self._print_class_set_filters)
 
     def _print_class_set_filters(self, leaf):
-        self.ctx.writeln('if(value_path == "%s")' % (leaf.stmt.arg))
-        self.ctx.writeln('{')
-        self.ctx.lvl_inc()
         self.ctx.writeln('%s.yfilter = yfilter;' % leaf.name)
-        self.ctx.lvl_dec()
-        self.ctx.writeln('}')
+        # the filter is written past the leaf, which does not tell the entity
+        self.ctx.writeln('invalidate_cached_hashes();')
 
     def _print_trailer(self, clazz):
         self.ctx.lvl_dec()
@@ -30,6 +30,8 @@ from .class_set_value_printer import ClassSetYLeafPrinter
 from .class_get_entity_path_printer import GetEntityPathPrinter, GetSegmentPathPrinter, GetAbsolutePathPrinter
 from .class_set_child_printer import ClassSetChildPrinter
 from .class_get_namespace_printer import GetNamespacePrinter
+from .class_name_switch_printer import ClassNameSwitchPrinter, SWITCH_MIN_NAMES
+from .class_clone_printer import ClassClonePrinter
 
 class ClassSourcePrinter(object):
     def __init__(self, ctx, bundle_name, module_namespace_lookup):
@@ -69,6 +71,7 @@ class ClassSourcePrinter(object):
         self._print_has_leaf_or_child_of_name(clazz, children, leafs)
         self._print_class_set_child_entity(clazz, children)
         self._print_class_get_namespace(clazz)
+        self._print_class_clone(clazz, leafs, children)
 
     def _print_top_level_entity_functions(self, clazz, leafs):
         if clazz.owner is not None and isinstance(clazz.owner, Package):
@@ -82,7 +85,7 @@ class ClassSourcePrinter(object):
         self.ctx.writeln('std::shared_ptr<ydk::Entity> %s::clone_ptr() const' % clazz.qualified_cpp_name())
         self.ctx.writeln('{')
         self.ctx.lvl_inc()
-        self.ctx.writeln('return std::make_shared<%s>();' % clazz.qualified_cpp_name())
+        self.ctx.writeln('return ydk::make_entity<%s>(arena);' % clazz.qualified_cpp_name())
         self.ctx.lvl_dec()
         self.ctx.writeln('}')
         self.ctx.bline()
@@ -127,7 +130,14 @@ class ClassSourcePrinter(object):
         self.ctx.writeln('bool %s::has_leaf_or_child_of_name(const std::string & _name) const' % clazz.qualified_cpp_name())
         self.ctx.writeln('{')
         self.ctx.lvl_inc()
-        if(len(children) > 0 or len(leafs) > 0):
+        names = []
+        for prop in children + leafs:
+            if prop.stmt.arg not in names:
+                names.append(prop.stmt.arg)
+        if len(names) >= SWITCH_MIN_NAMES:
+            ClassNameSwitchPrinter(self.ctx).print_output('_name', [(name, name) for name in names],
+                                                          lambda name: self.ctx.writeln('return true;'))
+        elif(len(children) > 0 or len(leafs) > 0):
             props = children+leafs
             if_condition = ' || '.join('_name == "%s"'% x.stmt.arg for x in props)
             self.ctx.writeln('if(%s)' % if_condition)
@@ -179,3 +189,6 @@ class ClassSourcePrinter(object):
 
     def _print_class_get_namespace(self, clazz):
         GetNamespacePrinter(self.ctx).print_output(clazz)
+
+    def _print_class_clone(self, clazz, leafs, children):
+        ClassClonePrinter(self.ctx).print_class_clone(clazz, leafs, children)